@@ -0,0 +1,102 @@
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/binder.h"
+#include "binder/bound_expression.h"
+#include "binder/expressions/bound_constant.h"
+#include "binder/expressions/bound_parameter.h"
+#include "binder/statement/prepare_statement.h"
+#include "common/exception.h"
+#include "fmt/format.h"
+#include "nodes/parsenodes.hpp"
+#include "type/type_id.h"
+
+namespace bustub {
+
+auto Binder::BindPrepare(duckdb_libpgquery::PGPrepareStmt *stmt) -> std::unique_ptr<PrepareStatement> {
+  if (parameter_types_.has_value()) {
+    throw bustub::Exception("PREPARE cannot be nested");
+  }
+  std::vector<TypeId> parameter_types;
+  if (stmt->argtypes != nullptr) {
+    for (auto node = stmt->argtypes->head; node != nullptr; node = node->next) {
+      auto *type_name = reinterpret_cast<duckdb_libpgquery::PGTypeName *>(node->data.ptr_value);
+      auto name = std::string(
+          reinterpret_cast<duckdb_libpgquery::PGValue *>(type_name->names->tail->data.ptr_value)->val.str);
+      if (name == "int4") {
+        parameter_types.push_back(TypeId::INTEGER);
+      } else if (name == "int8") {
+        parameter_types.push_back(TypeId::BIGINT);
+      } else if (name == "bool") {
+        parameter_types.push_back(TypeId::BOOLEAN);
+      } else if (name == "varchar") {
+        parameter_types.push_back(TypeId::VARCHAR);
+      } else {
+        throw NotImplementedException(fmt::format("unsupported parameter type: {}", name));
+      }
+    }
+  }
+
+  // The parameters met while binding the statement add to the declared ones
+  parameter_types_ = std::move(parameter_types);
+  std::unique_ptr<BoundStatement> statement;
+  try {
+    statement = BindStatement(stmt->query);
+  } catch (...) {
+    parameter_types_ = std::nullopt;
+    throw;
+  }
+  parameter_types = std::move(*parameter_types_);
+  parameter_types_ = std::nullopt;
+
+  switch (statement->type_) {
+    case StatementType::SELECT_STATEMENT:
+    case StatementType::INSERT_STATEMENT:
+    case StatementType::UPDATE_STATEMENT:
+    case StatementType::DELETE_STATEMENT:
+      break;
+    default:
+      throw NotImplementedException(fmt::format("cannot prepare a {} statement", statement->type_));
+  }
+  return std::make_unique<PrepareStatement>(stmt->name, std::move(parameter_types), std::move(statement));
+}
+
+auto Binder::BindExecute(duckdb_libpgquery::PGExecuteStmt *stmt) -> std::unique_ptr<ExecuteStatement> {
+  std::vector<Value> args;
+  if (stmt->params != nullptr) {
+    for (auto &expr : BindExpressionList(stmt->params)) {
+      if (expr->type_ != ExpressionType::CONSTANT) {
+        throw bustub::NotImplementedException("only constants are supported as arguments of EXECUTE");
+      }
+      args.push_back(dynamic_cast<const BoundConstant &>(*expr).val_);
+    }
+  }
+  return std::make_unique<ExecuteStatement>(stmt->name, std::move(args));
+}
+
+auto Binder::BindDeallocate(duckdb_libpgquery::PGDeallocateStmt *stmt) -> std::unique_ptr<DeallocateStatement> {
+  if (stmt->name == nullptr) {
+    return std::make_unique<DeallocateStatement>(std::nullopt);
+  }
+  return std::make_unique<DeallocateStatement>(stmt->name);
+}
+
+auto Binder::BindParamRef(duckdb_libpgquery::PGParamRef *node) -> std::unique_ptr<BoundExpression> {
+  if (!parameter_types_.has_value()) {
+    throw bustub::Exception("parameters are only allowed in PREPARE");
+  }
+  if (node->number <= 0) {
+    throw bustub::NotImplementedException("only numbered parameters like $1 are supported");
+  }
+  auto param_idx = static_cast<uint32_t>(node->number - 1);
+  // A parameter whose type is not declared compares with and is stored into INTEGER columns
+  if (parameter_types_->size() <= param_idx) {
+    parameter_types_->resize(param_idx + 1, TypeId::INTEGER);
+  }
+  return std::make_unique<BoundParameter>(param_idx, (*parameter_types_)[param_idx]);
+}
+
+}  // namespace bustub
@@ -0,0 +1,321 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_stats.cpp
+//
+// Identification: src/catalog/table_stats.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/table_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string_view>
+
+namespace bustub {
+
+/** The fraction of the non-NULL rows a range predicate is assumed to select when nothing is known of the column */
+static constexpr double DEFAULT_RANGE_SELECTIVITY = 1.0 / 3;
+
+/** @return a hash of a non-NULL value whose bits are all well mixed, equal values of any integer type hashing alike */
+static auto HashForStats(const Value &value) -> hash_t {
+  hash_t hash;
+  switch (value.GetTypeId()) {
+    case TypeId::TINYINT:
+    case TypeId::SMALLINT:
+    case TypeId::INTEGER:
+    case TypeId::BIGINT:
+      hash = static_cast<hash_t>(value.CastAs(TypeId::BIGINT).GetAs<int64_t>());
+      break;
+    case TypeId::VARCHAR:
+      hash = std::hash<std::string_view>{}(std::string_view(value.GetData(), value.GetLength()));
+      break;
+    default:
+      hash = HashUtil::HashValue(&value);
+      break;
+  }
+  return HashUtil::MixHash(hash);
+}
+
+/** @return a non-NULL value as a number, if it is of a numeric type */
+static auto ToNumber(const Value &value) -> std::optional<double> {
+  switch (value.GetTypeId()) {
+    case TypeId::TINYINT:
+      return value.GetAs<int8_t>();
+    case TypeId::SMALLINT:
+      return value.GetAs<int16_t>();
+    case TypeId::INTEGER:
+      return value.GetAs<int32_t>();
+    case TypeId::BIGINT:
+      return value.GetAs<int64_t>();
+    case TypeId::DECIMAL:
+      return value.GetAs<double>();
+    case TypeId::TIMESTAMP:
+      return value.GetAs<uint64_t>();
+    default:
+      return std::nullopt;
+  }
+}
+
+/** @return whether two non-NULL values can be compared without a cast that may fail */
+static auto CanCompare(const Value &left, const Value &right) -> bool {
+  if (left.GetTypeId() == right.GetTypeId()) {
+    return true;
+  }
+  return ToNumber(left).has_value() && ToNumber(right).has_value();
+}
+
+void HyperLogLog::Add(hash_t hash) {
+  const auto index = hash >> (64 - PRECISION);
+  const auto rest = hash << PRECISION;
+  // The position of the first set bit of the rest of the hash, the rest being all zeros once in 2^52 hashes
+  const auto rank = rest == 0 ? 64 - PRECISION + 1 : static_cast<uint32_t>(__builtin_clzll(rest)) + 1;
+  registers_[index] = std::max(registers_[index], static_cast<uint8_t>(rank));
+}
+
+auto HyperLogLog::Estimate() const -> double {
+  const auto m = static_cast<double>(registers_.size());
+  double sum = 0;
+  size_t zeros = 0;
+  for (auto reg : registers_) {
+    sum += std::ldexp(1.0, -reg);
+    zeros += reg == 0 ? 1 : 0;
+  }
+  const double alpha = 0.7213 / (1 + 1.079 / m);
+  const double estimate = alpha * m * m / sum;
+  // Few values leave many registers empty, which linear counting estimates better from
+  if (estimate <= 2.5 * m && zeros != 0) {
+    return m * std::log(m / static_cast<double>(zeros));
+  }
+  return estimate;
+}
+
+Histogram::Histogram(const std::vector<double> &sample, size_t num_buckets, double num_values) {
+  const auto n = sample.size();
+  num_buckets = std::min(num_buckets, n);
+  if (num_buckets == 0) {
+    return;
+  }
+  bounds_.reserve(num_buckets + 1);
+  counts_.reserve(num_buckets);
+  bounds_.push_back(sample.front());
+  size_t begin = 0;
+  for (size_t i = 1; i <= num_buckets; i++) {
+    const auto end = i * n / num_buckets;
+    bounds_.push_back(sample[end - 1]);
+    counts_.push_back(static_cast<double>(end - begin) * num_values / static_cast<double>(n));
+    begin = end;
+  }
+}
+
+auto Histogram::BucketOf(double value) const -> size_t {
+  // The first bucket whose upper bound is at least `value`, or the last one
+  auto it = std::lower_bound(bounds_.begin() + 1, bounds_.end() - 1, value);
+  return it - (bounds_.begin() + 1);
+}
+
+void Histogram::Insert(double value) {
+  if (IsEmpty()) {
+    return;
+  }
+  bounds_.front() = std::min(bounds_.front(), value);
+  bounds_.back() = std::max(bounds_.back(), value);
+  counts_[BucketOf(value)] += 1;
+}
+
+void Histogram::Delete(double value) {
+  if (IsEmpty()) {
+    return;
+  }
+  auto &count = counts_[BucketOf(value)];
+  count = std::max(0.0, count - 1);
+}
+
+auto Histogram::CountLessThan(double value) const -> double {
+  double count = 0;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    const auto low = bounds_[i];
+    const auto high = bounds_[i + 1];
+    if (value <= low) {
+      break;
+    }
+    if (value > high) {
+      count += counts_[i];
+    } else {
+      count += counts_[i] * (value - low) / (high - low);
+    }
+  }
+  return count;
+}
+
+auto Histogram::Count() const -> double {
+  double count = 0;
+  for (auto bucket_count : counts_) {
+    count += bucket_count;
+  }
+  return count;
+}
+
+TableStats::TableStats(const Schema &schema) : schema_(schema), columns_(schema.GetColumnCount()) {}
+
+void TableStats::Insert(const Tuple &tuple) {
+  std::scoped_lock lock(latch_);
+  row_count_++;
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    auto &column = columns_[i];
+    auto value = tuple.GetValue(&schema_, i);
+    if (value.IsNull()) {
+      column.null_count_++;
+      continue;
+    }
+    column.distinct_.Add(HashForStats(value));
+    if (!column.min_.has_value() || value.CompareLessThan(*column.min_) == CmpBool::CmpTrue) {
+      column.min_ = value;
+    }
+    if (!column.max_.has_value() || value.CompareGreaterThan(*column.max_) == CmpBool::CmpTrue) {
+      column.max_ = value;
+    }
+
+    auto number = ToNumber(value);
+    if (!number.has_value()) {
+      continue;
+    }
+    if (finished_) {
+      column.histogram_.Insert(*number);
+      continue;
+    }
+    // Reservoir sampling: the n-th value replaces a sampled one with probability SAMPLE_SIZE / n
+    column.num_sampled_++;
+    if (column.sample_.size() < SAMPLE_SIZE) {
+      column.sample_.push_back(*number);
+    } else if (auto j = random_() % column.num_sampled_; j < SAMPLE_SIZE) {
+      column.sample_[j] = *number;
+    }
+  }
+}
+
+void TableStats::Delete(const Tuple &tuple) {
+  std::scoped_lock lock(latch_);
+  row_count_ = row_count_ > 0 ? row_count_ - 1 : 0;
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    auto &column = columns_[i];
+    auto value = tuple.GetValue(&schema_, i);
+    if (value.IsNull()) {
+      column.null_count_ = column.null_count_ > 0 ? column.null_count_ - 1 : 0;
+      continue;
+    }
+    // The distinct count, and the smallest and largest values, are left as they are
+    if (auto number = ToNumber(value); number.has_value() && finished_) {
+      column.histogram_.Delete(*number);
+    }
+  }
+}
+
+void TableStats::Finish() {
+  std::scoped_lock lock(latch_);
+  for (auto &column : columns_) {
+    std::sort(column.sample_.begin(), column.sample_.end());
+    column.histogram_ = Histogram(column.sample_, NUM_BUCKETS, static_cast<double>(column.num_sampled_));
+    column.sample_ = std::vector<double>{};
+  }
+  finished_ = true;
+}
+
+auto TableStats::RowCount() const -> double {
+  std::scoped_lock lock(latch_);
+  return static_cast<double>(row_count_);
+}
+
+auto TableStats::DistinctCount(uint32_t col_idx) const -> double {
+  std::scoped_lock lock(latch_);
+  return DistinctCountLocked(col_idx);
+}
+
+auto TableStats::DistinctCountLocked(uint32_t col_idx) const -> double {
+  const auto &column = columns_[col_idx];
+  // Deleted values are still counted by the sketch, but there cannot be more distinct values than values
+  const auto non_null = static_cast<double>(row_count_ - std::min(row_count_, column.null_count_));
+  return std::max(1.0, std::min(column.distinct_.Estimate(), non_null));
+}
+
+auto TableStats::NullFraction(uint32_t col_idx) const -> double {
+  std::scoped_lock lock(latch_);
+  return NullFractionLocked(col_idx);
+}
+
+auto TableStats::NullFractionLocked(uint32_t col_idx) const -> double {
+  if (row_count_ == 0) {
+    return 0;
+  }
+  return std::min(1.0, static_cast<double>(columns_[col_idx].null_count_) / static_cast<double>(row_count_));
+}
+
+auto TableStats::MinValue(uint32_t col_idx) const -> std::optional<Value> {
+  std::scoped_lock lock(latch_);
+  return columns_[col_idx].min_;
+}
+
+auto TableStats::MaxValue(uint32_t col_idx) const -> std::optional<Value> {
+  std::scoped_lock lock(latch_);
+  return columns_[col_idx].max_;
+}
+
+auto TableStats::EqualSelectivity(uint32_t col_idx, const Value &value) const -> double {
+  std::scoped_lock lock(latch_);
+  return EqualSelectivityLocked(col_idx, value);
+}
+
+auto TableStats::EqualSelectivityLocked(uint32_t col_idx, const Value &value) const -> double {
+  const auto &column = columns_[col_idx];
+  if (row_count_ == 0 || value.IsNull() || !column.min_.has_value()) {
+    return 0;
+  }
+  if (CanCompare(value, *column.min_) && (value.CompareLessThan(*column.min_) == CmpBool::CmpTrue ||
+                                          value.CompareGreaterThan(*column.max_) == CmpBool::CmpTrue)) {
+    return 0;
+  }
+  // The non-NULL values are assumed to be spread evenly among the distinct ones
+  return (1 - NullFractionLocked(col_idx)) / DistinctCountLocked(col_idx);
+}
+
+auto TableStats::LessSelectivity(uint32_t col_idx, const Value &value, bool inclusive) const -> double {
+  std::scoped_lock lock(latch_);
+  const auto &column = columns_[col_idx];
+  if (row_count_ == 0 || value.IsNull() || !column.min_.has_value()) {
+    return 0;
+  }
+  const auto non_null = 1 - NullFractionLocked(col_idx);
+
+  double less;
+  auto number = ToNumber(value);
+  auto low = ToNumber(*column.min_);
+  auto high = ToNumber(*column.max_);
+  if (number.has_value() && !column.histogram_.IsEmpty() && column.histogram_.Count() > 0) {
+    less = non_null * column.histogram_.CountLessThan(*number) / column.histogram_.Count();
+  } else if (number.has_value() && low.has_value() && high.has_value()) {
+    // Without a histogram, the values are assumed to be spread evenly between the smallest and largest ones
+    if (*high > *low) {
+      less = non_null * std::clamp((*number - *low) / (*high - *low), 0.0, 1.0);
+    } else {
+      less = *number > *low ? non_null : 0;
+    }
+  } else if (CanCompare(value, *column.min_) && value.CompareLessThanEquals(*column.min_) == CmpBool::CmpTrue) {
+    less = 0;
+  } else if (CanCompare(value, *column.max_) && value.CompareGreaterThan(*column.max_) == CmpBool::CmpTrue) {
+    less = non_null;
+  } else {
+    less = non_null * DEFAULT_RANGE_SELECTIVITY;
+  }
+
+  if (inclusive) {
+    less += EqualSelectivityLocked(col_idx, value);
+  }
+  return std::clamp(less, 0.0, non_null);
+}
+
+}  // namespace bustub
@@ -1,5 +1,5 @@
-// DDL (Data Definition Language) statement handling in BusTub, including create table, create index, and set/show
-// variable.
+// DDL (Data Definition Language) statement handling in BusTub, including create table, create index, set/show
+// variable, prepare/execute/deallocate, and analyze.
 
 #include <optional>
 #include <shared_mutex>
@@ -9,14 +9,17 @@
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
 #include "binder/bound_statement.h"
+#include "binder/statement/analyze_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/index_statement.h"
+#include "binder/statement/prepare_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/set_show_statement.h"
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
 #include "catalog/table_generator.h"
+#include "catalog/table_stats.h"
 #include "common/bustub_instance.h"
 #include "common/enums/statement_type.h"
 #include "common/exception.h"
@@ -24,10 +27,13 @@
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
 #include "execution/execution_engine.h"
+#include "execution/executor_factory.h"
 #include "execution/executor_context.h"
 #include "execution/executors/mock_scan_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
 #include "fmt/core.h"
 #include "fmt/format.h"
 #include "optimizer/optimizer.h"
@@ -110,7 +116,7 @@ void BustubInstance::HandleExplainStatement(Transaction *txn, const ExplainState
   }
 
   // Print optimizer result.
-  bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
+  bustub::Optimizer optimizer(*catalog_, IsForceStarterRule(), GetExecutionParallelism());
   auto optimized_plan = optimizer.Optimize(planner.plan_);
 
   l.unlock();
@@ -120,6 +126,9 @@ void BustubInstance::HandleExplainStatement(Transaction *txn, const ExplainState
     output += "\n";
     output += optimized_plan->ToString(show_schema);
     output += "\n";
+    // Each operator that may spill holds up to the budget, which the workers below a Gather split between them
+    output += fmt::format("execution_memory_budget={}", GetExecutionMemoryBudget());
+    output += "\n";
   }
 
   WriteOneCell(output, writer);
@@ -134,6 +143,137 @@ void BustubInstance::HandleVariableShowStatement(Transaction *txn, const Variabl
 void BustubInstance::HandleVariableSetStatement(Transaction *txn, const VariableSetStatement &stmt,
                                                 ResultWriter &writer) {
   session_variables_[stmt.variable_] = stmt.value_;
+
+  // The optimizer reads session variables, so the plans made before may not be the ones it would make now
+  plan_cache_.Clear();
+  settings_version_++;
+}
+
+void BustubInstance::HandlePrepareStatement(Transaction *txn, const PrepareStatement &stmt, const std::string &sql,
+                                            ResultWriter &writer) {
+  auto prepared = std::make_shared<PreparedStatement>();
+  prepared->sql_ = sql;
+  prepared->parameter_types_ = stmt.parameter_types_;
+  prepared->parameters_ = std::make_shared<std::vector<Value>>();
+  prepared->plan_ = PlanStatement(*stmt.statement_, prepared->parameters_);
+  prepared->settings_version_ = settings_version_;
+
+  std::scoped_lock lock(prepared_statements_latch_);
+  if (prepared_statements_.count(stmt.name_) != 0) {
+    throw bustub::Exception(fmt::format("prepared statement {} already exists", stmt.name_));
+  }
+  prepared_statements_.emplace(stmt.name_, std::move(prepared));
+}
+
+auto BustubInstance::HandleExecuteStatement(Transaction *txn, const ExecuteStatement &stmt, ResultWriter &writer,
+                                            std::shared_ptr<CheckOptions> check_options) -> bool {
+  std::unique_lock prepared_lock(prepared_statements_latch_);
+  auto it = prepared_statements_.find(stmt.name_);
+  if (it == prepared_statements_.end()) {
+    throw bustub::Exception(fmt::format("prepared statement {} does not exist", stmt.name_));
+  }
+  auto prepared = it->second;
+  prepared_lock.unlock();
+
+  if (stmt.args_.size() != prepared->parameter_types_.size()) {
+    throw bustub::Exception(fmt::format("prepared statement {} takes {} arguments, got {}", stmt.name_,
+                                        prepared->parameter_types_.size(), stmt.args_.size()));
+  }
+
+  // The plan was checked against the catalog before the query was parsed. A table or an index created earlier in the
+  // same query only makes it into the plan the next time.
+  std::scoped_lock lock(prepared->latch_);
+  prepared->parameters_->clear();
+  for (size_t i = 0; i < stmt.args_.size(); i++) {
+    const auto &arg = stmt.args_[i];
+    auto type = prepared->parameter_types_[i];
+    if (arg.IsNull()) {
+      prepared->parameters_->push_back(ValueFactory::GetNullValueByType(type));
+    } else {
+      prepared->parameters_->push_back(arg.GetTypeId() == type ? arg : arg.CastAs(type));
+    }
+  }
+  return ExecutePlan(*prepared->plan_, txn, writer, std::move(check_options));
+}
+
+void BustubInstance::ReplanPreparedStatements() {
+  std::scoped_lock prepared_lock(prepared_statements_latch_);
+  for (auto &[name, prepared] : prepared_statements_) {
+    std::scoped_lock lock(prepared->latch_);
+    if (prepared->plan_->catalog_version_ == catalog_->GetVersion() &&
+        prepared->settings_version_ == settings_version_) {
+      continue;
+    }
+    // Planning the bound statement again is not possible, since the planner rewrites its aggregation calls
+    std::shared_lock<std::shared_mutex> l(catalog_lock_);
+    bustub::Binder binder(*catalog_);
+    binder.ParseAndSave(prepared->sql_);
+    auto statement = binder.BindStatement(binder.statement_nodes_[0]);
+    l.unlock();
+    const auto &prepare_stmt = dynamic_cast<const PrepareStatement &>(*statement);
+    prepared->plan_ = PlanStatement(*prepare_stmt.statement_, prepared->parameters_);
+    prepared->settings_version_ = settings_version_;
+  }
+}
+
+void BustubInstance::HandleDeallocateStatement(Transaction *txn, const DeallocateStatement &stmt,
+                                               ResultWriter &writer) {
+  std::scoped_lock lock(prepared_statements_latch_);
+  if (!stmt.name_.has_value()) {
+    prepared_statements_.clear();
+    return;
+  }
+  if (prepared_statements_.erase(*stmt.name_) == 0) {
+    throw bustub::Exception(fmt::format("prepared statement {} does not exist", *stmt.name_));
+  }
+}
+
+void BustubInstance::HandleAnalyzeStatement(Transaction *txn, const AnalyzeStatement &stmt, ResultWriter &writer) {
+  std::vector<std::string> table_names;
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  if (stmt.table_ != nullptr) {
+    table_names.push_back(stmt.table_->table_);
+  } else {
+    for (auto &table_name : catalog_->GetTableNames()) {
+      if (!StringUtil::StartsWith(table_name, "__")) {
+        table_names.push_back(std::move(table_name));
+      }
+    }
+  }
+
+  std::vector<std::pair<table_oid_t, std::shared_ptr<TableStats>>> all_stats;
+  for (const auto &table_name : table_names) {
+    const auto *table_info = catalog_->GetTable(table_name);
+    auto output = std::make_shared<Schema>(table_info->schema_);
+    // Mock tables have no table heap, their rows being generated on each scan
+    AbstractPlanNodeRef plan;
+    if (StringUtil::StartsWith(table_name, "__mock")) {
+      plan = std::make_shared<MockScanPlanNode>(output, table_name);
+    } else {
+      plan = std::make_shared<SeqScanPlanNode>(output, table_info->oid_, table_name);
+    }
+
+    auto stats = std::make_shared<TableStats>(table_info->schema_);
+    auto exec_ctx = MakeExecutorContext(txn, false);
+    auto executor = ExecutorFactory::CreateExecutor(exec_ctx.get(), plan);
+    executor->Init();
+    std::vector<Tuple> tuples;
+    std::vector<RID> rids;
+    while (executor->NextBatch(&tuples, &rids, BUSTUB_BATCH_SIZE)) {
+      for (const auto &tuple : tuples) {
+        stats->Insert(tuple);
+      }
+    }
+    stats->Finish();
+    all_stats.emplace_back(table_info->oid_, std::move(stats));
+  }
+  l.unlock();
+
+  // Replacing the statistics changes the catalog version, so that the plans made before are made again
+  std::unique_lock<std::shared_mutex> write_lock(catalog_lock_);
+  for (auto &[table_oid, stats] : all_stats) {
+    catalog_->SetTableStats(table_oid, std::move(stats));
+  }
 }
 
 }  // namespace bustub
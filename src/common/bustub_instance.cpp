@@ -6,9 +6,11 @@
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
 #include "binder/bound_statement.h"
+#include "binder/statement/analyze_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/index_statement.h"
+#include "binder/statement/prepare_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/set_show_statement.h"
 #include "buffer/buffer_pool_manager.h"
@@ -39,7 +41,10 @@
 namespace bustub {
 
 auto BustubInstance::MakeExecutorContext(Transaction *txn, bool is_modify) -> std::unique_ptr<ExecutorContext> {
-  return std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_, is_modify);
+  auto exec_ctx =
+      std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_, is_modify);
+  exec_ctx->SetMemoryBudget(GetExecutionMemoryBudget());
+  return exec_ctx;
 }
 
 BustubInstance::BustubInstance(const std::string &db_file_name) {
@@ -189,6 +194,13 @@ see the execution plan of your query.
   WriteOneCell(help, writer);
 }
 
+/** @return the text of one of the statements parsed from `sql` */
+static auto StatementText(const std::string &sql, duckdb_libpgquery::PGNode *stmt) -> std::string {
+  const auto *raw_stmt = reinterpret_cast<duckdb_libpgquery::PGRawStmt *>(stmt);
+  auto location = static_cast<size_t>(std::max(raw_stmt->stmt_location, 0));
+  return raw_stmt->stmt_len == 0 ? sql.substr(location) : sql.substr(location, raw_stmt->stmt_len);
+}
+
 auto BustubInstance::ExecuteSql(const std::string &sql, ResultWriter &writer,
                                 std::shared_ptr<CheckOptions> check_options) -> bool {
   auto txn = txn_manager_->Begin();
@@ -223,9 +235,20 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
     throw Exception(fmt::format("unsupported internal command: {}", sql));
   }
 
+  // A statement executed before skips straight to execution, unless the catalog changed since it was optimized
+  auto cache_key = PlanCache::NormalizeSql(sql);
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  auto cached_plan = plan_cache_.Get(cache_key, catalog_->GetVersion());
+  l.unlock();
+  if (cached_plan != nullptr) {
+    return ExecutePlan(*cached_plan, txn, writer, std::move(check_options));
+  }
+
+  ReplanPreparedStatements();
+
   bool is_successful = true;
 
-  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  l.lock();
   bustub::Binder binder(*catalog_);
   binder.ParseAndSave(sql);
   l.unlock();
@@ -233,8 +256,6 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
   for (auto *stmt : binder.statement_nodes_) {
     auto statement = binder.BindStatement(stmt);
 
-    bool is_delete = false;
-
     switch (statement->type_) {
       case StatementType::CREATE_STATEMENT: {
         const auto &create_stmt = dynamic_cast<const CreateStatement &>(*statement);
@@ -261,55 +282,93 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         HandleExplainStatement(txn, explain_stmt, writer);
         continue;
       }
-      case StatementType::DELETE_STATEMENT:
-      case StatementType::UPDATE_STATEMENT:
-        is_delete = true;
+      case StatementType::PREPARE_STATEMENT: {
+        const auto &prepare_stmt = dynamic_cast<const PrepareStatement &>(*statement);
+        HandlePrepareStatement(txn, prepare_stmt, StatementText(sql, stmt), writer);
+        continue;
+      }
+      case StatementType::EXECUTE_STATEMENT: {
+        const auto &execute_stmt = dynamic_cast<const ExecuteStatement &>(*statement);
+        is_successful &= HandleExecuteStatement(txn, execute_stmt, writer, check_options);
+        continue;
+      }
+      case StatementType::DEALLOCATE_STATEMENT: {
+        const auto &deallocate_stmt = dynamic_cast<const DeallocateStatement &>(*statement);
+        HandleDeallocateStatement(txn, deallocate_stmt, writer);
+        continue;
+      }
+      case StatementType::ANALYZE_STATEMENT: {
+        const auto &analyze_stmt = dynamic_cast<const AnalyzeStatement &>(*statement);
+        HandleAnalyzeStatement(txn, analyze_stmt, writer);
+        continue;
+      }
       default:
         break;
     }
 
-    std::shared_lock<std::shared_mutex> l(catalog_lock_);
+    auto plan = PlanStatement(*statement, std::make_shared<std::vector<Value>>());
+    // Only a query made of a single statement is found again by its text
+    if (binder.statement_nodes_.size() == 1) {
+      plan_cache_.Put(cache_key, plan);
+    }
+    is_successful &= ExecutePlan(*plan, txn, writer, std::move(check_options));
+  }
+
+  return is_successful;
+}
 
-    // Plan the query.
-    bustub::Planner planner(*catalog_);
-    planner.PlanQuery(*statement);
+auto BustubInstance::PlanStatement(const BoundStatement &statement, std::shared_ptr<std::vector<Value>> parameters)
+    -> std::shared_ptr<const CachedPlan> {
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  auto catalog_version = catalog_->GetVersion();
 
-    // Optimize the query.
-    bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
-    auto optimized_plan = optimizer.Optimize(planner.plan_);
+  // Plan the query.
+  bustub::Planner planner(*catalog_);
+  planner.parameters_ = std::move(parameters);
+  planner.PlanQuery(statement);
 
-    l.unlock();
+  // Optimize the query.
+  bustub::Optimizer optimizer(*catalog_, IsForceStarterRule(), GetExecutionParallelism());
+  auto optimized_plan = optimizer.Optimize(planner.plan_);
 
-    // Execute the query.
-    auto exec_ctx = MakeExecutorContext(txn, is_delete);
-    if (check_options != nullptr) {
-      exec_ctx->InitCheckOptions(std::move(check_options));
-    }
-    std::vector<Tuple> result_set{};
-    is_successful &= execution_engine_->Execute(optimized_plan, &result_set, txn, exec_ctx.get());
+  l.unlock();
 
-    // Return the result set as a vector of string.
-    auto schema = planner.plan_->OutputSchema();
+  bool is_delete =
+      statement.type_ == StatementType::DELETE_STATEMENT || statement.type_ == StatementType::UPDATE_STATEMENT;
+  return std::make_shared<const CachedPlan>(
+      CachedPlan{std::move(optimized_plan), planner.plan_->output_schema_, is_delete, catalog_version});
+}
 
-    // Generate header for the result set.
-    writer.BeginTable(false);
-    writer.BeginHeader();
-    for (const auto &column : schema.GetColumns()) {
-      writer.WriteHeaderCell(column.GetName());
-    }
-    writer.EndHeader();
+auto BustubInstance::ExecutePlan(const CachedPlan &plan, Transaction *txn, ResultWriter &writer,
+                                 std::shared_ptr<CheckOptions> check_options) -> bool {
+  auto exec_ctx = MakeExecutorContext(txn, plan.is_delete_);
+  if (check_options != nullptr) {
+    exec_ctx->InitCheckOptions(std::move(check_options));
+  }
+  const auto &schema = *plan.output_schema_;
 
-    // Transforming result set into strings.
-    for (const auto &tuple : result_set) {
-      writer.BeginRow();
-      for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
-        writer.WriteCell(tuple.GetValue(&schema, i).ToString());
-      }
-      writer.EndRow();
-    }
-    writer.EndTable();
+  // Generate header for the result set.
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  for (const auto &column : schema.GetColumns()) {
+    writer.WriteHeaderCell(column.GetName());
   }
+  writer.EndHeader();
 
+  // Write each batch of the result set as the plan produces it, so that it is never held in full.
+  auto is_successful = execution_engine_->ExecuteStreaming(
+      plan.plan_,
+      [&](std::vector<Tuple> *tuples) {
+        for (const auto &tuple : *tuples) {
+          writer.BeginRow();
+          for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+            writer.WriteCell(tuple.GetValue(&schema, i).ToString());
+          }
+          writer.EndRow();
+        }
+      },
+      txn, exec_ctx.get(), GetResultBatchSize());
+  writer.EndTable();
   return is_successful;
 }
 
@@ -0,0 +1,96 @@
+#include "common/plan_cache.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace bustub {
+
+auto PlanCache::NormalizeSql(const std::string &sql) -> std::string {
+  std::string normalized;
+  normalized.reserve(sql.size());
+  char quote = 0;
+  bool pending_space = false;
+  for (size_t i = 0; i < sql.size(); i++) {
+    const char c = sql[i];
+    if (quote == 0) {
+      // A comment separates tokens like whitespace does. A line comment only runs to the end of its line, and the
+      // statement may go on after it
+      if (c == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+        i = std::min(sql.find('\n', i), sql.size());
+        pending_space = !normalized.empty();
+        continue;
+      }
+      if (c == '/' && i + 1 < sql.size() && sql[i + 1] == '*') {
+        const auto close = sql.find("*/", i + 2);
+        i = close == std::string::npos ? sql.size() : close + 1;
+        pending_space = !normalized.empty();
+        continue;
+      }
+      if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+        pending_space = !normalized.empty();
+        continue;
+      }
+    }
+    if (pending_space) {
+      normalized.push_back(' ');
+      pending_space = false;
+    }
+    normalized.push_back(c);
+    if (quote == 0 && (c == '\'' || c == '"')) {
+      quote = c;
+    } else if (c == quote) {
+      // A doubled quote inside a literal closes and reopens it, which leaves the same state
+      quote = 0;
+    }
+  }
+  while (quote == 0 && !normalized.empty() && (normalized.back() == ';' || normalized.back() == ' ')) {
+    normalized.pop_back();
+  }
+  return normalized;
+}
+
+auto PlanCache::Get(const std::string &key, uint64_t catalog_version) -> std::shared_ptr<const CachedPlan> {
+  std::scoped_lock lock(latch_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  if (it->second->second->catalog_version_ != catalog_version) {
+    entries_.erase(it->second);
+    index_.erase(it);
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+void PlanCache::Put(const std::string &key, std::shared_ptr<const CachedPlan> plan) {
+  std::scoped_lock lock(latch_);
+  if (capacity_ == 0) {
+    return;
+  }
+  if (auto it = index_.find(key); it != index_.end()) {
+    it->second->second = std::move(plan);
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+  if (entries_.size() == capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+  entries_.emplace_front(key, std::move(plan));
+  index_.emplace(key, entries_.begin());
+}
+
+void PlanCache::Clear() {
+  std::scoped_lock lock(latch_);
+  entries_.clear();
+  index_.clear();
+}
+
+auto PlanCache::Size() -> size_t {
+  std::scoped_lock lock(latch_);
+  return entries_.size();
+}
+
+}  // namespace bustub
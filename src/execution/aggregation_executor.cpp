@@ -1,29 +1,125 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// aggregation_executor.cpp
-//
-// Identification: src/execution/aggregation_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-#include <memory>
-#include <vector>
-
-#include "execution/executors/aggregation_executor.h"
-
-namespace bustub {
-
-AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
-                                         std::unique_ptr<AbstractExecutor> &&child)
-    : AbstractExecutor(exec_ctx) {}
-
-void AggregationExecutor::Init() {}
-
-auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
-
-auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_executor.cpp
+//
+// Identification: src/execution/aggregation_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executors/aggregation_executor.h"
+
+namespace bustub {
+
+/** The number of high hash bits that pick the spill partition of a row, at each level of spilling */
+static constexpr size_t SPILL_PARTITION_BITS = 4;
+/** The number of times a partition may be spilled again */
+static constexpr size_t MAX_SPILL_LEVEL = 4;
+
+AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_(std::move(child)),
+      aht_(plan, child_->GetOutputSchema()) {}
+
+void AggregationExecutor::Init() {
+  child_->Init();
+  pending_.clear();
+  level_ = 0;
+  Aggregate(nullptr);
+  empty_result_emitted_ = false;
+}
+
+auto AggregationExecutor::SpillPartitionOf(hash_t hash) const -> size_t {
+  // The hash table picks slots with the low bits, so partitions take the high bits to keep their slots spread out
+  return (hash >> (64 - (level_ + 1) * SPILL_PARTITION_BITS)) & ((1UL << SPILL_PARTITION_BITS) - 1);
+}
+
+void AggregationExecutor::Aggregate(TmpTupleFile *input) {
+  aht_.Clear();
+  next_group_ = 0;
+  const auto memory_budget = exec_ctx_->GetMemoryBudget();
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  // Without a buffer pool, every group stays in memory whatever the budget
+  const bool can_spill = bpm != nullptr && level_ < MAX_SPILL_LEVEL;
+  std::vector<std::unique_ptr<TmpTupleFile>> spilled;
+
+  std::vector<Tuple> tuples{};
+  std::vector<RID> rids{};
+  std::vector<std::pair<size_t, hash_t>> missed;
+  while (input == nullptr ? child_->NextBatch(&tuples, &rids, BUSTUB_BATCH_SIZE)
+                          : input->ReadBatch(&tuples, BUSTUB_BATCH_SIZE)) {
+    if (spilled.empty()) {
+      aht_.InsertBatch(tuples);
+      if (can_spill && aht_.MemoryUsage() > memory_budget) {
+        spilled.resize(1UL << SPILL_PARTITION_BITS);
+      }
+      continue;
+    }
+    // The groups in the table keep all their rows, every other group goes whole to one partition
+    aht_.InsertBatch(tuples, &missed);
+    for (const auto &[row, hash] : missed) {
+      auto &partition = spilled[SpillPartitionOf(hash)];
+      if (partition == nullptr) {
+        partition = std::make_unique<TmpTupleFile>(bpm);
+      }
+      partition->Append(tuples[row]);
+    }
+  }
+
+  for (auto &partition : spilled) {
+    if (partition != nullptr) {
+      pending_.push_back({std::move(partition), level_ + 1});
+    }
+  }
+}
+
+auto AggregationExecutor::NextGroup(Tuple *tuple) -> bool {
+  // An aggregation without GROUP BY still produces one row over an empty input. It never spills.
+  if (aht_.Size() == 0 && plan_->GetGroupBys().empty()) {
+    if (empty_result_emitted_) {
+      return false;
+    }
+    empty_result_emitted_ = true;
+    *tuple = aht_.EmptyTuple(GetOutputSchema());
+    return true;
+  }
+
+  // Aggregate the most recently spilled partitions first, so that their sub-partitions are freed before moving on
+  while (next_group_ == aht_.Size()) {
+    if (pending_.empty()) {
+      return false;
+    }
+    auto partition = std::move(pending_.back());
+    pending_.pop_back();
+    level_ = partition.level_;
+    partition.tuples_->Rewind();
+    Aggregate(partition.tuples_.get());
+  }
+  *tuple = aht_.GroupTuple(next_group_++, GetOutputSchema());
+  return true;
+}
+
+auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool { return NextGroup(tuple); }
+
+auto AggregationExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  rids->clear();
+  Tuple tuple{};
+  while (tuples->size() < batch_size && NextGroup(&tuple)) {
+    tuples->push_back(std::move(tuple));
+    rids->emplace_back();
+  }
+  return !tuples->empty();
+}
+
+auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
+
+}  // namespace bustub
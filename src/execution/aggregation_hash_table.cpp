@@ -0,0 +1,300 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_hash_table.cpp
+//
+// Identification: src/execution/aggregation_hash_table.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/aggregation_hash_table.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/exception.h"
+#include "execution/sort_key.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** The number of slots of an empty table */
+static constexpr size_t INITIAL_SLOTS = 64;
+
+AggregationHashTable::AggregationHashTable(const AggregationPlanNode *plan, const Schema &child_schema)
+    : plan_(plan), child_schema_(child_schema) {
+  for (const auto &expr : plan_->GetGroupBys()) {
+    compiled_group_bys_.emplace_back(CompiledExpression::Compile(expr, child_schema_));
+  }
+  for (size_t i = 0; i < plan_->GetAggregates().size(); i++) {
+    const auto &expr = plan_->GetAggregates()[i];
+    compiled_aggregates_.emplace_back(CompiledExpression::Compile(expr, child_schema_));
+    auto kind = AccumulatorKind::Value;
+    switch (plan_->GetAggregateTypes()[i]) {
+      case AggregationType::CountStarAggregate:
+      case AggregationType::CountAggregate:
+        kind = AccumulatorKind::Count;
+        break;
+      case AggregationType::SumAggregate:
+      case AggregationType::MinAggregate:
+      case AggregationType::MaxAggregate:
+        if (expr->GetReturnType() == TypeId::INTEGER || expr->GetReturnType() == TypeId::BIGINT) {
+          kind = AccumulatorKind::Integer;
+        } else if (expr->GetReturnType() == TypeId::DECIMAL) {
+          kind = AccumulatorKind::Decimal;
+        }
+        break;
+    }
+    has_value_accumulators_ |= kind == AccumulatorKind::Value;
+    kinds_.push_back(kind);
+  }
+  group_by_values_.resize(plan_->GetGroupBys().size());
+  aggregate_values_.resize(plan_->GetAggregates().size());
+  Clear();
+}
+
+void AggregationHashTable::Clear() {
+  slots_.assign(INITIAL_SLOTS, Slot{0, EMPTY_SLOT});
+  num_groups_ = 0;
+  keys_.clear();
+  key_offsets_.assign(1, 0);
+  group_values_.clear();
+  accumulators_.clear();
+  value_accumulators_.clear();
+}
+
+void AggregationHashTable::Evaluate(const AbstractExpressionRef &expr, CompiledExpression *compiled,
+                                    const std::vector<Tuple> &tuples, std::vector<Value> *values) {
+  if (compiled != nullptr) {
+    compiled->EvaluateBatch(tuples, values);
+    return;
+  }
+  values->clear();
+  for (const auto &tuple : tuples) {
+    values->push_back(expr->Evaluate(&tuple, child_schema_));
+  }
+}
+
+void AggregationHashTable::InsertBatch(const std::vector<Tuple> &tuples,
+                                       std::vector<std::pair<size_t, hash_t>> *missed) {
+  if (missed != nullptr) {
+    missed->clear();
+  }
+  const auto &group_bys = plan_->GetGroupBys();
+  const auto &aggregates = plan_->GetAggregates();
+  for (size_t i = 0; i < group_bys.size(); i++) {
+    Evaluate(group_bys[i], compiled_group_bys_[i].get(), tuples, &group_by_values_[i]);
+  }
+  for (size_t i = 0; i < aggregates.size(); i++) {
+    if (plan_->GetAggregateTypes()[i] != AggregationType::CountStarAggregate) {
+      Evaluate(aggregates[i], compiled_aggregates_[i].get(), tuples, &aggregate_values_[i]);
+    }
+  }
+
+  for (size_t row = 0; row < tuples.size(); row++) {
+    // NULLs get their own normalized encoding, so all the NULLs of a column fall in the same group
+    key_.clear();
+    for (const auto &values : group_by_values_) {
+      SortKeyEncoder::AppendValue(values[row], false, &key_);
+    }
+    auto hash = HashUtil::MixHash(HashUtil::HashBytes(key_.data(), key_.size()));
+    auto group = FindGroup(hash);
+    if (group == EMPTY_SLOT) {
+      if (missed != nullptr) {
+        missed->emplace_back(row, hash);
+        continue;
+      }
+      group = InsertGroup(hash, row);
+    }
+
+    auto *accs = &accumulators_[group * aggregates.size()];
+    auto *value_accs = has_value_accumulators_ ? &value_accumulators_[group * aggregates.size()] : nullptr;
+    for (size_t i = 0; i < aggregates.size(); i++) {
+      if (plan_->GetAggregateTypes()[i] == AggregationType::CountStarAggregate) {
+        accs[i].integer_++;
+        continue;
+      }
+      Update(i, aggregate_values_[i][row], &accs[i], value_accs == nullptr ? nullptr : &value_accs[i]);
+    }
+  }
+}
+
+auto AggregationHashTable::FindGroup(hash_t hash) const -> uint32_t {
+  const auto mask = slots_.size() - 1;
+  for (auto pos = hash & mask;; pos = (pos + 1) & mask) {
+    const auto &slot = slots_[pos];
+    if (slot.group_ == EMPTY_SLOT) {
+      return EMPTY_SLOT;
+    }
+    if (slot.hash_ == hash) {
+      auto offset = key_offsets_[slot.group_];
+      auto length = key_offsets_[slot.group_ + 1] - offset;
+      if (length == key_.size() && memcmp(keys_.data() + offset, key_.data(), length) == 0) {
+        return slot.group_;
+      }
+    }
+  }
+}
+
+auto AggregationHashTable::InsertGroup(hash_t hash, size_t row) -> uint32_t {
+  auto group = static_cast<uint32_t>(num_groups_++);
+  keys_.append(key_);
+  key_offsets_.push_back(keys_.size());
+  for (const auto &values : group_by_values_) {
+    group_values_.push_back(values[row]);
+  }
+  const auto &agg_types = plan_->GetAggregateTypes();
+  for (auto agg_type : agg_types) {
+    Accumulator acc;
+    // COUNT(*) starts at zero, the others start at NULL
+    acc.is_null_ = agg_type != AggregationType::CountStarAggregate;
+    accumulators_.push_back(acc);
+  }
+  if (has_value_accumulators_) {
+    value_accumulators_.resize(value_accumulators_.size() + agg_types.size(),
+                               ValueFactory::GetNullValueByType(TypeId::INTEGER));
+  }
+
+  if (num_groups_ * 2 > slots_.size()) {
+    Grow();
+  }
+  const auto mask = slots_.size() - 1;
+  for (auto pos = hash & mask;; pos = (pos + 1) & mask) {
+    if (slots_[pos].group_ == EMPTY_SLOT) {
+      slots_[pos] = Slot{hash, group};
+      break;
+    }
+  }
+  return group;
+}
+
+void AggregationHashTable::Grow() {
+  std::vector<Slot> old_slots(slots_.size() * 2, Slot{0, EMPTY_SLOT});
+  old_slots.swap(slots_);
+  const auto mask = slots_.size() - 1;
+  for (const auto &old_slot : old_slots) {
+    if (old_slot.group_ == EMPTY_SLOT) {
+      continue;
+    }
+    for (auto pos = old_slot.hash_ & mask;; pos = (pos + 1) & mask) {
+      if (slots_[pos].group_ == EMPTY_SLOT) {
+        slots_[pos] = old_slot;
+        break;
+      }
+    }
+  }
+}
+
+void AggregationHashTable::Update(size_t agg, const Value &val, Accumulator *acc, Value *value_acc) {
+  if (val.IsNull()) {
+    return;
+  }
+  const auto agg_type = plan_->GetAggregateTypes()[agg];
+  switch (kinds_[agg]) {
+    case AccumulatorKind::Count:
+      acc->integer_++;
+      acc->is_null_ = false;
+      break;
+    case AccumulatorKind::Integer: {
+      auto input = val.GetTypeId() == TypeId::BIGINT ? val.GetAs<int64_t>() : val.GetAs<int32_t>();
+      if (acc->is_null_) {
+        acc->integer_ = input;
+      } else if (agg_type == AggregationType::SumAggregate) {
+        if (__builtin_add_overflow(acc->integer_, input, &acc->integer_)) {
+          throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+        }
+      } else if (agg_type == AggregationType::MinAggregate) {
+        acc->integer_ = std::min(acc->integer_, input);
+      } else {
+        acc->integer_ = std::max(acc->integer_, input);
+      }
+      acc->is_null_ = false;
+      break;
+    }
+    case AccumulatorKind::Decimal: {
+      auto input = val.GetAs<double>();
+      if (acc->is_null_) {
+        acc->decimal_ = input;
+      } else if (agg_type == AggregationType::SumAggregate) {
+        acc->decimal_ += input;
+      } else if (agg_type == AggregationType::MinAggregate) {
+        acc->decimal_ = std::min(acc->decimal_, input);
+      } else {
+        acc->decimal_ = std::max(acc->decimal_, input);
+      }
+      acc->is_null_ = false;
+      break;
+    }
+    case AccumulatorKind::Value:
+      if (value_acc->IsNull()) {
+        *value_acc = val;
+      } else if (agg_type == AggregationType::SumAggregate) {
+        *value_acc = value_acc->Add(val);
+      } else if (agg_type == AggregationType::MinAggregate) {
+        if (val.CompareLessThan(*value_acc) == CmpBool::CmpTrue) {
+          *value_acc = val;
+        }
+      } else if (val.CompareGreaterThan(*value_acc) == CmpBool::CmpTrue) {
+        *value_acc = val;
+      }
+      break;
+  }
+}
+
+auto AggregationHashTable::AccumulatorValue(size_t agg, const Accumulator &acc, const Value *value_acc) const
+    -> Value {
+  if (kinds_[agg] == AccumulatorKind::Value) {
+    return *value_acc;
+  }
+  // Like the initial value of every aggregate but COUNT(*), an empty accumulator is an INTEGER NULL
+  if (acc.is_null_) {
+    return ValueFactory::GetNullValueByType(TypeId::INTEGER);
+  }
+  switch (kinds_[agg]) {
+    case AccumulatorKind::Count:
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(acc.integer_));
+    case AccumulatorKind::Integer:
+      if (plan_->GetAggregates()[agg]->GetReturnType() == TypeId::BIGINT) {
+        return ValueFactory::GetBigIntValue(acc.integer_);
+      }
+      // BUSTUB_INT32_MIN stands for NULL, so it is out of range too
+      if (acc.integer_ <= BUSTUB_INT32_MIN || acc.integer_ > BUSTUB_INT32_MAX) {
+        throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+      }
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(acc.integer_));
+    case AccumulatorKind::Decimal:
+      return ValueFactory::GetDecimalValue(acc.decimal_);
+    default:
+      UNREACHABLE("Value accumulators are handled above");
+  }
+}
+
+auto AggregationHashTable::GroupTuple(size_t group, const Schema &output_schema) const -> Tuple {
+  const auto num_group_bys = plan_->GetGroupBys().size();
+  const auto num_aggregates = plan_->GetAggregates().size();
+  std::vector<Value> values;
+  values.reserve(num_group_bys + num_aggregates);
+  values.insert(values.end(), group_values_.begin() + group * num_group_bys,
+                group_values_.begin() + (group + 1) * num_group_bys);
+  for (size_t i = 0; i < num_aggregates; i++) {
+    auto idx = group * num_aggregates + i;
+    values.push_back(
+        AccumulatorValue(i, accumulators_[idx], has_value_accumulators_ ? &value_accumulators_[idx] : nullptr));
+  }
+  return {values, &output_schema};
+}
+
+auto AggregationHashTable::EmptyTuple(const Schema &output_schema) const -> Tuple {
+  std::vector<Value> values;
+  for (auto agg_type : plan_->GetAggregateTypes()) {
+    values.push_back(agg_type == AggregationType::CountStarAggregate
+                         ? ValueFactory::GetIntegerValue(0)
+                         : ValueFactory::GetNullValueByType(TypeId::INTEGER));
+  }
+  return {values, &output_schema};
+}
+
+}  // namespace bustub
@@ -0,0 +1,183 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// block_nested_loop_join_executor.cpp
+//
+// Identification: src/execution/block_nested_loop_join_executor.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/block_nested_loop_join_executor.h"
+
+#include "common/exception.h"
+#include "execution/join_util.h"
+
+namespace bustub {
+
+/** @return an estimate of the memory a materialized tuple holds */
+static auto TupleMemory(const Tuple &tuple) -> size_t { return sizeof(Tuple) + tuple.GetLength(); }
+
+BlockNestedLoopJoinExecutor::BlockNestedLoopJoinExecutor(ExecutorContext *exec_ctx,
+                                                         const BlockNestedLoopJoinPlanNode *plan,
+                                                         std::unique_ptr<AbstractExecutor> &&left_executor,
+                                                         std::unique_ptr<AbstractExecutor> &&right_executor)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_executor)),
+      right_executor_(std::move(right_executor)) {
+  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
+    throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
+  }
+}
+
+void BlockNestedLoopJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  right_tuples_.clear();
+  right_memory_ = 0;
+  right_file_.reset();
+  right_batch_.clear();
+  right_chunk_ = nullptr;
+  right_cursor_ = 0;
+  block_.clear();
+  matched_.clear();
+  block_done_ = true;
+  left_done_ = false;
+  left_batch_.clear();
+  left_rids_.clear();
+  left_cursor_ = 0;
+  pending_.clear();
+  pending_cursor_ = 0;
+  next_.Reset();
+
+  const auto memory_budget = exec_ctx_->GetMemoryBudget();
+  // Without a buffer pool, the right side is kept in memory whatever its size
+  const bool can_spill = exec_ctx_->GetBufferPoolManager() != nullptr;
+  std::vector<Tuple> tuples;
+  std::vector<RID> rids;
+  while (right_executor_->NextBatch(&tuples, &rids, BUSTUB_BATCH_SIZE)) {
+    for (auto &tuple : tuples) {
+      if (right_file_ != nullptr) {
+        right_file_->Append(tuple);
+        continue;
+      }
+      right_memory_ += TupleMemory(tuple);
+      right_tuples_.push_back(std::move(tuple));
+    }
+    if (right_file_ == nullptr && can_spill && right_memory_ > memory_budget) {
+      // Once the right side does not fit, all of it goes to temporary pages, and the whole budget to the left blocks
+      right_file_ = std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager());
+      for (const auto &tuple : right_tuples_) {
+        right_file_->Append(tuple);
+      }
+      right_tuples_ = std::vector<Tuple>{};
+      right_memory_ = 0;
+    }
+  }
+}
+
+auto BlockNestedLoopJoinExecutor::NextLeftBlock() -> bool {
+  block_.clear();
+  const auto memory_budget = exec_ctx_->GetMemoryBudget();
+  const auto block_budget = memory_budget > right_memory_ ? memory_budget - right_memory_ : 0;
+  size_t memory = 0;
+  // A block holds at least one tuple, however small the budget
+  while (block_.empty() || memory < block_budget) {
+    if (left_cursor_ == left_batch_.size()) {
+      left_cursor_ = 0;
+      if (left_done_ || !left_executor_->NextBatch(&left_batch_, &left_rids_, BUSTUB_BATCH_SIZE)) {
+        left_batch_.clear();
+        left_done_ = true;
+        break;
+      }
+    }
+    memory += TupleMemory(left_batch_[left_cursor_]);
+    block_.push_back(std::move(left_batch_[left_cursor_++]));
+  }
+  matched_.assign(block_.size(), false);
+
+  // Check the whole right side against the block, from its first tuple
+  if (right_file_ != nullptr) {
+    right_file_->Rewind();
+    right_batch_.clear();
+    right_chunk_ = &right_batch_;
+  } else {
+    right_chunk_ = &right_tuples_;
+  }
+  right_cursor_ = 0;
+  return !block_.empty();
+}
+
+auto BlockNestedLoopJoinExecutor::NextRightChunk() -> bool {
+  // Right tuples kept in memory are all checked at once
+  if (right_file_ == nullptr || !right_file_->ReadBatch(&right_batch_, BUSTUB_BATCH_SIZE)) {
+    return false;
+  }
+  right_cursor_ = 0;
+  return true;
+}
+
+auto BlockNestedLoopJoinExecutor::JoinNext() -> bool {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  while (true) {
+    if (block_done_) {
+      if (!NextLeftBlock()) {
+        return false;
+      }
+      block_done_ = false;
+    }
+
+    if (right_cursor_ == right_chunk_->size() && !NextRightChunk()) {
+      block_done_ = true;
+      if (plan_->GetJoinType() == JoinType::LEFT) {
+        for (size_t i = 0; i < block_.size(); i++) {
+          if (!matched_[i]) {
+            pending_.push_back(MakeJoinOutputTuple(block_[i], left_schema, nullptr, right_schema, GetOutputSchema()));
+          }
+        }
+      }
+      if (!pending_.empty()) {
+        return true;
+      }
+      continue;
+    }
+
+    const auto &right = (*right_chunk_)[right_cursor_++];
+    for (size_t i = 0; i < block_.size(); i++) {
+      auto value = plan_->Predicate()->EvaluateJoin(&block_[i], left_schema, &right, right_schema);
+      if (!value.IsNull() && value.GetAs<bool>()) {
+        pending_.push_back(MakeJoinOutputTuple(block_[i], left_schema, &right, right_schema, GetOutputSchema()));
+        matched_[i] = true;
+      }
+    }
+    if (!pending_.empty()) {
+      return true;
+    }
+  }
+}
+
+auto BlockNestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return next_.Next(this, tuple, rid); }
+
+auto BlockNestedLoopJoinExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size)
+    -> bool {
+  tuples->clear();
+  rids->clear();
+  while (tuples->size() < batch_size) {
+    if (pending_cursor_ == pending_.size()) {
+      pending_.clear();
+      pending_cursor_ = 0;
+      if (!JoinNext()) {
+        break;
+      }
+    }
+    tuples->push_back(std::move(pending_[pending_cursor_++]));
+    rids->emplace_back();
+  }
+  return !tuples->empty();
+}
+
+}  // namespace bustub
@@ -0,0 +1,397 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.cpp
+//
+// Identification: src/execution/compiled_expression.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/expressions/compiled_expression.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/exception.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "type/limits.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+auto IsIntegral(TypeId type) -> bool {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+auto IsCompilable(TypeId type) -> bool { return IsIntegral(type) || type == TypeId::BOOLEAN; }
+
+template <typename T>
+inline void LoadColumn(const char *const *data, uint32_t offset, T null_value, int64_t *values, uint8_t *nulls,
+                       size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    T val;
+    memcpy(&val, data[i] + offset, sizeof(T));
+    values[i] = val;
+    nulls[i] = static_cast<uint8_t>(val == null_value);
+  }
+}
+
+}  // namespace
+
+auto CompiledExpression::Compile(const AbstractExpressionRef &expr, const Schema &schema)
+    -> std::unique_ptr<CompiledExpression> {
+  std::unique_ptr<CompiledExpression> compiled(new CompiledExpression());
+  auto result = compiled->Emit(*expr, schema, nullptr);
+  if (result < 0) {
+    return nullptr;
+  }
+  compiled->result_ = result;
+  compiled->ret_type_ = expr->GetReturnType();
+  return compiled;
+}
+
+auto CompiledExpression::CompileJoin(const AbstractExpressionRef &expr, const Schema &left_schema,
+                                     const Schema &right_schema) -> std::unique_ptr<CompiledExpression> {
+  std::unique_ptr<CompiledExpression> compiled(new CompiledExpression());
+  auto result = compiled->Emit(*expr, left_schema, &right_schema);
+  if (result < 0) {
+    return nullptr;
+  }
+  compiled->result_ = result;
+  compiled->ret_type_ = expr->GetReturnType();
+  return compiled;
+}
+
+auto CompiledExpression::Emit(const AbstractExpression &expr, const Schema &left_schema, const Schema *right_schema)
+    -> int64_t {
+  if (!IsCompilable(expr.GetReturnType())) {
+    return -1;
+  }
+
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(&expr);
+      column_value_expr != nullptr) {
+    uint32_t tuple_idx = right_schema == nullptr ? 0 : column_value_expr->GetTupleIdx();
+    const auto &schema = tuple_idx == 0 ? left_schema : *right_schema;
+    const auto &column = schema.GetColumn(column_value_expr->GetColIdx());
+    Instruction instr{};
+    switch (column.GetType()) {
+      case TypeId::TINYINT:
+        instr.op_ = OpCode::LoadTinyInt;
+        break;
+      case TypeId::SMALLINT:
+        instr.op_ = OpCode::LoadSmallInt;
+        break;
+      case TypeId::INTEGER:
+        instr.op_ = OpCode::LoadInteger;
+        break;
+      case TypeId::BIGINT:
+        instr.op_ = OpCode::LoadBigInt;
+        break;
+      case TypeId::BOOLEAN:
+        instr.op_ = OpCode::LoadBoolean;
+        break;
+      default:
+        return -1;
+    }
+    instr.dst_ = num_registers_++;
+    instr.tuple_idx_ = tuple_idx;
+    instr.offset_ = column.GetOffset();
+    instructions_.push_back(instr);
+    return instr.dst_;
+  }
+
+  if (const auto *const_expr = dynamic_cast<const ConstantValueExpression *>(&expr); const_expr != nullptr) {
+    Instruction instr{};
+    instr.op_ = OpCode::LoadConstant;
+    instr.dst_ = num_registers_++;
+    instr.constant_is_null_ = const_expr->val_.IsNull();
+    if (!instr.constant_is_null_) {
+      instr.constant_ = const_expr->val_.GetTypeId() == TypeId::BOOLEAN
+                            ? static_cast<int64_t>(const_expr->val_.GetAs<bool>())
+                            : const_expr->val_.CastAs(TypeId::BIGINT).GetAs<int64_t>();
+    }
+    instructions_.push_back(instr);
+    return instr.dst_;
+  }
+
+  if (expr.GetChildren().size() != 2) {
+    return -1;
+  }
+  const auto &lhs_expr = *expr.GetChildAt(0);
+  const auto &rhs_expr = *expr.GetChildAt(1);
+
+  Instruction instr{};
+  if (const auto *arith_expr = dynamic_cast<const ArithmeticExpression *>(&expr); arith_expr != nullptr) {
+    switch (arith_expr->compute_type_) {
+      case ArithmeticType::Plus:
+        instr.op_ = OpCode::Plus;
+        break;
+      case ArithmeticType::Minus:
+        instr.op_ = OpCode::Minus;
+        break;
+      default:
+        return -1;
+    }
+  } else if (const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr); cmp_expr != nullptr) {
+    auto lhs_type = lhs_expr.GetReturnType();
+    auto rhs_type = rhs_expr.GetReturnType();
+    if (!(IsIntegral(lhs_type) && IsIntegral(rhs_type)) && !(lhs_type == TypeId::BOOLEAN && rhs_type == lhs_type)) {
+      return -1;
+    }
+    switch (cmp_expr->comp_type_) {
+      case ComparisonType::Equal:
+        instr.op_ = OpCode::Equal;
+        break;
+      case ComparisonType::NotEqual:
+        instr.op_ = OpCode::NotEqual;
+        break;
+      case ComparisonType::LessThan:
+        instr.op_ = OpCode::LessThan;
+        break;
+      case ComparisonType::LessThanOrEqual:
+        instr.op_ = OpCode::LessThanOrEqual;
+        break;
+      case ComparisonType::GreaterThan:
+        instr.op_ = OpCode::GreaterThan;
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        instr.op_ = OpCode::GreaterThanOrEqual;
+        break;
+      default:
+        return -1;
+    }
+  } else if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(&expr); logic_expr != nullptr) {
+    switch (logic_expr->logic_type_) {
+      case LogicType::And:
+        instr.op_ = OpCode::And;
+        break;
+      case LogicType::Or:
+        instr.op_ = OpCode::Or;
+        break;
+      default:
+        return -1;
+    }
+  } else {
+    return -1;
+  }
+
+  auto lhs = Emit(lhs_expr, left_schema, right_schema);
+  if (lhs < 0) {
+    return -1;
+  }
+  auto rhs = Emit(rhs_expr, left_schema, right_schema);
+  if (rhs < 0) {
+    return -1;
+  }
+  instr.lhs_ = lhs;
+  instr.rhs_ = rhs;
+  instr.dst_ = num_registers_++;
+  instructions_.push_back(instr);
+  return instr.dst_;
+}
+
+void CompiledExpression::Run(size_t count) {
+  if (count == 0) {
+    return;
+  }
+  if (count > capacity_) {
+    capacity_ = count;
+    values_.resize(capacity_ * num_registers_);
+    nulls_.resize(capacity_ * num_registers_);
+  }
+
+  for (const auto &instr : instructions_) {
+    int64_t *dst = &values_[instr.dst_ * capacity_];
+    uint8_t *dst_null = &nulls_[instr.dst_ * capacity_];
+    const int64_t *lhs = &values_[instr.lhs_ * capacity_];
+    const uint8_t *lhs_null = &nulls_[instr.lhs_ * capacity_];
+    const int64_t *rhs = &values_[instr.rhs_ * capacity_];
+    const uint8_t *rhs_null = &nulls_[instr.rhs_ * capacity_];
+    const char *const *data = instr.tuple_idx_ == 0 ? left_data_.data() : right_data_.data();
+
+    switch (instr.op_) {
+      case OpCode::LoadTinyInt:
+        LoadColumn<int8_t>(data, instr.offset_, BUSTUB_INT8_NULL, dst, dst_null, count);
+        break;
+      case OpCode::LoadSmallInt:
+        LoadColumn<int16_t>(data, instr.offset_, BUSTUB_INT16_NULL, dst, dst_null, count);
+        break;
+      case OpCode::LoadInteger:
+        LoadColumn<int32_t>(data, instr.offset_, BUSTUB_INT32_NULL, dst, dst_null, count);
+        break;
+      case OpCode::LoadBigInt:
+        LoadColumn<int64_t>(data, instr.offset_, BUSTUB_INT64_NULL, dst, dst_null, count);
+        break;
+      case OpCode::LoadBoolean:
+        LoadColumn<int8_t>(data, instr.offset_, BUSTUB_BOOLEAN_NULL, dst, dst_null, count);
+        break;
+      case OpCode::LoadConstant:
+        std::fill(dst, dst + count, instr.constant_);
+        std::fill(dst_null, dst_null + count, static_cast<uint8_t>(instr.constant_is_null_));
+        break;
+      case OpCode::Plus:
+      case OpCode::Minus:
+        // Integer arithmetic wraps around in 32 bits, and a result equal to the NULL sentinel reads as NULL.
+        for (size_t i = 0; i < count; i++) {
+          auto l = static_cast<uint32_t>(lhs[i]);
+          auto r = static_cast<uint32_t>(rhs[i]);
+          auto res = static_cast<int32_t>(instr.op_ == OpCode::Plus ? l + r : l - r);
+          dst[i] = res;
+          dst_null[i] = lhs_null[i] | rhs_null[i] | static_cast<uint8_t>(res == BUSTUB_INT32_NULL);
+        }
+        break;
+      case OpCode::Equal:
+        for (size_t i = 0; i < count; i++) {
+          dst[i] = static_cast<int64_t>(lhs[i] == rhs[i]);
+          dst_null[i] = lhs_null[i] | rhs_null[i];
+        }
+        break;
+      case OpCode::NotEqual:
+        for (size_t i = 0; i < count; i++) {
+          dst[i] = static_cast<int64_t>(lhs[i] != rhs[i]);
+          dst_null[i] = lhs_null[i] | rhs_null[i];
+        }
+        break;
+      case OpCode::LessThan:
+        for (size_t i = 0; i < count; i++) {
+          dst[i] = static_cast<int64_t>(lhs[i] < rhs[i]);
+          dst_null[i] = lhs_null[i] | rhs_null[i];
+        }
+        break;
+      case OpCode::LessThanOrEqual:
+        for (size_t i = 0; i < count; i++) {
+          dst[i] = static_cast<int64_t>(lhs[i] <= rhs[i]);
+          dst_null[i] = lhs_null[i] | rhs_null[i];
+        }
+        break;
+      case OpCode::GreaterThan:
+        for (size_t i = 0; i < count; i++) {
+          dst[i] = static_cast<int64_t>(lhs[i] > rhs[i]);
+          dst_null[i] = lhs_null[i] | rhs_null[i];
+        }
+        break;
+      case OpCode::GreaterThanOrEqual:
+        for (size_t i = 0; i < count; i++) {
+          dst[i] = static_cast<int64_t>(lhs[i] >= rhs[i]);
+          dst_null[i] = lhs_null[i] | rhs_null[i];
+        }
+        break;
+      case OpCode::And:
+        // Three-valued logic: false wins over NULL.
+        for (size_t i = 0; i < count; i++) {
+          bool l_false = lhs_null[i] == 0 && lhs[i] == 0;
+          bool r_false = rhs_null[i] == 0 && rhs[i] == 0;
+          dst_null[i] = static_cast<uint8_t>(!l_false && !r_false && (lhs_null[i] | rhs_null[i]));
+          dst[i] = static_cast<int64_t>(!l_false && !r_false);
+        }
+        break;
+      case OpCode::Or:
+        // Three-valued logic: true wins over NULL.
+        for (size_t i = 0; i < count; i++) {
+          bool l_true = lhs_null[i] == 0 && lhs[i] != 0;
+          bool r_true = rhs_null[i] == 0 && rhs[i] != 0;
+          dst_null[i] = static_cast<uint8_t>(!l_true && !r_true && (lhs_null[i] | rhs_null[i]));
+          dst[i] = static_cast<int64_t>(l_true || r_true);
+        }
+        break;
+      default:
+        UNREACHABLE("Unsupported opcode.");
+    }
+  }
+}
+
+auto CompiledExpression::ResultAt(size_t i) const -> Value {
+  if (nulls_[result_ * capacity_ + i] != 0) {
+    return ValueFactory::GetNullValueByType(ret_type_);
+  }
+  auto val = values_[result_ * capacity_ + i];
+  switch (ret_type_) {
+    case TypeId::BOOLEAN:
+      return ValueFactory::GetBooleanValue(val != 0);
+    case TypeId::TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(val));
+    case TypeId::SMALLINT:
+      return ValueFactory::GetSmallIntValue(static_cast<int16_t>(val));
+    case TypeId::INTEGER:
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(val));
+    case TypeId::BIGINT:
+      return ValueFactory::GetBigIntValue(val);
+    default:
+      UNREACHABLE("Unsupported result type.");
+  }
+}
+
+auto CompiledExpression::Select(size_t count, std::vector<uint8_t> *selection) const -> size_t {
+  selection->resize(count);
+  if (count == 0) {
+    return 0;
+  }
+  const int64_t *result = &values_[result_ * capacity_];
+  const uint8_t *result_null = &nulls_[result_ * capacity_];
+  size_t selected = 0;
+  for (size_t i = 0; i < count; i++) {
+    (*selection)[i] = static_cast<uint8_t>(result_null[i] == 0 && result[i] != 0);
+    selected += (*selection)[i];
+  }
+  return selected;
+}
+
+auto CompiledExpression::Evaluate(const Tuple *tuple) -> Value {
+  left_data_.resize(1);
+  left_data_[0] = tuple->GetData();
+  Run(1);
+  return ResultAt(0);
+}
+
+auto CompiledExpression::EvaluateJoin(const Tuple *left_tuple, const Tuple *right_tuple) -> Value {
+  left_data_.resize(1);
+  right_data_.resize(1);
+  left_data_[0] = left_tuple->GetData();
+  right_data_[0] = right_tuple->GetData();
+  Run(1);
+  return ResultAt(0);
+}
+
+void CompiledExpression::EvaluateBatch(const std::vector<Tuple> &tuples, std::vector<Value> *values) {
+  left_data_.resize(tuples.size());
+  for (size_t i = 0; i < tuples.size(); i++) {
+    left_data_[i] = tuples[i].GetData();
+  }
+  Run(tuples.size());
+  values->clear();
+  values->reserve(tuples.size());
+  for (size_t i = 0; i < tuples.size(); i++) {
+    values->push_back(ResultAt(i));
+  }
+}
+
+auto CompiledExpression::SelectBatch(const std::vector<Tuple> &tuples, std::vector<uint8_t> *selection) -> size_t {
+  left_data_.resize(tuples.size());
+  for (size_t i = 0; i < tuples.size(); i++) {
+    left_data_[i] = tuples[i].GetData();
+  }
+  Run(tuples.size());
+  return Select(tuples.size(), selection);
+}
+
+auto CompiledExpression::SelectJoinBatch(const Tuple *left_tuple, const std::vector<Tuple> &right_tuples,
+                                         std::vector<uint8_t> *selection) -> size_t {
+  left_data_.assign(right_tuples.size(), left_tuple->GetData());
+  right_data_.resize(right_tuples.size());
+  for (size_t i = 0; i < right_tuples.size(); i++) {
+    right_data_[i] = right_tuples[i].GetData();
+  }
+  Run(right_tuples.size());
+  return Select(right_tuples.size(), selection);
+}
+
+}  // namespace bustub
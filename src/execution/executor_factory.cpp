@@ -17,19 +17,25 @@
 
 #include "execution/executors/abstract_executor.h"
 #include "execution/executors/aggregation_executor.h"
+#include "execution/executors/block_nested_loop_join_executor.h"
 #include "execution/executors/delete_executor.h"
 #include "execution/executors/filter_executor.h"
+#include "execution/executors/gather_executor.h"
 #include "execution/executors/hash_join_executor.h"
+#include "execution/executors/index_merge_scan_executor.h"
 #include "execution/executors/index_scan_executor.h"
 #include "execution/executors/init_check_executor.h"
 #include "execution/executors/insert_executor.h"
 #include "execution/executors/limit_executor.h"
+#include "execution/executors/merge_join_executor.h"
 #include "execution/executors/mock_scan_executor.h"
 #include "execution/executors/nested_index_join_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
 #include "execution/executors/projection_executor.h"
+#include "execution/executors/repartition_executor.h"
 #include "execution/executors/seq_scan_executor.h"
 #include "execution/executors/sort_executor.h"
+#include "execution/executors/stream_aggregation_executor.h"
 #include "execution/executors/topn_check_executor.h"
 #include "execution/executors/topn_executor.h"
 #include "execution/executors/update_executor.h"
@@ -58,6 +64,12 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<IndexScanExecutor>(exec_ctx, dynamic_cast<const IndexScanPlanNode *>(plan.get()));
     }
 
+    // Create a new index merge scan executor
+    case PlanType::IndexMergeScan: {
+      return std::make_unique<IndexMergeScanExecutor>(exec_ctx,
+                                                      dynamic_cast<const IndexMergeScanPlanNode *>(plan.get()));
+    }
+
     // Create a new insert executor
     case PlanType::Insert: {
       auto insert_plan = dynamic_cast<const InsertPlanNode *>(plan.get());
@@ -93,6 +105,13 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<AggregationExecutor>(exec_ctx, agg_plan, std::move(child_executor));
     }
 
+    // Create a new stream aggregation executor
+    case PlanType::StreamAggregation: {
+      auto agg_plan = dynamic_cast<const StreamAggregationPlanNode *>(plan.get());
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, agg_plan->GetChildPlan());
+      return std::make_unique<StreamAggregationExecutor>(exec_ctx, agg_plan, std::move(child_executor));
+    }
+
     // Create a new nested-loop join executor
     case PlanType::NestedLoopJoin: {
       auto nested_loop_join_plan = dynamic_cast<const NestedLoopJoinPlanNode *>(plan.get());
@@ -111,6 +130,15 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
                                                       std::move(right));
     }
 
+    // Create a new block nested-loop join executor
+    case PlanType::BlockNestedLoopJoin: {
+      auto block_nested_loop_join_plan = dynamic_cast<const BlockNestedLoopJoinPlanNode *>(plan.get());
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, block_nested_loop_join_plan->GetLeftPlan());
+      auto right = ExecutorFactory::CreateExecutor(exec_ctx, block_nested_loop_join_plan->GetRightPlan());
+      return std::make_unique<BlockNestedLoopJoinExecutor>(exec_ctx, block_nested_loop_join_plan, std::move(left),
+                                                           std::move(right));
+    }
+
     // Create a new nested-index join executor
     case PlanType::NestedIndexJoin: {
       auto nested_index_join_plan = dynamic_cast<const NestedIndexJoinPlanNode *>(plan.get());
@@ -126,6 +154,14 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<HashJoinExecutor>(exec_ctx, hash_join_plan, std::move(left), std::move(right));
     }
 
+    // Create a new merge join executor
+    case PlanType::MergeJoin: {
+      auto merge_join_plan = dynamic_cast<const MergeJoinPlanNode *>(plan.get());
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetLeftPlan());
+      auto right = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetRightPlan());
+      return std::make_unique<MergeJoinExecutor>(exec_ctx, merge_join_plan, std::move(left), std::move(right));
+    }
+
     // Create a new mock scan executor
     case PlanType::MockScan: {
       const auto *mock_scan_plan = dynamic_cast<const MockScanPlanNode *>(plan.get());
@@ -172,6 +208,19 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<TopNExecutor>(exec_ctx, topn_plan, std::move(child));
     }
 
+      // Create a new gather executor, which creates the executors of its workers itself
+    case PlanType::Gather: {
+      const auto *gather_plan = dynamic_cast<const GatherPlanNode *>(plan.get());
+      return std::make_unique<GatherExecutor>(exec_ctx, gather_plan);
+    }
+
+      // Create a new repartition executor
+    case PlanType::Repartition: {
+      const auto *repartition_plan = dynamic_cast<const RepartitionPlanNode *>(plan.get());
+      auto child = ExecutorFactory::CreateExecutor(exec_ctx, repartition_plan->GetChildPlan());
+      return std::make_unique<RepartitionExecutor>(exec_ctx, repartition_plan, std::move(child));
+    }
+
     default:
       UNREACHABLE("Unsupported plan type.");
   }
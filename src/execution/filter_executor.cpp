@@ -11,6 +11,7 @@ FilterExecutor::FilterExecutor(ExecutorContext *exec_ctx, const FilterPlanNode *
 void FilterExecutor::Init() {
   // Initialize the child executor
   child_executor_->Init();
+  compiled_predicate_ = CompiledExpression::Compile(plan_->GetPredicate(), child_executor_->GetOutputSchema());
 }
 
 auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
@@ -24,11 +25,48 @@ auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
       return false;
     }
 
-    auto value = filter_expr->Evaluate(tuple, child_executor_->GetOutputSchema());
+    auto value = compiled_predicate_ != nullptr ? compiled_predicate_->Evaluate(tuple)
+                                                : filter_expr->Evaluate(tuple, child_executor_->GetOutputSchema());
     if (!value.IsNull() && value.GetAs<bool>()) {
       return true;
     }
   }
 }
 
+auto FilterExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  const auto &filter_expr = plan_->GetPredicate();
+  const auto &child_schema = child_executor_->GetOutputSchema();
+
+  // Keep pulling until a batch survives the predicate, so that an empty batch always means exhaustion.
+  while (child_executor_->NextBatch(tuples, rids, batch_size)) {
+    if (compiled_predicate_ != nullptr) {
+      compiled_predicate_->SelectBatch(*tuples, &selection_);
+    } else {
+      selection_.resize(tuples->size());
+      for (size_t i = 0; i < tuples->size(); i++) {
+        auto value = filter_expr->Evaluate(&(*tuples)[i], child_schema);
+        selection_[i] = static_cast<uint8_t>(!value.IsNull() && value.GetAs<bool>());
+      }
+    }
+
+    size_t selected = 0;
+    for (size_t i = 0; i < tuples->size(); i++) {
+      if (selection_[i] == 0) {
+        continue;
+      }
+      if (selected != i) {
+        (*tuples)[selected] = std::move((*tuples)[i]);
+        (*rids)[selected] = (*rids)[i];
+      }
+      selected++;
+    }
+    tuples->resize(selected);
+    rids->resize(selected);
+    if (selected > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace bustub
@@ -8,9 +8,16 @@
 #include "execution/plans/abstract_plan.h"
 #include "execution/plans/aggregation_plan.h"
 #include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_merge_scan_plan.h"
+#include "execution/plans/index_scan_plan.h"
 #include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/mock_scan_plan.h"
 #include "execution/plans/projection_plan.h"
+#include "execution/plans/repartition_plan.h"
+#include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/plans/stream_aggregation_plan.h"
 #include "execution/plans/topn_plan.h"
 
 namespace bustub {
@@ -36,11 +43,88 @@ auto AggregationPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Agg {{ types={}, aggregates={}, group_by={} }}", agg_types_, aggregates_, group_bys_);
 }
 
+auto StreamAggregationPlanNode::PlanNodeToString() const -> std::string {
+  return fmt::format("StreamAgg {{ types={}, aggregates={}, group_by={} }}", GetAggregateTypes(), GetAggregates(),
+                     GetGroupBys());
+}
+
 auto HashJoinPlanNode::PlanNodeToString() const -> std::string {
+  if (runtime_filter_id_.has_value()) {
+    return fmt::format("HashJoin {{ type={}, left_key={}, right_key={}, runtime_filter=rf{} }}", join_type_,
+                       left_key_expressions_, right_key_expressions_, *runtime_filter_id_);
+  }
   return fmt::format("HashJoin {{ type={}, left_key={}, right_key={} }}", join_type_, left_key_expressions_,
                      right_key_expressions_);
 }
 
+/** @return the runtime filters pushed down to a scan, as the filter they check and the join keys they check it with */
+static auto RuntimeFiltersToString(const std::vector<RuntimeFilterProbe> &probes) -> std::string {
+  std::vector<std::string> probe_strs;
+  probe_strs.reserve(probes.size());
+  for (const auto &probe : probes) {
+    probe_strs.push_back(fmt::format("rf{}{}", probe.filter_id_, probe.key_expressions_));
+  }
+  return fmt::format("[{}]", fmt::join(probe_strs, ", "));
+}
+
+auto SeqScanPlanNode::PlanNodeToString() const -> std::string {
+  std::string extra;
+  if (filter_predicate_) {
+    extra += fmt::format(", filter={}", filter_predicate_);
+  }
+  if (!runtime_filters_.empty()) {
+    extra += fmt::format(", runtime_filters={}", RuntimeFiltersToString(runtime_filters_));
+  }
+  if (!column_ids_.empty()) {
+    extra += fmt::format(", columns={}", column_ids_);
+  }
+  return fmt::format("SeqScan {{ table={}{} }}", table_name_, extra);
+}
+
+auto IndexScanPlanNode::PlanNodeToString() const -> std::string {
+  std::string extra;
+  if (!pred_keys_.empty()) {
+    extra += fmt::format(", pred_keys={}", pred_keys_);
+  }
+  if (filter_predicate_) {
+    extra += fmt::format(", filter={}", filter_predicate_);
+  }
+  if (sort_rids_) {
+    extra += ", sort_rids=true";
+  }
+  return fmt::format("IndexScan {{ index_oid={}{} }}", index_oid_, extra);
+}
+
+auto IndexMergeScanPlanNode::PlanNodeToString() const -> std::string {
+  std::vector<std::string> lookup_strs;
+  lookup_strs.reserve(lookups_.size());
+  for (const auto &lookup : lookups_) {
+    lookup_strs.push_back(fmt::format("index{}{}", lookup.index_oid_, lookup.keys_));
+  }
+  std::string extra;
+  if (filter_predicate_) {
+    extra += fmt::format(", filter={}", filter_predicate_);
+  }
+  return fmt::format("IndexMergeScan {{ table={}, type={}, lookups=[{}]{} }}", table_name_, merge_type_,
+                     fmt::join(lookup_strs, ", "), extra);
+}
+
+auto MockScanPlanNode::PlanNodeToString() const -> std::string {
+  std::string extra;
+  if (!runtime_filters_.empty()) {
+    extra += fmt::format(", runtime_filters={}", RuntimeFiltersToString(runtime_filters_));
+  }
+  if (!column_ids_.empty()) {
+    extra += fmt::format(", columns={}", column_ids_);
+  }
+  return fmt::format("MockScan {{ table={}{} }}", table_, extra);
+}
+
+auto MergeJoinPlanNode::PlanNodeToString() const -> std::string {
+  return fmt::format("MergeJoin {{ type={}, left_key={}, right_key={}, key_orders={} }}", join_type_,
+                     left_key_expressions_, right_key_expressions_, key_orders_);
+}
+
 auto ProjectionPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Projection {{ exprs={} }}", expressions_);
 }
@@ -59,4 +143,8 @@ auto TopNPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("TopN {{ n={}, order_bys={}}}", n_, order_bys_);
 }
 
+auto RepartitionPlanNode::PlanNodeToString() const -> std::string {
+  return fmt::format("Repartition {{ partition_by={} }}", partition_bys_);
+}
+
 }  // namespace bustub
@@ -0,0 +1,164 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.cpp
+//
+// Identification: src/execution/gather_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/gather_executor.h"
+
+#include <algorithm>
+
+#include "execution/executor_factory.h"
+
+namespace bustub {
+
+GatherExecutor::GatherExecutor(ExecutorContext *exec_ctx, const GatherPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+GatherExecutor::~GatherExecutor() { StopWorkers(); }
+
+void GatherExecutor::Init() {
+  StopWorkers();
+
+  auto parallelism = std::max<size_t>(plan_->GetParallelism(), 1);
+  parallel_ctx_ = std::make_shared<ParallelContext>(parallelism);
+  worker_ctxs_.clear();
+  worker_executors_.clear();
+  batches_.clear();
+  cancelled_ = false;
+  error_ = nullptr;
+  current_tuples_.clear();
+  current_rids_.clear();
+  cursor_ = 0;
+
+  // Executors are created up front on this thread, so that the workers only ever touch their own copy.
+  for (size_t i = 0; i < parallelism; i++) {
+    auto worker_ctx = std::make_unique<ExecutorContext>(
+        exec_ctx_->GetTransaction(), exec_ctx_->GetCatalog(), exec_ctx_->GetBufferPoolManager(),
+        exec_ctx_->GetTransactionManager(), exec_ctx_->GetLockManager(), exec_ctx_->IsDelete());
+    worker_ctx->InitCheckOptions(exec_ctx_->GetCheckOptions());
+    // The workers run side by side, so they split the memory budget of each operator between them
+    worker_ctx->SetMemoryBudget(std::max<size_t>(exec_ctx_->GetMemoryBudget() / parallelism, 1));
+    worker_ctx->SetParallelContext(parallel_ctx_, i);
+    worker_executors_.push_back(ExecutorFactory::CreateExecutor(worker_ctx.get(), plan_->GetChildPlan()));
+    worker_ctxs_.push_back(std::move(worker_ctx));
+  }
+
+  running_workers_ = parallelism;
+  for (size_t i = 0; i < parallelism; i++) {
+    workers_.emplace_back(&GatherExecutor::RunWorker, this, i);
+  }
+}
+
+void GatherExecutor::RunWorker(size_t worker_id) {
+  // Enough room for every worker to have a batch in flight while the consumer catches up
+  const size_t max_batches = 2 * worker_executors_.size();
+  try {
+    auto *executor = worker_executors_[worker_id].get();
+    executor->Init();
+    std::vector<Tuple> tuples;
+    std::vector<RID> rids;
+    while (executor->NextBatch(&tuples, &rids, BUSTUB_BATCH_SIZE)) {
+      std::unique_lock guard(latch_);
+      not_full_.wait(guard, [&] { return cancelled_ || batches_.size() < max_batches; });
+      if (cancelled_) {
+        break;
+      }
+      batches_.emplace_back(std::move(tuples), std::move(rids));
+      not_empty_.notify_one();
+    }
+  } catch (...) {
+    {
+      std::scoped_lock guard(latch_);
+      if (error_ == nullptr) {
+        error_ = std::current_exception();
+      }
+    }
+    // Wake up the other workers if they are waiting for this one in an exchange
+    parallel_ctx_->Abort();
+  }
+  std::scoped_lock guard(latch_);
+  running_workers_--;
+  not_empty_.notify_all();
+}
+
+void GatherExecutor::StopWorkers() {
+  if (workers_.empty()) {
+    return;
+  }
+  {
+    std::scoped_lock guard(latch_);
+    cancelled_ = true;
+    not_full_.notify_all();
+  }
+  parallel_ctx_->Abort();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void GatherExecutor::Close() {
+  StopWorkers();
+  std::scoped_lock guard(latch_);
+  batches_.clear();
+}
+
+auto GatherExecutor::PopBatch() -> bool {
+  std::unique_lock guard(latch_);
+  not_empty_.wait(guard, [&] { return error_ != nullptr || !batches_.empty() || running_workers_ == 0; });
+  if (error_ != nullptr) {
+    std::rethrow_exception(error_);
+  }
+  if (batches_.empty()) {
+    return false;
+  }
+  current_tuples_ = std::move(batches_.front().first);
+  current_rids_ = std::move(batches_.front().second);
+  batches_.pop_front();
+  not_full_.notify_one();
+  cursor_ = 0;
+  return true;
+}
+
+auto GatherExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (cursor_ == current_tuples_.size()) {
+    if (!PopBatch()) {
+      return false;
+    }
+  }
+  *tuple = std::move(current_tuples_[cursor_]);
+  *rid = current_rids_[cursor_];
+  cursor_++;
+  return true;
+}
+
+auto GatherExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  rids->clear();
+  while (cursor_ == current_tuples_.size()) {
+    if (!PopBatch()) {
+      return false;
+    }
+  }
+  if (cursor_ == 0 && current_tuples_.size() <= batch_size) {
+    // Hand over the whole batch of the worker without copying it
+    std::swap(*tuples, current_tuples_);
+    std::swap(*rids, current_rids_);
+    return true;
+  }
+  auto end = std::min(current_tuples_.size(), cursor_ + batch_size);
+  for (; cursor_ < end; cursor_++) {
+    tuples->push_back(std::move(current_tuples_[cursor_]));
+    rids->push_back(current_rids_[cursor_]);
+  }
+  return true;
+}
+
+}  // namespace bustub
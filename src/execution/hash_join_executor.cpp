@@ -12,20 +12,344 @@
 
 #include "execution/executors/hash_join_executor.h"
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>  // NOLINT
+
+#include "execution/join_util.h"
+
 namespace bustub {
 
+/** The largest number of hash bits the build side is partitioned on, beyond which scattering thrashes the TLB */
+static constexpr size_t MAX_PARTITION_BITS = 10;
+/** The number of low hash bits that pick the spill partition of a tuple, at each level of spilling */
+static constexpr size_t SPILL_PARTITION_BITS = 4;
+/** The number of times a partition may be spilled again, which stops before reaching the radix partitioning bits */
+static constexpr size_t MAX_SPILL_LEVEL = 4;
+/** The memory held by a build tuple in the hash table besides its data and key, roughly one node and bucket slot */
+static constexpr size_t HASH_TABLE_ENTRY_OVERHEAD = 32;
+
+/** @return an estimate of the memory a build tuple holds until the hash table is freed */
+static auto EntryMemory(const HashJoinKey &key, const Tuple &tuple) -> size_t {
+  return sizeof(std::pair<HashJoinKey, Tuple>) + key.keys_.size() * sizeof(Value) + tuple.GetLength() +
+         HASH_TABLE_ENTRY_OVERHEAD;
+}
+
 HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
                                    std::unique_ptr<AbstractExecutor> &&left_child,
                                    std::unique_ptr<AbstractExecutor> &&right_child)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_child_(std::move(left_child)),
+      right_child_(std::move(right_child)) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void HashJoinExecutor::Init() { throw NotImplementedException("HashJoinExecutor is not implemented"); }
+void HashJoinExecutor::Init() {
+  left_child_->Init();
+  right_child_->Init();
+
+  pending_.clear();
+  probe_source_ = nullptr;
+  level_ = 0;
+  Build(nullptr);
+
+  left_tuples_.clear();
+  left_keys_.clear();
+  left_rids_.clear();
+  left_cursor_ = 0;
+  probing_ = false;
+}
+
+auto HashJoinExecutor::SpillPartitionOf(hash_t hash) const -> size_t {
+  return (hash >> (level_ * SPILL_PARTITION_BITS)) & ((1UL << SPILL_PARTITION_BITS) - 1);
+}
+
+void HashJoinExecutor::Build(TmpTupleFile *source) {
+  const size_t num_spill_partitions = 1UL << SPILL_PARTITION_BITS;
+  const auto memory_budget = exec_ctx_->GetMemoryBudget();
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  // Without a buffer pool, or once the hash bits are used up, partitions stay in memory whatever their size
+  const bool can_spill = bpm != nullptr && level_ < MAX_SPILL_LEVEL;
+
+  std::vector<std::vector<std::pair<HashJoinKey, Tuple>>> resident(num_spill_partitions);
+  std::vector<size_t> resident_memory(num_spill_partitions, 0);
+  size_t total_memory = 0;
+  spilled_build_.clear();
+  spilled_build_.resize(num_spill_partitions);
+  spilled_probe_.clear();
+  spilled_probe_.resize(num_spill_partitions);
+
+  // The first pass sees every right tuple, so it is the one that builds the runtime filter
+  std::shared_ptr<RuntimeFilter> runtime_filter;
+  if (source == nullptr && plan_->runtime_filter_id_.has_value()) {
+    runtime_filter = std::make_shared<RuntimeFilter>();
+  }
+
+  std::vector<Tuple> right_tuples;
+  std::vector<RID> right_rids;
+  if (source != nullptr) {
+    source->Rewind();
+  }
+  while (source == nullptr ? right_child_->NextBatch(&right_tuples, &right_rids, BUSTUB_BATCH_SIZE)
+                           : source->ReadBatch(&right_tuples, BUSTUB_BATCH_SIZE)) {
+    for (auto &right_tuple : right_tuples) {
+      auto key = MakeRightJoinKey(right_tuple);
+      if (key.HasNull()) {
+        continue;
+      }
+      if (runtime_filter != nullptr) {
+        runtime_filter->Insert(key.keys_);
+      }
+      auto partition = SpillPartitionOf(key.hash_);
+      if (spilled_build_[partition] != nullptr) {
+        spilled_build_[partition]->Append(right_tuple);
+        continue;
+      }
+      auto memory = EntryMemory(key, right_tuple);
+      resident[partition].emplace_back(std::move(key), std::move(right_tuple));
+      resident_memory[partition] += memory;
+      total_memory += memory;
+
+      if (can_spill && total_memory > memory_budget) {
+        // Write out the largest partition, which frees the most memory for the fewest partitions on disk
+        auto victim = std::max_element(resident_memory.begin(), resident_memory.end()) - resident_memory.begin();
+        spilled_build_[victim] = std::make_unique<TmpTupleFile>(bpm);
+        spilled_probe_[victim] = std::make_unique<TmpTupleFile>(bpm);
+        for (const auto &entry : resident[victim]) {
+          spilled_build_[victim]->Append(entry.second);
+        }
+        resident[victim].clear();
+        resident[victim].shrink_to_fit();
+        total_memory -= resident_memory[victim];
+        resident_memory[victim] = 0;
+      }
+    }
+  }
+
+  if (runtime_filter != nullptr) {
+    runtime_filter->Finish();
+    exec_ctx_->SetRuntimeFilter(*plan_->runtime_filter_id_, std::move(runtime_filter));
+  }
+
+  std::vector<std::pair<HashJoinKey, Tuple>> entries;
+  for (auto &partition : resident) {
+    std::move(partition.begin(), partition.end(), std::back_inserter(entries));
+    partition.clear();
+  }
+  BuildHashTable(std::move(entries));
+}
+
+void HashJoinExecutor::BuildHashTable(std::vector<std::pair<HashJoinKey, Tuple>> &&entries) {
+  // Use enough partitions for each of them to hold about BUSTUB_HASH_JOIN_PARTITION_SIZE tuples
+  partition_bits_ = 0;
+  while (partition_bits_ < MAX_PARTITION_BITS &&
+         (entries.size() >> partition_bits_) > BUSTUB_HASH_JOIN_PARTITION_SIZE) {
+    partition_bits_++;
+  }
+  size_t num_partitions = 1UL << partition_bits_;
+
+  // Scatter the entries into their partitions, sizing each partition upfront from a histogram of the hashes
+  std::vector<size_t> histogram(num_partitions, 0);
+  for (const auto &entry : entries) {
+    histogram[PartitionOf(entry.first.hash_)]++;
+  }
+  std::vector<std::vector<std::pair<HashJoinKey, Tuple>>> scattered(num_partitions);
+  for (size_t i = 0; i < num_partitions; i++) {
+    scattered[i].reserve(histogram[i]);
+  }
+  for (auto &entry : entries) {
+    auto partition = PartitionOf(entry.first.hash_);
+    scattered[partition].push_back(std::move(entry));
+  }
+  entries.clear();
+  entries.shrink_to_fit();
+
+  partitions_.clear();
+  partitions_.resize(num_partitions);
+  std::atomic<size_t> next_partition{0};
+  auto build_partitions = [&]() {
+    for (auto i = next_partition++; i < num_partitions; i = next_partition++) {
+      auto &ht = partitions_[i];
+      ht.reserve(scattered[i].size());
+      for (auto &[key, tuple] : scattered[i]) {
+        ht[std::move(key)].push_back(std::move(tuple));
+      }
+      scattered[i].clear();
+      scattered[i].shrink_to_fit();
+    }
+  };
 
-auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+  // The partitions are independent, so they are built on as many threads as there are cores. Workers of a parallel
+  // plan each build their own join already, so they stay on their thread.
+  size_t num_threads = 1;
+  if (exec_ctx_->GetParallelContext() == nullptr) {
+    num_threads = std::min<size_t>(num_partitions, std::max(std::thread::hardware_concurrency(), 1U));
+  }
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; i++) {
+    threads.emplace_back(build_partitions);
+  }
+  build_partitions();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+auto HashJoinExecutor::NextProbeBatch() -> bool {
+  while (true) {
+    auto fetched = probe_source_ == nullptr ? left_child_->NextBatch(&left_tuples_, &left_rids_, BUSTUB_BATCH_SIZE)
+                                            : probe_source_->ReadBatch(&left_tuples_, BUSTUB_BATCH_SIZE);
+    if (!fetched) {
+      if (!StartNextPass()) {
+        return false;
+      }
+      continue;
+    }
+
+    // Set aside the left tuples of spilled partitions, and compact the others at the front of the batch
+    left_keys_.clear();
+    size_t kept = 0;
+    for (size_t i = 0; i < left_tuples_.size(); i++) {
+      auto key = MakeLeftJoinKey(left_tuples_[i]);
+      if (!key.HasNull() && !spilled_probe_.empty()) {
+        auto *spilled = spilled_probe_[SpillPartitionOf(key.hash_)].get();
+        if (spilled != nullptr) {
+          spilled->Append(left_tuples_[i]);
+          continue;
+        }
+      }
+      if (kept != i) {
+        left_tuples_[kept] = std::move(left_tuples_[i]);
+      }
+      kept++;
+      left_keys_.push_back(std::move(key));
+    }
+    left_tuples_.resize(kept);
+    if (!left_tuples_.empty()) {
+      return true;
+    }
+  }
+}
+
+auto HashJoinExecutor::StartNextPass() -> bool {
+  for (size_t i = 0; i < spilled_build_.size(); i++) {
+    if (spilled_build_[i] != nullptr) {
+      pending_.push_back({std::move(spilled_build_[i]), std::move(spilled_probe_[i]), level_ + 1});
+    }
+  }
+  spilled_build_.clear();
+  spilled_probe_.clear();
+
+  // Join the most recently spilled partitions first, so that their sub-partitions are freed before moving on
+  while (!pending_.empty()) {
+    auto partition = std::move(pending_.back());
+    pending_.pop_back();
+    // Without left tuples, a spilled partition has no output
+    if (partition.probe_->Size() == 0) {
+      continue;
+    }
+    level_ = partition.level_;
+    Build(partition.build_.get());
+    probe_source_ = std::move(partition.probe_);
+    probe_source_->Rewind();
+    return true;
+  }
+  probe_source_ = nullptr;
+  return false;
+}
+
+auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    if (probing_ && EmitNext(tuple)) {
+      return true;
+    }
+    if (probing_) {
+      probing_ = false;
+      left_cursor_++;
+    }
+    if (left_cursor_ >= left_tuples_.size()) {
+      left_cursor_ = 0;
+      if (!NextProbeBatch()) {
+        return false;
+      }
+    }
+    Probe();
+  }
+}
+
+auto HashJoinExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  rids->clear();
+  Tuple tuple{};
+  while (tuples->size() < batch_size && Next(&tuple, nullptr)) {
+    tuples->push_back(std::move(tuple));
+    rids->emplace_back();
+  }
+  return !tuples->empty();
+}
+
+auto HashJoinExecutor::MakeLeftJoinKey(const Tuple &tuple) const -> HashJoinKey {
+  std::vector<Value> keys;
+  keys.reserve(plan_->LeftJoinKeyExpressions().size());
+  for (const auto &expr : plan_->LeftJoinKeyExpressions()) {
+    keys.emplace_back(expr->Evaluate(&tuple, left_child_->GetOutputSchema()));
+  }
+  HashJoinKey key;
+  key.keys_ = std::move(keys);
+  key.ComputeHash();
+  return key;
+}
+
+auto HashJoinExecutor::MakeRightJoinKey(const Tuple &tuple) const -> HashJoinKey {
+  std::vector<Value> keys;
+  keys.reserve(plan_->RightJoinKeyExpressions().size());
+  for (const auto &expr : plan_->RightJoinKeyExpressions()) {
+    keys.emplace_back(expr->Evaluate(&tuple, right_child_->GetOutputSchema()));
+  }
+  HashJoinKey key;
+  key.keys_ = std::move(keys);
+  key.ComputeHash();
+  return key;
+}
+
+void HashJoinExecutor::Probe() {
+  probing_ = true;
+  matches_ = nullptr;
+  match_cursor_ = 0;
+  null_padded_emitted_ = false;
+  const auto &key = left_keys_[left_cursor_];
+  if (key.HasNull()) {
+    return;
+  }
+  const auto &ht = partitions_[PartitionOf(key.hash_)];
+  auto iter = ht.find(key);
+  if (iter != ht.end()) {
+    matches_ = &iter->second;
+  }
+}
+
+auto HashJoinExecutor::EmitNext(Tuple *tuple) -> bool {
+  const auto &left = left_tuples_[left_cursor_];
+  if (matches_ != nullptr) {
+    if (match_cursor_ < matches_->size()) {
+      *tuple = MakeJoinOutputTuple(left, left_child_->GetOutputSchema(), &(*matches_)[match_cursor_++],
+                                   right_child_->GetOutputSchema(), GetOutputSchema());
+      return true;
+    }
+    return false;
+  }
+  if (plan_->GetJoinType() == JoinType::LEFT && !null_padded_emitted_) {
+    null_padded_emitted_ = true;
+    *tuple = MakeJoinOutputTuple(left, left_child_->GetOutputSchema(), nullptr, right_child_->GetOutputSchema(),
+                                 GetOutputSchema());
+    return true;
+  }
+  return false;
+}
 
 }  // namespace bustub
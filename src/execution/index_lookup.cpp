@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_lookup.cpp
+//
+// Identification: src/execution/index_lookup.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/index_lookup.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace bustub {
+
+auto LookUpIndexKeys(const IndexInfo &index_info, const std::vector<AbstractExpressionRef> &keys, Transaction *txn,
+                     bool in_page_order) -> std::vector<RID> {
+  const Schema dummy_schema{std::vector<Column>{}};
+  std::vector<RID> rids;
+  for (const auto &key_expr : keys) {
+    Tuple key({key_expr->Evaluate(nullptr, dummy_schema)}, &index_info.key_schema_);
+    index_info.index_->ScanKey(key, &rids, txn);
+  }
+  if (in_page_order) {
+    // In page order, the tuples on a page are read one after another. The same key may be looked up twice, and each
+    // tuple is only produced once.
+    std::sort(rids.begin(), rids.end(), RidLess);
+    rids.erase(std::unique(rids.begin(), rids.end()), rids.end());
+  }
+  return rids;
+}
+
+/** @return `true` if the tuple is visible and satisfies the predicate */
+static auto IsTupleSelected(const TupleMeta &meta, const Tuple &tuple, const AbstractExpressionRef &predicate,
+                            const Schema &schema) -> bool {
+  if (meta.is_deleted_) {
+    return false;
+  }
+  if (predicate != nullptr) {
+    auto value = predicate->Evaluate(&tuple, schema);
+    return !value.IsNull() && value.GetAs<bool>();
+  }
+  return true;
+}
+
+void ReadSelectedTuples(TableHeap *table_heap, const std::vector<RID> &lookup_rids, bool in_page_order,
+                        const AbstractExpressionRef &predicate, const Schema &schema, std::vector<Tuple> *tuples,
+                        std::vector<RID> *rids) {
+  if (in_page_order) {
+    for (auto &[meta, tuple] : table_heap->GetTuples(lookup_rids)) {
+      if (IsTupleSelected(meta, tuple, predicate, schema)) {
+        rids->push_back(tuple.GetRid());
+        tuples->push_back(std::move(tuple));
+      }
+    }
+    return;
+  }
+  for (const auto &rid : lookup_rids) {
+    auto [meta, tuple] = table_heap->GetTuple(rid);
+    if (IsTupleSelected(meta, tuple, predicate, schema)) {
+      tuples->push_back(std::move(tuple));
+      rids->push_back(rid);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_merge_scan_executor.cpp
+//
+// Identification: src/execution/index_merge_scan_executor.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/index_merge_scan_executor.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "execution/index_lookup.h"
+
+namespace bustub {
+
+IndexMergeScanExecutor::IndexMergeScanExecutor(ExecutorContext *exec_ctx, const IndexMergeScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+auto IndexMergeScanExecutor::LookUp(const IndexLookup &lookup) -> std::vector<RID> {
+  auto *index_info = exec_ctx_->GetCatalog()->GetIndex(lookup.index_oid_);
+  return LookUpIndexKeys(*index_info, lookup.keys_, exec_ctx_->GetTransaction(), true);
+}
+
+void IndexMergeScanExecutor::Init() {
+  table_heap_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid())->table_.get();
+  cursor_ = 0;
+  next_.Reset();
+
+  rids_ = LookUp(plan_->lookups_[0]);
+  std::vector<RID> merged;
+  for (size_t i = 1; i < plan_->lookups_.size(); i++) {
+    // Nothing is left to intersect with
+    if (plan_->merge_type_ == IndexMergeType::Intersect && rids_.empty()) {
+      break;
+    }
+    auto found = LookUp(plan_->lookups_[i]);
+    merged.clear();
+    if (plan_->merge_type_ == IndexMergeType::Intersect) {
+      std::set_intersection(rids_.begin(), rids_.end(), found.begin(), found.end(), std::back_inserter(merged),
+                            RidLess);
+    } else {
+      std::set_union(rids_.begin(), rids_.end(), found.begin(), found.end(), std::back_inserter(merged), RidLess);
+    }
+    std::swap(rids_, merged);
+  }
+}
+
+auto IndexMergeScanExecutor::Next(Tuple *tuple, RID *rid) -> bool { return next_.Next(this, tuple, rid); }
+
+auto IndexMergeScanExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  rids->clear();
+  while (tuples->empty() && cursor_ < rids_.size()) {
+    auto end = std::min(rids_.size(), cursor_ + batch_size);
+    batch_rids_.assign(rids_.begin() + cursor_, rids_.begin() + end);
+    cursor_ = end;
+    ReadSelectedTuples(table_heap_, batch_rids_, true, plan_->filter_predicate_, GetOutputSchema(), tuples, rids);
+  }
+  return !tuples->empty();
+}
+
+}  // namespace bustub
@@ -11,12 +11,57 @@
 //===----------------------------------------------------------------------===//
 #include "execution/executors/index_scan_executor.h"
 
+#include <algorithm>
+
+#include "execution/index_lookup.h"
+
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+void IndexScanExecutor::Init() {
+  auto *catalog = exec_ctx_->GetCatalog();
+  auto *index_info = catalog->GetIndex(plan_->GetIndexOid());
+  table_info_ = catalog->GetTable(index_info->table_name_);
+  iter_.reset();
+  lookup_rids_.clear();
+  cursor_ = 0;
+  next_.Reset();
+
+  if (plan_->pred_keys_.empty()) {
+    auto *tree = dynamic_cast<BPlusTreeIndexForTwoIntegerColumn *>(index_info->index_.get());
+    iter_.emplace(tree->GetBeginIterator());
+    return;
+  }
+
+  lookup_rids_ = LookUpIndexKeys(*index_info, plan_->pred_keys_, exec_ctx_->GetTransaction(), plan_->sort_rids_);
+}
+
+auto IndexScanExecutor::NextRids(size_t batch_size) -> bool {
+  batch_rids_.clear();
+  if (iter_.has_value()) {
+    while (batch_rids_.size() < batch_size && !iter_->IsEnd()) {
+      batch_rids_.push_back((**iter_).second);
+      ++(*iter_);
+    }
+  } else {
+    auto end = std::min(lookup_rids_.size(), cursor_ + batch_size);
+    batch_rids_.assign(lookup_rids_.begin() + cursor_, lookup_rids_.begin() + end);
+    cursor_ = end;
+  }
+  return !batch_rids_.empty();
+}
 
-void IndexScanExecutor::Init() { throw NotImplementedException("IndexScanExecutor is not implemented"); }
+auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool { return next_.Next(this, tuple, rid); }
 
-auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto IndexScanExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  rids->clear();
+  while (tuples->empty() && NextRids(batch_size)) {
+    ReadSelectedTuples(table_info_->table_.get(), batch_rids_, plan_->sort_rids_, plan_->filter_predicate_,
+                       GetOutputSchema(), tuples, rids);
+  }
+  return !tuples->empty();
+}
 
 }  // namespace bustub
@@ -0,0 +1,38 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_util.cpp
+//
+// Identification: src/execution/join_util.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/join_util.h"
+
+#include <vector>
+
+#include "type/value_factory.h"
+
+namespace bustub {
+
+auto MakeJoinOutputTuple(const Tuple &left, const Schema &left_schema, const Tuple *right, const Schema &right_schema,
+                         const Schema &out_schema) -> Tuple {
+  std::vector<Value> values;
+  values.reserve(out_schema.GetColumnCount());
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    values.emplace_back(left.GetValue(&left_schema, i));
+  }
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    if (right != nullptr) {
+      values.emplace_back(right->GetValue(&right_schema, i));
+    } else {
+      values.emplace_back(ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType()));
+    }
+  }
+  return {values, &out_schema};
+}
+
+}  // namespace bustub
@@ -12,14 +12,56 @@
 
 #include "execution/executors/limit_executor.h"
 
+#include <algorithm>
+
 namespace bustub {
 
 LimitExecutor::LimitExecutor(ExecutorContext *exec_ctx, const LimitPlanNode *plan,
                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void LimitExecutor::Init() {
+  emitted_ = 0;
+  // With nothing to produce, the child is not even initialized, which may be where all its work is
+  if (plan_->GetLimit() > 0) {
+    child_executor_->Init();
+  }
+}
+
+auto LimitExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (emitted_ >= plan_->GetLimit()) {
+    return false;
+  }
+  if (!child_executor_->Next(tuple, rid)) {
+    return false;
+  }
+  if (++emitted_ == plan_->GetLimit()) {
+    child_executor_->Close();
+  }
+  return true;
+}
 
-void LimitExecutor::Init() { throw NotImplementedException("LimitExecutor is not implemented"); }
+auto LimitExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  rids->clear();
+  if (emitted_ >= plan_->GetLimit()) {
+    return false;
+  }
+  // Never ask for more tuples than are still needed, so that the scans below stop as early as they can
+  if (!child_executor_->NextBatch(tuples, rids, std::min(batch_size, plan_->GetLimit() - emitted_))) {
+    return false;
+  }
+  emitted_ += tuples->size();
+  if (emitted_ >= plan_->GetLimit()) {
+    child_executor_->Close();
+  }
+  return true;
+}
 
-auto LimitExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+void LimitExecutor::Close() {
+  if (plan_->GetLimit() > 0) {
+    child_executor_->Close();
+  }
+}
 
 }  // namespace bustub
@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.cpp
+//
+// Identification: src/execution/merge_join_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/merge_join_executor.h"
+
+#include "execution/join_util.h"
+
+namespace bustub {
+
+MergeJoinExecutor::MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&left_child,
+                                     std::unique_ptr<AbstractExecutor> &&right_child)
+    : AbstractExecutor(exec_ctx), plan_(plan) {
+  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
+    throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
+  }
+  left_.child_ = std::move(left_child);
+  left_.key_expressions_ = &plan_->LeftJoinKeyExpressions();
+  right_.child_ = std::move(right_child);
+  right_.key_expressions_ = &plan_->RightJoinKeyExpressions();
+}
+
+void MergeJoinExecutor::Init() {
+  for (auto *input : {&left_, &right_}) {
+    input->child_->Init();
+    input->tuples_.clear();
+    input->cursor_ = 0;
+    input->valid_ = true;
+    Advance(input);
+  }
+  run_.clear();
+  has_run_ = false;
+  joining_ = false;
+  next_.Reset();
+}
+
+void MergeJoinExecutor::Advance(Input *input) {
+  // The cursor points past the end of an empty or exhausted batch before the first tuple is read
+  if (input->cursor_ < input->tuples_.size()) {
+    input->cursor_++;
+  }
+  while (input->cursor_ == input->tuples_.size()) {
+    input->cursor_ = 0;
+    if (!input->child_->NextBatch(&input->tuples_, &input->rids_, BUSTUB_BATCH_SIZE)) {
+      input->tuples_.clear();
+      input->valid_ = false;
+      return;
+    }
+  }
+
+  const auto &tuple = input->Current();
+  const auto &schema = input->child_->GetOutputSchema();
+  input->key_.clear();
+  input->key_has_null_ = false;
+  for (size_t i = 0; i < input->key_expressions_->size(); i++) {
+    auto value = (*input->key_expressions_)[i]->Evaluate(&tuple, schema);
+    input->key_has_null_ |= value.IsNull();
+    SortKeyEncoder::AppendValue(value, plan_->GetKeyOrders()[i] == OrderByType::DESC, &input->key_);
+  }
+}
+
+void MergeJoinExecutor::FindRun() {
+  if (has_run_ && run_key_ == left_.key_) {
+    return;
+  }
+  // Both sides are sorted the same way, so the right tuples with smaller keys match no later left tuple either
+  while (right_.valid_ && (right_.key_has_null_ || right_.key_ < left_.key_)) {
+    Advance(&right_);
+  }
+  run_.clear();
+  run_key_ = left_.key_;
+  has_run_ = true;
+  while (right_.valid_ && !right_.key_has_null_ && right_.key_ == left_.key_) {
+    run_.push_back(right_.Current());
+    Advance(&right_);
+  }
+}
+
+auto MergeJoinExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  rids->clear();
+  while (tuples->size() < batch_size && left_.valid_) {
+    if (!joining_) {
+      if (!left_.key_has_null_) {
+        FindRun();
+      }
+      joining_ = true;
+      run_cursor_ = 0;
+    }
+
+    if (left_.key_has_null_ || run_.empty()) {
+      if (plan_->GetJoinType() == JoinType::LEFT) {
+        tuples->push_back(MakeJoinOutputTuple(left_.Current(), left_.child_->GetOutputSchema(), nullptr,
+                                              right_.child_->GetOutputSchema(), GetOutputSchema()));
+        rids->emplace_back();
+      }
+    } else {
+      // A large run may take several batches for one left tuple
+      for (; run_cursor_ < run_.size() && tuples->size() < batch_size; run_cursor_++) {
+        tuples->push_back(MakeJoinOutputTuple(left_.Current(), left_.child_->GetOutputSchema(), &run_[run_cursor_],
+                                              right_.child_->GetOutputSchema(), GetOutputSchema()));
+        rids->emplace_back();
+      }
+      if (run_cursor_ < run_.size()) {
+        break;
+      }
+    }
+    joining_ = false;
+    Advance(&left_);
+  }
+  return !tuples->empty();
+}
+
+auto MergeJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return next_.Next(this, tuple, rid); }
+
+}  // namespace bustub
@@ -200,32 +200,32 @@ auto GetShuffled(const MockScanPlanNode *plan) -> bool {
   return false;
 }
 
-auto GetFunctionOf(const MockScanPlanNode *plan) -> std::function<Tuple(size_t)> {
+auto GetFunctionOf(const MockScanPlanNode *plan, const Schema *schema) -> std::function<Tuple(size_t)> {
   const auto &table = plan->GetTable();
 
   if (table == "__mock_table_1") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.reserve(2);
       values.push_back(ValueFactory::GetIntegerValue(cursor));
       values.push_back(ValueFactory::GetIntegerValue(cursor * 100));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_table_2") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.reserve(2);
       values.push_back(ValueFactory::GetVarcharValue(fmt::format("{}-\U0001F4A9", cursor)));  // the poop emoji
       values.push_back(
           ValueFactory::GetVarcharValue(StringUtil::Repeat("\U0001F607", cursor % 8)));  // the innocent emoji
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_table_3") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.reserve(2);
       if (cursor % 2 == 0) {
@@ -234,48 +234,48 @@ auto GetFunctionOf(const MockScanPlanNode *plan) -> std::function<Tuple(size_t)>
         values.push_back(ValueFactory::GetNullValueByType(TypeId::INTEGER));
       }
       values.push_back(ValueFactory::GetVarcharValue(fmt::format("{}-\U0001F4A9", cursor)));  // the poop emoji
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_table_tas_2022") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetVarcharValue(ta_list_2022[cursor]));
       values.push_back(ValueFactory::GetVarcharValue(ta_oh_2022[cursor]));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_table_tas_2023") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetVarcharValue(ta_list_2023[cursor]));
       values.push_back(ValueFactory::GetVarcharValue(ta_oh_2023[cursor]));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_table_schedule_2022") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetVarcharValue(course_on_date[cursor]));
       values.push_back(ValueFactory::GetIntegerValue(cursor == 1 || cursor == 3 ? 1 : 0));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_table_schedule_2023") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetVarcharValue(course_on_date[cursor]));
       values.push_back(ValueFactory::GetIntegerValue(cursor == 0 || cursor == 2 ? 1 : 0));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_agg_input_small") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetIntegerValue((cursor + 2) % 10));
       values.push_back(ValueFactory::GetIntegerValue(cursor));
@@ -284,12 +284,12 @@ auto GetFunctionOf(const MockScanPlanNode *plan) -> std::function<Tuple(size_t)>
       values.push_back(ValueFactory::GetIntegerValue(233));
       values.push_back(
           ValueFactory::GetVarcharValue(StringUtil::Repeat("\U0001F4A9", (cursor % 8) + 1)));  // the poop emoji
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_agg_input_big") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetIntegerValue((cursor + 2) % 10));
       values.push_back(ValueFactory::GetIntegerValue(cursor));
@@ -298,20 +298,20 @@ auto GetFunctionOf(const MockScanPlanNode *plan) -> std::function<Tuple(size_t)>
       values.push_back(ValueFactory::GetIntegerValue(233));
       values.push_back(
           ValueFactory::GetVarcharValue(StringUtil::Repeat("\U0001F4A9", (cursor % 16) + 1)));  // the poop emoji
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_table_123") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetIntegerValue(cursor + 1));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_graph") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       int src = cursor % GRAPH_NODE_CNT;
       int dst = cursor / GRAPH_NODE_CNT;
@@ -324,82 +324,88 @@ auto GetFunctionOf(const MockScanPlanNode *plan) -> std::function<Tuple(size_t)>
       } else {
         values.push_back(ValueFactory::GetIntegerValue(1));
       }
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_t1") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetIntegerValue(cursor / 10000));
       values.push_back(ValueFactory::GetIntegerValue(cursor % 10000));
       values.push_back(ValueFactory::GetIntegerValue(cursor));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_t4_1m") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       cursor = cursor % 500000;
       values.push_back(ValueFactory::GetIntegerValue(cursor));
       values.push_back(ValueFactory::GetIntegerValue(cursor * 10));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_t5_1m") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       cursor = (cursor + 30000) % 500000;
       values.push_back(ValueFactory::GetIntegerValue(cursor));
       values.push_back(ValueFactory::GetIntegerValue(cursor * 10));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_t6_1m") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       cursor = (cursor + 60000) % 500000;
       values.push_back(ValueFactory::GetIntegerValue(cursor));
       values.push_back(ValueFactory::GetIntegerValue(cursor * 10));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_t7") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetIntegerValue(cursor % 20));
       values.push_back(ValueFactory::GetIntegerValue(cursor));
       values.push_back(ValueFactory::GetIntegerValue(cursor));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   if (table == "__mock_t8") {
-    return [plan](size_t cursor) {
+    return [schema](size_t cursor) {
       std::vector<Value> values{};
       values.push_back(ValueFactory::GetIntegerValue(cursor));
-      return Tuple{values, &plan->OutputSchema()};
+      return Tuple{values, schema};
     };
   }
 
   // By default, return table of all 0.
-  return [plan](size_t cursor) {
+  return [schema](size_t cursor) {
     std::vector<Value> values{};
-    values.reserve(plan->OutputSchema().GetColumnCount());
-    for (const auto &column : plan->OutputSchema().GetColumns()) {
+    values.reserve(schema->GetColumnCount());
+    for (const auto &column : schema->GetColumns()) {
       values.push_back(ValueFactory::GetZeroValueByType(column.GetType()));
     }
-    return Tuple{values, &plan->OutputSchema()};
+    return Tuple{values, schema};
   };
 }
 
 MockScanExecutor::MockScanExecutor(ExecutorContext *exec_ctx, const MockScanPlanNode *plan)
-    : AbstractExecutor{exec_ctx}, plan_{plan}, func_(GetFunctionOf(plan)), size_(GetSizeOf(plan)) {
-  if (GetShuffled(plan)) {
+    : AbstractExecutor{exec_ctx},
+      plan_{plan},
+      table_schema_(plan->column_ids_.empty() ? plan->OutputSchema() : GetMockTableSchemaOf(plan->GetTable())),
+      func_(GetFunctionOf(plan, &table_schema_)),
+      size_(GetSizeOf(plan)),
+      runtime_filters_(exec_ctx, plan->runtime_filters_, plan->OutputSchema()) {
+  // Workers of a parallel plan split the rows between them, which already gives an arbitrary output order.
+  if (GetShuffled(plan) && exec_ctx->GetParallelContext() == nullptr) {
     for (size_t i = 0; i < size_; i++) {
       shuffled_idx_.push_back(i);
     }
@@ -412,19 +418,31 @@ MockScanExecutor::MockScanExecutor(ExecutorContext *exec_ctx, const MockScanPlan
 void MockScanExecutor::Init() {
   // Reset the cursor
   cursor_ = 0;
+  end_ = size_;
+  auto *parallel_ctx = exec_ctx_->GetParallelContext();
+  if (parallel_ctx != nullptr) {
+    // Running as one of several workers: start with an empty morsel and claim rows as we go
+    morsels_ = parallel_ctx->GetRowMorselQueue(plan_, size_);
+    end_ = 0;
+  }
 }
 
 auto MockScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (cursor_ == size_) {
-    // Scan complete
-    return EXECUTOR_EXHAUSTED;
-  }
-  if (shuffled_idx_.empty()) {
-    *tuple = func_(cursor_);
-  } else {
-    *tuple = func_(shuffled_idx_[cursor_]);
-  }
-  ++cursor_;
+  do {
+    if (cursor_ == end_ && (morsels_ == nullptr || !morsels_->Next(&cursor_, &end_))) {
+      // Scan complete
+      return EXECUTOR_EXHAUSTED;
+    }
+    if (shuffled_idx_.empty()) {
+      *tuple = func_(cursor_);
+    } else {
+      *tuple = func_(shuffled_idx_[cursor_]);
+    }
+    ++cursor_;
+    if (!plan_->column_ids_.empty()) {
+      *tuple = tuple->KeyFromTuple(table_schema_, GetOutputSchema(), plan_->column_ids_);
+    }
+  } while (!runtime_filters_.Selects(*tuple));
   *rid = MakeDummyRID();
   return EXECUTOR_ACTIVE;
 }
@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_context.cpp
+//
+// Identification: src/execution/parallel_context.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/parallel_context.h"
+
+#include <iterator>
+
+#include "storage/page/table_page.h"
+
+namespace bustub {
+
+PageMorselQueue::PageMorselQueue(TableHeap *table_heap, BufferPoolManager *bpm)
+    : table_heap_(table_heap), bpm_(bpm), next_page_id_(table_heap->GetFirstPageId()) {
+  last_page_id_ = table_heap_->GetLastPageId();
+  auto page_guard = bpm_->FetchPageRead(last_page_id_);
+  last_page_tuples_ = page_guard.As<TablePage>()->GetNumTuples();
+}
+
+auto PageMorselQueue::Next() -> std::optional<TableIterator> {
+  std::scoped_lock guard(latch_);
+  while (next_page_id_ != INVALID_PAGE_ID) {
+    auto page_id = next_page_id_;
+    auto page_guard = bpm_->FetchPageRead(page_id);
+    const auto *page = page_guard.As<TablePage>();
+    auto num_tuples = page_id == last_page_id_ ? last_page_tuples_ : page->GetNumTuples();
+    next_page_id_ = page_id == last_page_id_ ? INVALID_PAGE_ID : page->GetNextPageId();
+    page_guard.Drop();
+    if (num_tuples > 0) {
+      return std::make_optional<TableIterator>(table_heap_, RID{page_id, 0}, RID{page_id, num_tuples});
+    }
+  }
+  return std::nullopt;
+}
+
+void RepartitionState::Produce(std::vector<std::vector<Tuple>> &&partitions) {
+  std::scoped_lock guard(latch_);
+  for (size_t i = 0; i < partitions.size(); i++) {
+    std::move(partitions[i].begin(), partitions[i].end(), std::back_inserter(partitions_[i]));
+  }
+  producers_done_++;
+  cv_.notify_all();
+}
+
+auto RepartitionState::Consume(size_t partition, std::vector<Tuple> *tuples) -> bool {
+  std::unique_lock guard(latch_);
+  cv_.wait(guard, [&] { return aborted_ || producers_done_ == partitions_.size(); });
+  if (aborted_) {
+    return false;
+  }
+  *tuples = std::move(partitions_[partition]);
+  return true;
+}
+
+void RepartitionState::Abort() {
+  std::scoped_lock guard(latch_);
+  aborted_ = true;
+  cv_.notify_all();
+}
+
+auto ParallelContext::GetRowMorselQueue(const AbstractPlanNode *plan, size_t size) -> RowMorselQueue * {
+  std::scoped_lock guard(latch_);
+  auto &queue = row_morsel_queues_[plan];
+  if (queue == nullptr) {
+    queue = std::make_unique<RowMorselQueue>(size);
+  }
+  return queue.get();
+}
+
+auto ParallelContext::GetPageMorselQueue(const AbstractPlanNode *plan, TableHeap *table_heap,
+                                         BufferPoolManager *bpm) -> PageMorselQueue * {
+  std::scoped_lock guard(latch_);
+  auto &queue = page_morsel_queues_[plan];
+  if (queue == nullptr) {
+    queue = std::make_unique<PageMorselQueue>(table_heap, bpm);
+  }
+  return queue.get();
+}
+
+auto ParallelContext::GetRepartitionState(const AbstractPlanNode *plan) -> RepartitionState * {
+  std::scoped_lock guard(latch_);
+  auto &state = repartition_states_[plan];
+  if (state == nullptr) {
+    state = std::make_unique<RepartitionState>(parallelism_);
+    if (aborted_) {
+      state->Abort();
+    }
+  }
+  return state.get();
+}
+
+void ParallelContext::Abort() {
+  std::scoped_lock guard(latch_);
+  aborted_ = true;
+  for (auto &[plan, state] : repartition_states_) {
+    state->Abort();
+  }
+}
+
+}  // namespace bustub
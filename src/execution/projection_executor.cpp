@@ -1,4 +1,5 @@
 #include "execution/executors/projection_executor.h"
+#include "execution/expressions/column_value_expression.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -10,6 +11,17 @@ ProjectionExecutor::ProjectionExecutor(ExecutorContext *exec_ctx, const Projecti
 void ProjectionExecutor::Init() {
   // Initialize the child executor
   child_executor_->Init();
+
+  // Column references are cheaper to copy out of the tuple than to run through the compiler
+  compiled_exprs_.clear();
+  for (const auto &expr : plan_->GetExpressions()) {
+    if (dynamic_cast<const ColumnValueExpression *>(expr.get()) != nullptr) {
+      compiled_exprs_.emplace_back(nullptr);
+    } else {
+      compiled_exprs_.emplace_back(CompiledExpression::Compile(expr, child_executor_->GetOutputSchema()));
+    }
+  }
+  compiled_values_.resize(compiled_exprs_.size());
 }
 
 auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
@@ -25,12 +37,48 @@ auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   // Compute expressions
   std::vector<Value> values{};
   values.reserve(GetOutputSchema().GetColumnCount());
-  for (const auto &expr : plan_->GetExpressions()) {
-    values.push_back(expr->Evaluate(&child_tuple, child_executor_->GetOutputSchema()));
+  const auto &exprs = plan_->GetExpressions();
+  for (size_t i = 0; i < exprs.size(); i++) {
+    if (compiled_exprs_[i] != nullptr) {
+      values.push_back(compiled_exprs_[i]->Evaluate(&child_tuple));
+    } else {
+      values.push_back(exprs[i]->Evaluate(&child_tuple, child_executor_->GetOutputSchema()));
+    }
   }
 
   *tuple = Tuple{values, &GetOutputSchema()};
 
   return true;
 }
+
+auto ProjectionExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  if (!child_executor_->NextBatch(&child_tuples_, rids, batch_size)) {
+    return false;
+  }
+
+  const auto &child_schema = child_executor_->GetOutputSchema();
+  const auto &exprs = plan_->GetExpressions();
+  for (size_t i = 0; i < exprs.size(); i++) {
+    if (compiled_exprs_[i] != nullptr) {
+      compiled_exprs_[i]->EvaluateBatch(child_tuples_, &compiled_values_[i]);
+    }
+  }
+
+  tuples->reserve(child_tuples_.size());
+  std::vector<Value> values{};
+  values.reserve(exprs.size());
+  for (size_t row = 0; row < child_tuples_.size(); row++) {
+    values.clear();
+    for (size_t i = 0; i < exprs.size(); i++) {
+      if (compiled_exprs_[i] != nullptr) {
+        values.push_back(compiled_values_[i][row]);
+      } else {
+        values.push_back(exprs[i]->Evaluate(&child_tuples_[row], child_schema));
+      }
+    }
+    tuples->emplace_back(values, &GetOutputSchema());
+  }
+  return true;
+}
 }  // namespace bustub
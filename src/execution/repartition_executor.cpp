@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// repartition_executor.cpp
+//
+// Identification: src/execution/repartition_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/repartition_executor.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "common/exception.h"
+#include "common/util/hash_util.h"
+
+namespace bustub {
+
+RepartitionExecutor::RepartitionExecutor(ExecutorContext *exec_ctx, const RepartitionPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void RepartitionExecutor::Init() {
+  auto *parallel_ctx = exec_ctx_->GetParallelContext();
+  BUSTUB_ASSERT(parallel_ctx != nullptr, "repartition must run below a gather");
+  auto num_partitions = parallel_ctx->GetParallelism();
+
+  child_executor_->Init();
+  std::vector<std::vector<Tuple>> partitions(num_partitions);
+  std::vector<Tuple> tuples;
+  std::vector<RID> rids;
+  while (child_executor_->NextBatch(&tuples, &rids, BUSTUB_BATCH_SIZE)) {
+    for (auto &tuple : tuples) {
+      auto partition = PartitionOf(tuple, num_partitions);
+      partitions[partition].push_back(std::move(tuple));
+    }
+  }
+
+  auto *state = parallel_ctx->GetRepartitionState(plan_);
+  state->Produce(std::move(partitions));
+  tuples_.clear();
+  if (!state->Consume(exec_ctx_->GetWorkerId(), &tuples_)) {
+    throw ExecutionException("parallel query aborted during repartition");
+  }
+  cursor_ = 0;
+}
+
+auto RepartitionExecutor::PartitionOf(const Tuple &tuple, size_t num_partitions) const -> size_t {
+  hash_t hash = 0;
+  for (const auto &expr : plan_->GetPartitionBys()) {
+    auto value = expr->Evaluate(&tuple, child_executor_->GetOutputSchema());
+    // NULLs all land in the same partition, so that they still form a single group
+    if (!value.IsNull()) {
+      hash = HashUtil::CombineHashes(hash, HashUtil::HashValue(&value));
+    }
+  }
+  return hash % num_partitions;
+}
+
+auto RepartitionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (cursor_ == tuples_.size()) {
+    return false;
+  }
+  *tuple = std::move(tuples_[cursor_++]);
+  *rid = tuple->GetRid();
+  return true;
+}
+
+auto RepartitionExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  rids->clear();
+  auto end = std::min(tuples_.size(), cursor_ + batch_size);
+  for (; cursor_ < end; cursor_++) {
+    rids->push_back(tuples_[cursor_].GetRid());
+    tuples->push_back(std::move(tuples_[cursor_]));
+  }
+  return !tuples->empty();
+}
+
+}  // namespace bustub
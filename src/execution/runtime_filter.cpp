@@ -0,0 +1,170 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter.cpp
+//
+// Identification: src/execution/runtime_filter.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/runtime_filter.h"
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+#include "execution/executor_context.h"
+
+namespace bustub {
+
+/** The number of Bloom filter bits per build key, which keeps false positives around 1% with three probes */
+static constexpr size_t BLOOM_BITS_PER_KEY = 10;
+/** The number of bits a key hash sets in the Bloom filter */
+static constexpr size_t BLOOM_PROBES = 3;
+/** The number of probe rows after which a filter that dropped too few of them is no longer checked */
+static constexpr size_t ADAPTIVE_SAMPLE_ROWS = 8192;
+/** A filter must drop at least one row in this many over the sample to stay enabled */
+static constexpr size_t MIN_DROP_RATIO = 16;
+
+auto RuntimeFilter::HashKeys(const std::vector<Value> &keys) -> hash_t {
+  hash_t hash = 0;
+  for (const auto &key : keys) {
+    hash_t key_hash;
+    switch (key.GetTypeId()) {
+      case TypeId::TINYINT:
+      case TypeId::SMALLINT:
+      case TypeId::INTEGER:
+      case TypeId::BIGINT:
+        key_hash = static_cast<hash_t>(key.CastAs(TypeId::BIGINT).GetAs<int64_t>());
+        break;
+      case TypeId::VARCHAR:
+        key_hash = std::hash<std::string_view>{}(std::string_view(key.GetData(), key.GetLength()));
+        break;
+      default:
+        key_hash = HashUtil::HashValue(&key);
+        break;
+    }
+    hash = HashUtil::MixHash(hash + key_hash);
+  }
+  return hash;
+}
+
+void RuntimeFilter::Insert(const std::vector<Value> &keys) {
+  hashes_.push_back(HashKeys(keys));
+  if (min_.empty()) {
+    min_ = keys;
+    max_ = keys;
+    return;
+  }
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (keys[i].CompareLessThan(min_[i]) == CmpBool::CmpTrue) {
+      min_[i] = keys[i];
+    } else if (keys[i].CompareGreaterThan(max_[i]) == CmpBool::CmpTrue) {
+      max_[i] = keys[i];
+    }
+  }
+}
+
+void RuntimeFilter::Finish() {
+  bits_.clear();
+  if (hashes_.empty()) {
+    return;
+  }
+  size_t num_bits = 64;
+  while (num_bits < hashes_.size() * BLOOM_BITS_PER_KEY) {
+    num_bits <<= 1;
+  }
+  bits_.assign(num_bits / 64, 0);
+  const auto mask = num_bits - 1;
+  for (auto hash : hashes_) {
+    // Derive the probes from the two halves of the hash (Kirsch and Mitzenmacher), the second one odd
+    auto step = (hash >> 32) | 1;
+    for (size_t i = 0; i < BLOOM_PROBES; i++) {
+      auto bit = (hash + i * step) & mask;
+      bits_[bit / 64] |= 1UL << (bit % 64);
+    }
+  }
+  hashes_.clear();
+  hashes_.shrink_to_fit();
+}
+
+auto RuntimeFilter::BloomContains(hash_t hash) const -> bool {
+  const auto mask = bits_.size() * 64 - 1;
+  auto step = (hash >> 32) | 1;
+  for (size_t i = 0; i < BLOOM_PROBES; i++) {
+    auto bit = (hash + i * step) & mask;
+    if ((bits_[bit / 64] & (1UL << (bit % 64))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto RuntimeFilter::MayContain(const std::vector<Value> &keys) -> bool {
+  if (!enabled_) {
+    return true;
+  }
+  rows_checked_++;
+  bool may_contain = !bits_.empty();
+  for (size_t i = 0; may_contain && i < keys.size(); i++) {
+    // A NULL key never matches, and neither does a key outside the bounds of the build keys
+    may_contain = !keys[i].IsNull() && keys[i].CompareLessThan(min_[i]) != CmpBool::CmpTrue &&
+                  keys[i].CompareGreaterThan(max_[i]) != CmpBool::CmpTrue;
+  }
+  may_contain = may_contain && BloomContains(HashKeys(keys));
+  if (!may_contain) {
+    rows_dropped_++;
+  }
+  if (rows_checked_ == ADAPTIVE_SAMPLE_ROWS && rows_dropped_ * MIN_DROP_RATIO < rows_checked_) {
+    enabled_ = false;
+  }
+  return may_contain;
+}
+
+auto ScanRuntimeFilters::Selects(const Tuple &tuple) -> bool {
+  for (const auto &probe : probes_) {
+    auto *filter = exec_ctx_->GetRuntimeFilter(probe.filter_id_);
+    if (filter == nullptr) {
+      continue;
+    }
+    keys_.clear();
+    for (const auto &expr : probe.key_expressions_) {
+      keys_.push_back(expr->Evaluate(&tuple, schema_));
+    }
+    if (!filter->MayContain(keys_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ScanRuntimeFilters::FilterBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids) {
+  for (const auto &probe : probes_) {
+    auto *filter = exec_ctx_->GetRuntimeFilter(probe.filter_id_);
+    if (filter == nullptr) {
+      continue;
+    }
+    size_t selected = 0;
+    for (size_t i = 0; i < tuples->size(); i++) {
+      keys_.clear();
+      for (const auto &expr : probe.key_expressions_) {
+        keys_.push_back(expr->Evaluate(&(*tuples)[i], schema_));
+      }
+      if (!filter->MayContain(keys_)) {
+        continue;
+      }
+      if (selected != i) {
+        (*tuples)[selected] = std::move((*tuples)[i]);
+        (*rids)[selected] = (*rids)[i];
+      }
+      selected++;
+    }
+    tuples->resize(selected);
+    rids->resize(selected);
+  }
+}
+
+}  // namespace bustub
@@ -14,10 +14,128 @@
 
 namespace bustub {
 
-SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan) : AbstractExecutor(exec_ctx) {}
+SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      runtime_filters_(exec_ctx, plan->runtime_filters_, plan->OutputSchema()) {}
 
-void SeqScanExecutor::Init() { throw NotImplementedException("SeqScanExecutor is not implemented"); }
+void SeqScanExecutor::Init() {
+  auto *table_info = exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid());
+  table_heap_ = table_info->table_.get();
+  table_schema_ = &table_info->schema_;
+  auto *parallel_ctx = exec_ctx_->GetParallelContext();
+  if (parallel_ctx != nullptr) {
+    // Running as one of several workers: the pages of the table are split between the copies of this scan.
+    morsels_ = parallel_ctx->GetPageMorselQueue(plan_, table_heap_, exec_ctx_->GetBufferPoolManager());
+    iter_ = nullptr;
+  } else {
+    morsels_ = nullptr;
+    iter_ = std::make_unique<TableIterator>(table_heap_->MakeIterator());
+  }
+  if (plan_->filter_predicate_ != nullptr) {
+    compiled_predicate_ = CompiledExpression::Compile(plan_->filter_predicate_, *table_schema_);
+  }
+}
 
-auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto SeqScanExecutor::HasNext() -> bool {
+  while (iter_ == nullptr || iter_->IsEnd()) {
+    if (morsels_ == nullptr) {
+      return false;
+    }
+    auto morsel = morsels_->Next();
+    if (!morsel.has_value()) {
+      return false;
+    }
+    iter_ = std::make_unique<TableIterator>(std::move(*morsel));
+  }
+  return true;
+}
+
+auto SeqScanExecutor::IsTupleSelected(const TupleMeta &meta, const Tuple &tuple) const -> bool {
+  if (meta.is_deleted_) {
+    return false;
+  }
+  if (compiled_predicate_ != nullptr) {
+    auto value = compiled_predicate_->Evaluate(&tuple);
+    return !value.IsNull() && value.GetAs<bool>();
+  }
+  if (plan_->filter_predicate_ != nullptr) {
+    auto value = plan_->filter_predicate_->Evaluate(&tuple, *table_schema_);
+    return !value.IsNull() && value.GetAs<bool>();
+  }
+  return true;
+}
+
+void SeqScanExecutor::Project(Tuple *tuple) const {
+  if (!plan_->column_ids_.empty()) {
+    *tuple = tuple->KeyFromTuple(*table_schema_, GetOutputSchema(), plan_->column_ids_);
+  }
+}
+
+auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (HasNext()) {
+    auto [meta, current] = iter_->GetTuple();
+    auto current_rid = iter_->GetRID();
+    ++(*iter_);
+    if (!IsTupleSelected(meta, current)) {
+      continue;
+    }
+    Project(&current);
+    if (runtime_filters_.Selects(current)) {
+      *tuple = std::move(current);
+      *rid = current_rid;
+      return true;
+    }
+  }
+  return false;
+}
+
+auto SeqScanExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  tuples->clear();
+  rids->clear();
+  // The predicate and the runtime filters may drop a whole batch, so keep going until some tuple is left.
+  while (tuples->empty() && HasNext()) {
+    if (compiled_predicate_ == nullptr) {
+      while (tuples->size() < batch_size && HasNext()) {
+        auto [meta, current] = iter_->GetTuple();
+        auto current_rid = iter_->GetRID();
+        ++(*iter_);
+        if (IsTupleSelected(meta, current)) {
+          tuples->push_back(std::move(current));
+          rids->push_back(current_rid);
+        }
+      }
+    } else {
+      // Gather a batch of live tuples, then run the compiled predicate over all of them at once.
+      while (tuples->size() < batch_size && HasNext()) {
+        auto [meta, current] = iter_->GetTuple();
+        auto current_rid = iter_->GetRID();
+        ++(*iter_);
+        if (!meta.is_deleted_) {
+          tuples->push_back(std::move(current));
+          rids->push_back(current_rid);
+        }
+      }
+      compiled_predicate_->SelectBatch(*tuples, &selection_);
+      size_t selected = 0;
+      for (size_t i = 0; i < tuples->size(); i++) {
+        if (selection_[i] != 0) {
+          if (selected != i) {
+            (*tuples)[selected] = std::move((*tuples)[i]);
+            (*rids)[selected] = (*rids)[i];
+          }
+          selected++;
+        }
+      }
+      tuples->resize(selected);
+      rids->resize(selected);
+    }
+    for (auto &current : *tuples) {
+      Project(&current);
+    }
+    runtime_filters_.FilterBatch(tuples, rids);
+  }
+  return !tuples->empty();
+}
 
 }  // namespace bustub
@@ -1,13 +1,198 @@
 #include "execution/executors/sort_executor.h"
 
+#include <algorithm>
+#include <thread>  // NOLINT
+#include <utility>
+
 namespace bustub {
 
+/** The largest number of runs merged at once, which bounds the tuples the merge buffers */
+static constexpr size_t MAX_MERGE_FAN_IN = 64;
+/** The number of tuples the merge reads from a run at a time */
+static constexpr size_t RUN_READ_BATCH_SIZE = 128;
+
+/** @return an estimate of the memory a buffered tuple holds until it is sorted and emitted or spilled */
+static auto EntryMemory(const SortKey &key, const Tuple &tuple) -> size_t {
+  return sizeof(Tuple) + tuple.GetLength() + sizeof(SortKey) + key.size() + sizeof(RID) + sizeof(uint32_t);
+}
+
+RunMerger::RunMerger(const std::vector<TmpTupleFile *> &runs, SortKeyEncoder *encoder) : encoder_(encoder) {
+  for (auto *run : runs) {
+    run->Rewind();
+    cursors_.push_back(RunCursor{run, {}, {}, 0, false});
+  }
+  // Start from a tree full of minus infinities, which every run pushes one step further up until they are all gone
+  tree_.assign(Size(), Size());
+  for (size_t run = Size(); run > 0; run--) {
+    Refill(run - 1);
+    Replay(run - 1);
+  }
+}
+
+void RunMerger::Refill(size_t run) {
+  auto &cursor = cursors_[run];
+  cursor.pos_ = 0;
+  if (!cursor.run_->ReadBatch(&cursor.tuples_, RUN_READ_BATCH_SIZE)) {
+    cursor.exhausted_ = true;
+    cursor.tuples_.clear();
+    cursor.keys_.clear();
+    return;
+  }
+  encoder_->EncodeBatch(cursor.tuples_, &cursor.keys_);
+}
+
+auto RunMerger::Less(size_t a, size_t b) const -> bool {
+  if (a == Size() || b == Size()) {
+    return a == Size() && b != Size();
+  }
+  const auto &cursor_a = cursors_[a];
+  const auto &cursor_b = cursors_[b];
+  if (cursor_a.exhausted_ || cursor_b.exhausted_) {
+    return !cursor_a.exhausted_;
+  }
+  auto cmp = cursor_a.keys_[cursor_a.pos_].compare(cursor_b.keys_[cursor_b.pos_]);
+  return cmp != 0 ? cmp < 0 : a < b;
+}
+
+void RunMerger::Replay(size_t run) {
+  // The leaf of run i is node k + i, so that every inner node has two children
+  auto winner = run;
+  for (auto node = (run + Size()) / 2; node > 0; node /= 2) {
+    if (Less(tree_[node], winner)) {
+      std::swap(tree_[node], winner);
+    }
+  }
+  tree_[0] = winner;
+}
+
+auto RunMerger::Next(Tuple *tuple) -> bool {
+  if (cursors_.empty()) {
+    return false;
+  }
+  auto winner = tree_[0];
+  auto &cursor = cursors_[winner];
+  if (cursor.exhausted_) {
+    return false;
+  }
+  *tuple = std::move(cursor.tuples_[cursor.pos_]);
+  cursor.pos_++;
+  if (cursor.pos_ == cursor.tuples_.size()) {
+    Refill(winner);
+  }
+  Replay(winner);
+  return true;
+}
+
 SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void SortExecutor::Init() {
+  child_executor_->Init();
+  encoder_ = std::make_unique<SortKeyEncoder>(plan_->GetOrderBy(), child_executor_->GetOutputSchema());
+  tuples_.clear();
+  rids_.clear();
+  keys_.clear();
+  order_.clear();
+  cursor_ = 0;
+  merger_.reset();
+  runs_.clear();
+
+  const auto memory_budget = exec_ctx_->GetMemoryBudget();
+  // Without a buffer pool, the whole input is sorted in memory whatever its size
+  const bool can_spill = exec_ctx_->GetBufferPoolManager() != nullptr;
+  size_t memory = 0;
+  std::vector<Tuple> tuples;
+  std::vector<RID> rids;
+  std::vector<SortKey> keys;
+  while (child_executor_->NextBatch(&tuples, &rids, BUSTUB_BATCH_SIZE)) {
+    encoder_->EncodeBatch(tuples, &keys);
+    for (size_t i = 0; i < tuples.size(); i++) {
+      memory += EntryMemory(keys[i], tuples[i]);
+      tuples_.push_back(std::move(tuples[i]));
+      rids_.push_back(rids[i]);
+      keys_.push_back(std::move(keys[i]));
+    }
+    if (can_spill && memory > memory_budget) {
+      SpillRun();
+      memory = 0;
+    }
+  }
+
+  if (runs_.empty()) {
+    SortBuffered();
+    return;
+  }
+  if (!tuples_.empty()) {
+    SpillRun();
+  }
+  // Merge the oldest runs together until the remaining ones can be merged at once
+  while (runs_.size() > MAX_MERGE_FAN_IN) {
+    std::vector<TmpTupleFile *> inputs;
+    for (size_t i = 0; i < MAX_MERGE_FAN_IN; i++) {
+      inputs.push_back(runs_[i].get());
+    }
+    auto merged = MergeRuns(inputs);
+    runs_.erase(runs_.begin(), runs_.begin() + MAX_MERGE_FAN_IN);
+    runs_.push_back(std::move(merged));
+  }
+  std::vector<TmpTupleFile *> inputs;
+  for (const auto &run : runs_) {
+    inputs.push_back(run.get());
+  }
+  merger_ = std::make_unique<RunMerger>(inputs, encoder_.get());
+}
+
+void SortExecutor::SortBuffered() {
+  // Large inputs are sorted on as many threads as there are cores. Workers of a parallel plan each sort their own
+  // input already, so they stay on their thread.
+  size_t num_threads = 1;
+  if (exec_ctx_->GetParallelContext() == nullptr) {
+    num_threads = std::min<size_t>(keys_.size() / BUSTUB_SORT_CHUNK_SIZE + 1,
+                                   std::max(std::thread::hardware_concurrency(), 1U));
+  }
+  encoder_->Sort(keys_, &order_, num_threads);
+  cursor_ = 0;
+}
+
+void SortExecutor::SpillRun() {
+  SortBuffered();
+  auto run = std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager());
+  for (auto idx : order_) {
+    run->Append(tuples_[idx]);
+  }
+  runs_.push_back(std::move(run));
+  tuples_.clear();
+  rids_.clear();
+  keys_.clear();
+  order_.clear();
+}
 
-void SortExecutor::Init() { throw NotImplementedException("SortExecutor is not implemented"); }
+auto SortExecutor::MergeRuns(const std::vector<TmpTupleFile *> &runs) -> std::unique_ptr<TmpTupleFile> {
+  RunMerger merger(runs, encoder_.get());
+  auto merged = std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager());
+  Tuple tuple{};
+  while (merger.Next(&tuple)) {
+    merged->Append(tuple);
+  }
+  return merged;
+}
 
-auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (merger_ != nullptr) {
+    if (!merger_->Next(tuple)) {
+      return false;
+    }
+    *rid = tuple->GetRid();
+    return true;
+  }
+  if (cursor_ >= order_.size()) {
+    return false;
+  }
+  auto idx = order_[cursor_++];
+  *tuple = std::move(tuples_[idx]);
+  *rid = rids_[idx];
+  return true;
+}
 
 }  // namespace bustub
@@ -0,0 +1,339 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.cpp
+//
+// Identification: src/execution/sort_key.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/sort_key.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <thread>  // NOLINT
+#include <utility>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+/** The null marker bytes, before DESC inversion */
+static constexpr char NULL_MARKER = 0x00;
+static constexpr char NOT_NULL_MARKER = 0x01;
+
+/** Append the `bytes` low bytes of `bits` to a key, most significant byte first. */
+static void AppendBigEndian(uint64_t bits, size_t bytes, SortKey *key) {
+  for (size_t i = bytes; i > 0; i--) {
+    key->push_back(static_cast<char>((bits >> ((i - 1) * 8)) & 0xFF));
+  }
+}
+
+/** Append a signed integer of `bytes` bytes to a key, with its sign bit flipped so that negatives sort first. */
+static void AppendSigned(int64_t val, size_t bytes, SortKey *key) {
+  auto sign_bit = 1ULL << (bytes * 8 - 1);
+  AppendBigEndian(static_cast<uint64_t>(val) ^ sign_bit, bytes, key);
+}
+
+/** @return the width of the encoded non-NULL values of an integer type, 0 for the other types */
+static auto IntegerWidth(TypeId type) -> size_t {
+  switch (type) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      return sizeof(int8_t);
+    case TypeId::SMALLINT:
+      return sizeof(int16_t);
+    case TypeId::INTEGER:
+      return sizeof(int32_t);
+    case TypeId::BIGINT:
+    case TypeId::TIMESTAMP:
+      return sizeof(int64_t);
+    default:
+      return 0;
+  }
+}
+
+/** Sort fixed-length keys with an LSD radix sort on their bytes, from the last one to the first one. */
+static void RadixSort(const std::vector<SortKey> &keys, size_t key_size, uint32_t *begin, uint32_t *end) {
+  const auto count = static_cast<size_t>(end - begin);
+  std::vector<uint32_t> scratch(count);
+  auto *from = begin;
+  auto *to = scratch.data();
+  std::array<size_t, 256> offsets;
+  for (size_t byte = key_size; byte > 0; byte--) {
+    offsets.fill(0);
+    for (auto *idx = from; idx != from + count; idx++) {
+      offsets[static_cast<uint8_t>(keys[*idx][byte - 1])]++;
+    }
+    // A byte that is the same in every key does not reorder anything, such as the null marker of a non-NULL column
+    if (std::find(offsets.begin(), offsets.end(), count) != offsets.end()) {
+      continue;
+    }
+    size_t offset = 0;
+    for (auto &bucket : offsets) {
+      offset += std::exchange(bucket, offset);
+    }
+    for (auto *idx = from; idx != from + count; idx++) {
+      to[offsets[static_cast<uint8_t>(keys[*idx][byte - 1])]++] = *idx;
+    }
+    std::swap(from, to);
+  }
+  if (from != begin) {
+    std::copy(from, from + count, begin);
+  }
+}
+
+/** @return the first 8 bytes of a key as a big-endian integer, padded with zeros */
+static auto KeyPrefix(const SortKey &key) -> uint64_t {
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < sizeof(prefix); i++) {
+    prefix = (prefix << 8) | (i < key.size() ? static_cast<uint8_t>(key[i]) : 0);
+  }
+  return prefix;
+}
+
+/** Sort keys of any length, comparing their prefixes first. Two different prefixes order their keys like memcmp. */
+static void PrefixSort(const std::vector<SortKey> &keys, uint32_t *begin, uint32_t *end) {
+  std::vector<std::pair<uint64_t, uint32_t>> entries;
+  entries.reserve(end - begin);
+  for (auto *idx = begin; idx != end; idx++) {
+    entries.emplace_back(KeyPrefix(keys[*idx]), *idx);
+  }
+  std::sort(entries.begin(), entries.end(), [&keys](const auto &a, const auto &b) {
+    if (a.first != b.first) {
+      return a.first < b.first;
+    }
+    auto cmp = keys[a.second].compare(keys[b.second]);
+    return cmp != 0 ? cmp < 0 : a.second < b.second;
+  });
+  for (const auto &entry : entries) {
+    *begin++ = entry.second;
+  }
+}
+
+/** @return whether key `a` sorts before key `b`, the key that comes first in `keys` winning ties */
+static auto KeyLess(const std::vector<SortKey> &keys, uint32_t a, uint32_t b) -> bool {
+  auto cmp = keys[a].compare(keys[b]);
+  return cmp != 0 ? cmp < 0 : a < b;
+}
+
+/**
+ * Find where the first `rank` keys of the merge of sorted runs end in each run, so that merging can start there.
+ * @param order the runs, one after the other
+ * @param bounds the start of each run in `order`, followed by the end of the last one
+ * @return the position in `order` of the first key of each run that is not among the first `rank` keys
+ */
+static auto SplitRuns(const std::vector<SortKey> &keys, const std::vector<uint32_t> &order,
+                      const std::vector<size_t> &bounds, size_t rank) -> std::vector<size_t> {
+  const auto num_runs = bounds.size() - 1;
+  auto less = [&keys](uint32_t a, uint32_t b) { return KeyLess(keys, a, b); };
+  // The positions of the keys smaller than `idx` in every run
+  auto split_at = [&](uint32_t idx) {
+    std::vector<size_t> split(num_runs);
+    for (size_t run = 0; run < num_runs; run++) {
+      split[run] = std::lower_bound(order.begin() + bounds[run], order.begin() + bounds[run + 1], idx, less) -
+                   order.begin();
+    }
+    return split;
+  };
+  auto rank_of = [&](uint32_t idx) {
+    auto split = split_at(idx);
+    size_t rank = 0;
+    for (size_t run = 0; run < num_runs; run++) {
+      rank += split[run] - bounds[run];
+    }
+    return rank;
+  };
+
+  // The key of rank `rank` is in one of the runs, where the ranks of the keys grow with their position
+  for (size_t run = 0; run < num_runs; run++) {
+    auto pos = std::partition_point(order.begin() + bounds[run], order.begin() + bounds[run + 1],
+                                    [&](uint32_t idx) { return rank_of(idx) < rank; });
+    if (pos != order.begin() + bounds[run + 1] && rank_of(*pos) == rank) {
+      return split_at(*pos);
+    }
+  }
+  // No key has this rank, because it is past the last one
+  return {bounds.begin() + 1, bounds.end()};
+}
+
+/** Merge the slices [from, to) of sorted runs into `out`. */
+static void MergeRuns(const std::vector<SortKey> &keys, const std::vector<uint32_t> &order, std::vector<size_t> from,
+                      const std::vector<size_t> &to, uint32_t *out) {
+  // A min-heap of the runs on their next key
+  std::vector<size_t> heap;
+  auto greater = [&](size_t a, size_t b) { return KeyLess(keys, order[from[b]], order[from[a]]); };
+  for (size_t run = 0; run < from.size(); run++) {
+    if (from[run] < to[run]) {
+      heap.push_back(run);
+    }
+  }
+  std::make_heap(heap.begin(), heap.end(), greater);
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), greater);
+    auto run = heap.back();
+    *out++ = order[from[run]++];
+    if (from[run] < to[run]) {
+      std::push_heap(heap.begin(), heap.end(), greater);
+    } else {
+      heap.pop_back();
+    }
+  }
+}
+
+SortKeyEncoder::SortKeyEncoder(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys,
+                               const Schema &schema)
+    : order_bys_(order_bys), schema_(schema) {
+  for (const auto &[order_by_type, expr] : order_bys_) {
+    compiled_.emplace_back(CompiledExpression::Compile(expr, schema_));
+  }
+  for (const auto &[order_by_type, expr] : order_bys_) {
+    auto width = IntegerWidth(expr->GetReturnType());
+    if (width == 0) {
+      fixed_key_size_ = 0;
+      break;
+    }
+    fixed_key_size_ += 1 + width;
+  }
+}
+
+void SortKeyEncoder::AppendValue(const Value &val, bool descending, SortKey *key) {
+  auto begin = key->size();
+  if (val.IsNull()) {
+    key->push_back(NULL_MARKER);
+    key->append(IntegerWidth(val.GetTypeId()), 0);
+  } else {
+    key->push_back(NOT_NULL_MARKER);
+    switch (val.GetTypeId()) {
+      case TypeId::BOOLEAN:
+        key->push_back(static_cast<char>(val.GetAs<int8_t>()));
+        break;
+      case TypeId::TINYINT:
+        AppendSigned(val.GetAs<int8_t>(), sizeof(int8_t), key);
+        break;
+      case TypeId::SMALLINT:
+        AppendSigned(val.GetAs<int16_t>(), sizeof(int16_t), key);
+        break;
+      case TypeId::INTEGER:
+        AppendSigned(val.GetAs<int32_t>(), sizeof(int32_t), key);
+        break;
+      case TypeId::BIGINT:
+        AppendSigned(val.GetAs<int64_t>(), sizeof(int64_t), key);
+        break;
+      case TypeId::TIMESTAMP:
+        AppendBigEndian(val.GetAs<uint64_t>(), sizeof(uint64_t), key);
+        break;
+      case TypeId::DECIMAL: {
+        // Adding zero turns -0.0 into 0.0, which must compare equal
+        auto d = val.GetAs<double>() + 0.0;
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        bits = (bits >> 63) != 0 ? ~bits : bits | (1ULL << 63);
+        AppendBigEndian(bits, sizeof(bits), key);
+        break;
+      }
+      case TypeId::VARCHAR: {
+        // Like VarlenType, compare the characters without the terminating zero
+        const auto *data = val.GetData();
+        auto len = val.GetLength() - 1;
+        for (uint32_t i = 0; i < len; i++) {
+          key->push_back(data[i]);
+          if (data[i] == 0) {
+            key->push_back(static_cast<char>(0xFF));
+          }
+        }
+        key->push_back(0);
+        key->push_back(0);
+        break;
+      }
+      default:
+        throw NotImplementedException("cannot sort on type " + Type::TypeIdToString(val.GetTypeId()));
+    }
+  }
+  if (descending) {
+    for (auto i = begin; i < key->size(); i++) {
+      (*key)[i] = static_cast<char>(~(*key)[i]);
+    }
+  }
+}
+
+auto SortKeyEncoder::Encode(const Tuple &tuple) const -> SortKey {
+  SortKey key;
+  for (const auto &[order_by_type, expr] : order_bys_) {
+    AppendValue(expr->Evaluate(&tuple, schema_), order_by_type == OrderByType::DESC, &key);
+  }
+  return key;
+}
+
+void SortKeyEncoder::SortRange(const std::vector<SortKey> &keys, uint32_t *begin, uint32_t *end) const {
+  // The return types of the ORDER BY expressions are trusted only as long as the keys agree with them
+  const bool fixed_size = fixed_key_size_ != 0 &&
+                          std::all_of(begin, end, [&](uint32_t idx) { return keys[idx].size() == fixed_key_size_; });
+  if (fixed_size) {
+    RadixSort(keys, fixed_key_size_, begin, end);
+  } else {
+    PrefixSort(keys, begin, end);
+  }
+}
+
+void SortKeyEncoder::Sort(const std::vector<SortKey> &keys, std::vector<uint32_t> *order, size_t num_threads) const {
+  order->resize(keys.size());
+  std::iota(order->begin(), order->end(), 0);
+  num_threads = std::max<size_t>(std::min(num_threads, keys.size()), 1);
+  if (num_threads == 1) {
+    SortRange(keys, order->data(), order->data() + order->size());
+    return;
+  }
+
+  // Run a task on each thread, the calling thread included
+  auto run_in_parallel = [num_threads](const std::function<void(size_t)> &task) {
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_threads; i++) {
+      threads.emplace_back(task, i);
+    }
+    task(0);
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  };
+
+  // Each thread sorts a chunk of the keys into a run, then merges the runs into one slice of the output. The slices
+  // are as large as the chunks, and where they start in each run is found with a binary search, like a merge path.
+  std::vector<size_t> bounds(num_threads + 1);
+  for (size_t i = 0; i <= num_threads; i++) {
+    bounds[i] = keys.size() * i / num_threads;
+  }
+  run_in_parallel([&](size_t i) { SortRange(keys, order->data() + bounds[i], order->data() + bounds[i + 1]); });
+  std::vector<uint32_t> merged(keys.size());
+  run_in_parallel([&](size_t i) {
+    MergeRuns(keys, *order, SplitRuns(keys, *order, bounds, bounds[i]), SplitRuns(keys, *order, bounds, bounds[i + 1]),
+              merged.data() + bounds[i]);
+  });
+  order->swap(merged);
+}
+
+void SortKeyEncoder::EncodeBatch(const std::vector<Tuple> &tuples, std::vector<SortKey> *keys) {
+  keys->assign(tuples.size(), SortKey{});
+  for (size_t col = 0; col < order_bys_.size(); col++) {
+    const auto &[order_by_type, expr] = order_bys_[col];
+    const bool descending = order_by_type == OrderByType::DESC;
+    if (compiled_[col] != nullptr) {
+      compiled_[col]->EvaluateBatch(tuples, &values_);
+      for (size_t i = 0; i < tuples.size(); i++) {
+        AppendValue(values_[i], descending, &(*keys)[i]);
+      }
+    } else {
+      for (size_t i = 0; i < tuples.size(); i++) {
+        AppendValue(expr->Evaluate(&tuples[i], schema_), descending, &(*keys)[i]);
+      }
+    }
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,152 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// stream_aggregation_executor.cpp
+//
+// Identification: src/execution/stream_aggregation_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/stream_aggregation_executor.h"
+
+#include "execution/sort_key.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+StreamAggregationExecutor::StreamAggregationExecutor(ExecutorContext *exec_ctx, const StreamAggregationPlanNode *plan,
+                                                     std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+void StreamAggregationExecutor::Init() {
+  child_->Init();
+  input_.clear();
+  input_rids_.clear();
+  cursor_ = 0;
+  child_done_ = false;
+  has_group_ = false;
+  emitted_ = false;
+}
+
+void StreamAggregationExecutor::StartGroup() {
+  has_group_ = true;
+  std::swap(group_key_, key_);
+  std::swap(group_values_, row_values_);
+  aggregates_.clear();
+  for (auto agg_type : plan_->GetAggregateTypes()) {
+    // COUNT(*) starts at zero, the others start at NULL
+    aggregates_.push_back(agg_type == AggregationType::CountStarAggregate
+                              ? ValueFactory::GetIntegerValue(0)
+                              : ValueFactory::GetNullValueByType(TypeId::INTEGER));
+  }
+}
+
+void StreamAggregationExecutor::Combine() {
+  const auto &tuple = input_[cursor_];
+  const auto &schema = child_->GetOutputSchema();
+  for (size_t i = 0; i < aggregates_.size(); i++) {
+    auto &acc = aggregates_[i];
+    if (plan_->GetAggregateTypes()[i] == AggregationType::CountStarAggregate) {
+      acc = acc.Add(ValueFactory::GetIntegerValue(1));
+      continue;
+    }
+    auto val = plan_->GetAggregateAt(i)->Evaluate(&tuple, schema);
+    if (val.IsNull()) {
+      continue;
+    }
+    switch (plan_->GetAggregateTypes()[i]) {
+      case AggregationType::CountAggregate:
+        acc = acc.IsNull() ? ValueFactory::GetIntegerValue(1) : acc.Add(ValueFactory::GetIntegerValue(1));
+        break;
+      case AggregationType::SumAggregate:
+        acc = acc.IsNull() ? val : acc.Add(val);
+        break;
+      case AggregationType::MinAggregate:
+        if (acc.IsNull() || val.CompareLessThan(acc) == CmpBool::CmpTrue) {
+          acc = val;
+        }
+        break;
+      case AggregationType::MaxAggregate:
+        if (acc.IsNull() || val.CompareGreaterThan(acc) == CmpBool::CmpTrue) {
+          acc = val;
+        }
+        break;
+      case AggregationType::CountStarAggregate:
+        break;
+    }
+  }
+}
+
+auto StreamAggregationExecutor::GroupTuple() const -> Tuple {
+  std::vector<Value> values(group_values_);
+  values.insert(values.end(), aggregates_.begin(), aggregates_.end());
+  return {values, &plan_->OutputSchema()};
+}
+
+auto StreamAggregationExecutor::NextGroup(Tuple *tuple) -> bool {
+  const auto &schema = child_->GetOutputSchema();
+  while (true) {
+    if (cursor_ == input_.size()) {
+      cursor_ = 0;
+      if (!child_done_ && child_->NextBatch(&input_, &input_rids_, BUSTUB_BATCH_SIZE)) {
+        continue;
+      }
+      input_.clear();
+      child_done_ = true;
+      if (has_group_) {
+        has_group_ = false;
+        emitted_ = true;
+        *tuple = GroupTuple();
+        return true;
+      }
+      // An aggregation without GROUP BY still produces one row over an empty input
+      if (!plan_->GetGroupBys().empty() || emitted_) {
+        return false;
+      }
+      StartGroup();
+      has_group_ = false;
+      emitted_ = true;
+      *tuple = GroupTuple();
+      return true;
+    }
+
+    // NULLs get their own normalized encoding, so all the NULLs of a column fall in the same group
+    row_values_.clear();
+    key_.clear();
+    for (const auto &expr : plan_->GetGroupBys()) {
+      row_values_.push_back(expr->Evaluate(&input_[cursor_], schema));
+      SortKeyEncoder::AppendValue(row_values_.back(), false, &key_);
+    }
+    if (!has_group_) {
+      StartGroup();
+    } else if (key_ != group_key_) {
+      *tuple = GroupTuple();
+      emitted_ = true;
+      StartGroup();
+      Combine();
+      cursor_++;
+      return true;
+    }
+    Combine();
+    cursor_++;
+  }
+}
+
+auto StreamAggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool { return NextGroup(tuple); }
+
+auto StreamAggregationExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size)
+    -> bool {
+  tuples->clear();
+  rids->clear();
+  Tuple tuple{};
+  while (tuples->size() < batch_size && NextGroup(&tuple)) {
+    tuples->push_back(std::move(tuple));
+    rids->emplace_back();
+  }
+  return !tuples->empty();
+}
+
+}  // namespace bustub
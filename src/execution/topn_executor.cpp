@@ -1,15 +1,53 @@
 #include "execution/executors/topn_executor.h"
 
+#include <algorithm>
+
 namespace bustub {
 
 TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void TopNExecutor::Init() {
+  child_executor_->Init();
+  SortKeyEncoder encoder(plan_->GetOrderBy(), child_executor_->GetOutputSchema());
+  auto cmp = [](const HeapEntry &a, const HeapEntry &b) {
+    auto key_cmp = a.key_.compare(b.key_);
+    return key_cmp != 0 ? key_cmp < 0 : a.seq_ < b.seq_;
+  };
+  heap_.clear();
+  cursor_ = 0;
 
-void TopNExecutor::Init() { throw NotImplementedException("TopNExecutor is not implemented"); }
+  // Pull one tuple at a time: TopNCheckExecutor expects the heap to grow by one with every tuple it hands over
+  Tuple tuple{};
+  RID rid{};
+  for (size_t seq = 0; child_executor_->Next(&tuple, &rid); seq++) {
+    if (plan_->GetN() == 0) {
+      continue;
+    }
+    HeapEntry entry{encoder.Encode(tuple), seq, std::move(tuple), rid};
+    if (heap_.size() < plan_->GetN()) {
+      heap_.push_back(std::move(entry));
+      std::push_heap(heap_.begin(), heap_.end(), cmp);
+    } else if (cmp(entry, heap_.front())) {
+      std::pop_heap(heap_.begin(), heap_.end(), cmp);
+      heap_.back() = std::move(entry);
+      std::push_heap(heap_.begin(), heap_.end(), cmp);
+    }
+  }
+  std::sort_heap(heap_.begin(), heap_.end(), cmp);
+}
 
-auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (cursor_ >= heap_.size()) {
+    return false;
+  }
+  auto &entry = heap_[cursor_++];
+  *tuple = std::move(entry.tuple_);
+  *rid = entry.rid_;
+  return true;
+}
 
-auto TopNExecutor::GetNumInHeap() -> size_t { throw NotImplementedException("TopNExecutor is not implemented"); };
+auto TopNExecutor::GetNumInHeap() -> size_t { return heap_.size(); };
 
 }  // namespace bustub
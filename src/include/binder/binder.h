@@ -31,6 +31,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -81,6 +82,10 @@ class ExplainStatement;
 class IndexStatement;
 class DeleteStatement;
 class UpdateStatement;
+class PrepareStatement;
+class ExecuteStatement;
+class DeallocateStatement;
+class AnalyzeStatement;
 
 /**
  * The binder is responsible for transforming the Postgres parse tree to a binder tree
@@ -204,6 +209,16 @@ class Binder {
 
   auto BindVariableShow(duckdb_libpgquery::PGVariableShowStmt *stmt) -> std::unique_ptr<VariableShowStatement>;
 
+  auto BindPrepare(duckdb_libpgquery::PGPrepareStmt *stmt) -> std::unique_ptr<PrepareStatement>;
+
+  auto BindExecute(duckdb_libpgquery::PGExecuteStmt *stmt) -> std::unique_ptr<ExecuteStatement>;
+
+  auto BindDeallocate(duckdb_libpgquery::PGDeallocateStmt *stmt) -> std::unique_ptr<DeallocateStatement>;
+
+  auto BindAnalyze(duckdb_libpgquery::PGVacuumStmt *stmt) -> std::unique_ptr<AnalyzeStatement>;
+
+  auto BindParamRef(duckdb_libpgquery::PGParamRef *node) -> std::unique_ptr<BoundExpression>;
+
   class ContextGuard {
    public:
     explicit ContextGuard(const BoundTableRef **scope, const CTEList **cte_scope) {
@@ -252,6 +267,9 @@ class Binder {
   /** Sometimes we will need to assign a name to some unnamed items. This variable gives them a universal ID. */
   size_t universal_id_{0};
 
+  /** The types of the parameters of the statement being prepared, `std::nullopt` outside `PREPARE`. */
+  std::optional<std::vector<TypeId>> parameter_types_;
+
   duckdb::PostgresParser parser_;
 };
 
@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/prepare_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_expression.h"
+#include "binder/bound_statement.h"
+#include "common/enums/statement_type.h"
+#include "fmt/format.h"
+#include "fmt/ranges.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class PrepareStatement : public BoundStatement {
+ public:
+  explicit PrepareStatement(std::string name, std::vector<TypeId> parameter_types,
+                            std::unique_ptr<BoundStatement> statement)
+      : BoundStatement(StatementType::PREPARE_STATEMENT),
+        name_(std::move(name)),
+        parameter_types_(std::move(parameter_types)),
+        statement_(std::move(statement)) {}
+
+  std::string name_;
+
+  /** The type of each parameter, declared or defaulting to INTEGER, in the order of `$1`, `$2`, ... */
+  std::vector<TypeId> parameter_types_;
+
+  /** The statement being prepared, with its parameters bound as `BoundParameter`s. */
+  std::unique_ptr<BoundStatement> statement_;
+
+  auto ToString() const -> std::string override {
+    std::vector<std::string> types;
+    for (auto type : parameter_types_) {
+      types.emplace_back(Type::TypeIdToString(type));
+    }
+    return fmt::format("BoundPrepare {{ name={}, parameter_types=[{}], statement={} }}", name_,
+                       fmt::join(types, ", "), statement_->ToString());
+  }
+};
+
+class ExecuteStatement : public BoundStatement {
+ public:
+  explicit ExecuteStatement(std::string name, std::vector<Value> args)
+      : BoundStatement(StatementType::EXECUTE_STATEMENT), name_(std::move(name)), args_(std::move(args)) {}
+
+  std::string name_;
+
+  /** The value of each parameter, as written in the statement. */
+  std::vector<Value> args_;
+
+  auto ToString() const -> std::string override {
+    std::vector<std::string> args;
+    for (const auto &arg : args_) {
+      args.emplace_back(arg.ToString());
+    }
+    return fmt::format("BoundExecute {{ name={}, args=[{}] }}", name_, fmt::join(args, ", "));
+  }
+};
+
+class DeallocateStatement : public BoundStatement {
+ public:
+  explicit DeallocateStatement(std::optional<std::string> name)
+      : BoundStatement(StatementType::DEALLOCATE_STATEMENT), name_(std::move(name)) {}
+
+  /** The name of the prepared statement to remove, or `std::nullopt` to remove all of them. */
+  std::optional<std::string> name_;
+
+  auto ToString() const -> std::string override {
+    return fmt::format("BoundDeallocate {{ name={} }}", name_.value_or("<all>"));
+  }
+};
+
+}  // namespace bustub
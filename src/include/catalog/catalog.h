@@ -20,6 +20,7 @@
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
+#include "catalog/table_stats.h"
 #include "container/hash/hash_function.h"
 #include "storage/index/b_plus_tree_index.h"
 #include "storage/index/extendible_hash_table_index.h"
@@ -150,10 +151,17 @@ class Catalog {
     tables_.emplace(table_oid, std::move(meta));
     table_names_.emplace(table_name, table_oid);
     index_names_.emplace(table_name, std::unordered_map<std::string, index_oid_t>{});
+    version_.fetch_add(1);
 
     return tmp;
   }
 
+  /**
+   * @return the version of the catalog, which changes whenever a table or an index is created or a table analyzed, so
+   * that a plan made before can tell it may no longer be the best one, or no longer be valid
+   */
+  auto GetVersion() const -> uint64_t { return version_.load(); }
+
   /**
    * Query table metadata by name.
    * @param table_name The name of the table
@@ -186,6 +194,33 @@ class Catalog {
     return (meta->second).get();
   }
 
+  /**
+   * Replace the statistics of a table, which its table heap keeps up to date from then on.
+   * @param table_oid The OID of the table
+   * @param stats The statistics collected by scanning the table
+   */
+  void SetTableStats(table_oid_t table_oid, std::shared_ptr<TableStats> stats) {
+    auto *table_info = GetTable(table_oid);
+    BUSTUB_ASSERT(table_info != NULL_TABLE_INFO, "table not found");
+    if (table_info->table_ != nullptr) {
+      table_info->table_->SetStats(stats);
+    }
+    table_stats_[table_oid] = std::move(stats);
+    version_.fetch_add(1);
+  }
+
+  /**
+   * @param table_oid The OID of the table
+   * @return the statistics of the table, or nullptr if it has never been analyzed
+   */
+  auto GetTableStats(table_oid_t table_oid) const -> std::shared_ptr<TableStats> {
+    auto stats = table_stats_.find(table_oid);
+    if (stats == table_stats_.end()) {
+      return nullptr;
+    }
+    return stats->second;
+  }
+
   /**
    * Create a new index, populate existing data of the table and return its metadata.
    * @param txn The transaction in which the table is being created
@@ -246,6 +281,7 @@ class Catalog {
     // Update internal tracking
     indexes_.emplace(index_oid, std::move(index_info));
     table_indexes.emplace(index_name, index_oid);
+    version_.fetch_add(1);
 
     return tmp;
   }
@@ -298,7 +334,7 @@ class Catalog {
    * @param index_oid The OID of the index for which to query
    * @return A (non-owning) pointer to the metadata for the index
    */
-  auto GetIndex(index_oid_t index_oid) -> IndexInfo * {
+  auto GetIndex(index_oid_t index_oid) const -> IndexInfo * {
     auto index = indexes_.find(index_oid);
     if (index == indexes_.end()) {
       return NULL_INDEX_INFO;
@@ -371,6 +407,15 @@ class Catalog {
 
   /** The next index identifier to be used. */
   std::atomic<index_oid_t> next_index_oid_{0};
+
+  /** Map table identifier -> statistics of the table, for the tables analyzed so far. */
+  std::unordered_map<table_oid_t, std::shared_ptr<TableStats>> table_stats_;
+
+  /**
+   * The number of tables and indexes created and tables analyzed so far, which plans optimized against the catalog are
+   * checked against.
+   */
+  std::atomic<uint64_t> version_{0};
 };
 
 }  // namespace bustub
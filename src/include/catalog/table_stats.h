@@ -0,0 +1,185 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_stats.h
+//
+// Identification: src/include/catalog/table_stats.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/util/hash_util.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * HyperLogLog estimates the number of distinct values added to it, in 2^PRECISION one-byte registers whatever that
+ * number is. Values cannot be removed, so the estimate only ever grows.
+ */
+class HyperLogLog {
+ public:
+  HyperLogLog() : registers_(1 << PRECISION, 0) {}
+
+  /** Add a value, given the hash of it, which must have all of its bits well mixed */
+  void Add(hash_t hash);
+
+  /** @return the estimated number of distinct values added so far */
+  auto Estimate() const -> double;
+
+ private:
+  /** The number of hash bits that pick a register, the standard error of the estimate being 1.04 / 2^(PRECISION/2) */
+  static constexpr uint32_t PRECISION = 12;
+
+  /** The longest run of leading zeros, plus one, among the hashes that picked each register */
+  std::vector<uint8_t> registers_;
+};
+
+/**
+ * Histogram is an equi-depth histogram over the values of a numeric column: when it is built, each bucket holds about
+ * the same number of values. Values inserted and deleted afterwards are counted in the bucket they fall in, the first
+ * and last buckets growing to take in values beyond them.
+ */
+class Histogram {
+ public:
+  Histogram() = default;
+
+  /**
+   * Build a histogram from a sample of the values of a column.
+   * @param sample the sampled values, sorted
+   * @param num_buckets the number of buckets, at most one per sampled value
+   * @param num_values the number of values the sample stands for
+   */
+  Histogram(const std::vector<double> &sample, size_t num_buckets, double num_values);
+
+  /** @return whether the histogram has no bucket, i.e. was built from an empty sample */
+  auto IsEmpty() const -> bool { return counts_.empty(); }
+
+  /** Count a value inserted after the histogram was built */
+  void Insert(double value);
+
+  /** Uncount a value deleted after the histogram was built */
+  void Delete(double value);
+
+  /** @return the estimated number of values smaller than `value`, assuming values spread evenly in a bucket */
+  auto CountLessThan(double value) const -> double;
+
+  /** @return the number of values in the histogram */
+  auto Count() const -> double;
+
+ private:
+  /** @return the bucket a value falls in, or would if the first and last buckets were extended to it */
+  auto BucketOf(double value) const -> size_t;
+
+  /** The bounds of the buckets, bucket `i` holding the values from `bounds_[i]` to `bounds_[i + 1]` */
+  std::vector<double> bounds_;
+  /** The number of values in each bucket */
+  std::vector<double> counts_;
+};
+
+/** The statistics of a column of a table */
+struct ColumnStats {
+  /** The distinct non-NULL values of the column */
+  HyperLogLog distinct_;
+  /** The number of NULL values of the column */
+  size_t null_count_{0};
+  /** The smallest and largest non-NULL values of the column, if it has any */
+  std::optional<Value> min_;
+  std::optional<Value> max_;
+  /** The distribution of the values of a numeric column, empty for other types */
+  Histogram histogram_;
+  /** A uniform sample of the numeric values inserted before Finish(), which the histogram is built from */
+  std::vector<double> sample_;
+  /** The number of numeric values inserted before Finish() */
+  size_t num_sampled_{0};
+};
+
+/**
+ * TableStats holds the statistics of a table that ANALYZE collects, and that the optimizer estimates the cardinality of
+ * plans from: the number of rows, and for each column the number of distinct values, the fraction of NULLs, the
+ * smallest and largest values, and an equi-depth histogram of numeric columns.
+ *
+ * ANALYZE inserts every tuple of the table, then calls Finish() to build the histograms from a sample of them. Tuples
+ * inserted and deleted afterwards keep the statistics approximately up to date. Estimates may be read while tuples are
+ * inserted or deleted, so every method takes the latch.
+ */
+class TableStats {
+ public:
+  /** The number of values sampled per column to build a histogram from */
+  static constexpr size_t SAMPLE_SIZE = 4096;
+  /** The number of buckets of a histogram */
+  static constexpr size_t NUM_BUCKETS = 64;
+
+  /** Construct empty statistics for a table of the given schema */
+  explicit TableStats(const Schema &schema);
+
+  /** Account for a tuple inserted into the table, or scanned by ANALYZE before Finish() */
+  void Insert(const Tuple &tuple);
+
+  /** Account for a tuple deleted from the table */
+  void Delete(const Tuple &tuple);
+
+  /** Build the histograms from the values inserted so far, ending the scan of ANALYZE */
+  void Finish();
+
+  /** @return the number of rows of the table */
+  auto RowCount() const -> double;
+
+  /** @return the estimated number of distinct non-NULL values of a column, at least 1 */
+  auto DistinctCount(uint32_t col_idx) const -> double;
+
+  /** @return the fraction of the rows whose value of a column is NULL */
+  auto NullFraction(uint32_t col_idx) const -> double;
+
+  /** @return the smallest non-NULL value of a column, if it has any */
+  auto MinValue(uint32_t col_idx) const -> std::optional<Value>;
+
+  /** @return the largest non-NULL value of a column, if it has any */
+  auto MaxValue(uint32_t col_idx) const -> std::optional<Value>;
+
+  /** @return the estimated fraction of the rows whose value of a column equals `value` */
+  auto EqualSelectivity(uint32_t col_idx, const Value &value) const -> double;
+
+  /**
+   * @return the estimated fraction of the rows whose value of a column is smaller than `value`, or smaller or equal if
+   * `inclusive` is set
+   */
+  auto LessSelectivity(uint32_t col_idx, const Value &value, bool inclusive) const -> double;
+
+ private:
+  /** @return the estimated number of distinct non-NULL values of a column, with the latch held */
+  auto DistinctCountLocked(uint32_t col_idx) const -> double;
+
+  /** @return the fraction of the rows whose value of a column is NULL, with the latch held */
+  auto NullFractionLocked(uint32_t col_idx) const -> double;
+
+  /** @return the fraction of the rows whose value of a column equals `value`, with the latch held */
+  auto EqualSelectivityLocked(uint32_t col_idx, const Value &value) const -> double;
+
+  /** The schema of the table */
+  Schema schema_;
+  /** Whether Finish() has been called, so that numeric values go to the histograms rather than to the samples */
+  bool finished_{false};
+  /** The number of rows of the table */
+  size_t row_count_{0};
+  /** The statistics of each column of the table */
+  std::vector<ColumnStats> columns_;
+  /** The random numbers reservoir sampling picks the replaced sample values with */
+  std::mt19937_64 random_;
+  /** Protects all of the above */
+  mutable std::mutex latch_;
+};
+
+}  // namespace bustub
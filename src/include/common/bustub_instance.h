@@ -12,11 +12,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <optional>
 #include <shared_mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -24,6 +27,7 @@
 
 #include "catalog/catalog.h"
 #include "common/config.h"
+#include "common/plan_cache.h"
 #include "common/util/string_util.h"
 #include "execution/check_options.h"
 #include "libfort/lib/fort.hpp"
@@ -42,11 +46,16 @@ class CheckpointManager;
 class Catalog;
 class ExecutionEngine;
 
+class BoundStatement;
 class CreateStatement;
 class IndexStatement;
 class VariableSetStatement;
 class VariableShowStatement;
 class ExplainStatement;
+class PrepareStatement;
+class ExecuteStatement;
+class DeallocateStatement;
+class AnalyzeStatement;
 
 class ResultWriter {
  public:
@@ -275,6 +284,36 @@ class BustubInstance {
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
+  /** @return the number of workers a query may use, set by `set execution_parallelism=N` */
+  auto GetExecutionParallelism() -> size_t {
+    auto variable = GetSessionVariable("execution_parallelism");
+    try {
+      return variable.empty() ? 1 : std::max(std::stoul(variable), 1UL);
+    } catch (const std::logic_error &) {
+      return 1;
+    }
+  }
+
+  /** @return the number of bytes an operator may hold before spilling, set by `set execution_memory_budget=N` */
+  auto GetExecutionMemoryBudget() -> size_t {
+    auto variable = GetSessionVariable("execution_memory_budget");
+    try {
+      return variable.empty() ? BUSTUB_MEMORY_BUDGET : std::max(std::stoul(variable), 1UL);
+    } catch (const std::logic_error &) {
+      return BUSTUB_MEMORY_BUDGET;
+    }
+  }
+
+  /** @return the number of result rows pulled from the plan at a time, set by `set result_batch_size=N` */
+  auto GetResultBatchSize() -> size_t {
+    auto variable = GetSessionVariable("result_batch_size");
+    try {
+      return variable.empty() ? BUSTUB_BATCH_SIZE : std::max(std::stoul(variable), 1UL);
+    } catch (const std::logic_error &) {
+      return BUSTUB_BATCH_SIZE;
+    }
+  }
+
  private:
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
@@ -286,8 +325,54 @@ class BustubInstance {
   void HandleExplainStatement(Transaction *txn, const ExplainStatement &stmt, ResultWriter &writer);
   void HandleVariableShowStatement(Transaction *txn, const VariableShowStatement &stmt, ResultWriter &writer);
   void HandleVariableSetStatement(Transaction *txn, const VariableSetStatement &stmt, ResultWriter &writer);
+  void HandlePrepareStatement(Transaction *txn, const PrepareStatement &stmt, const std::string &sql,
+                              ResultWriter &writer);
+  auto HandleExecuteStatement(Transaction *txn, const ExecuteStatement &stmt, ResultWriter &writer,
+                              std::shared_ptr<CheckOptions> check_options) -> bool;
+  void HandleDeallocateStatement(Transaction *txn, const DeallocateStatement &stmt, ResultWriter &writer);
+  void HandleAnalyzeStatement(Transaction *txn, const AnalyzeStatement &stmt, ResultWriter &writer);
+
+  /**
+   * Plan the prepared statements again if a table or an index was created, or a session variable was set, since they
+   * were planned. It must run before a query is parsed, as the parser cannot parse another query meanwhile.
+   */
+  void ReplanPreparedStatements();
+
+  /**
+   * Plan and optimize a SELECT, INSERT, UPDATE or DELETE statement.
+   * @param parameters the values the `$n` parameters of the statement are read from
+   */
+  auto PlanStatement(const BoundStatement &statement, std::shared_ptr<std::vector<Value>> parameters)
+      -> std::shared_ptr<const CachedPlan>;
+
+  /** Execute an optimized plan, writing its result set. */
+  auto ExecutePlan(const CachedPlan &plan, Transaction *txn, ResultWriter &writer,
+                   std::shared_ptr<CheckOptions> check_options) -> bool;
 
   std::unordered_map<std::string, std::string> session_variables_;
+
+  /** The plans of the statements executed most recently, keyed by their normalized text */
+  PlanCache plan_cache_;
+
+  /** The number of times a session variable was set */
+  uint64_t settings_version_{0};
+
+  /** A statement prepared by PREPARE, with its plan and the parameter values the plan reads */
+  struct PreparedStatement {
+    /** The text of the PREPARE statement, parsed again when the plan has to be made again */
+    std::string sql_;
+    std::vector<TypeId> parameter_types_;
+    std::shared_ptr<std::vector<Value>> parameters_;
+    /** The plan of the statement */
+    std::shared_ptr<const CachedPlan> plan_;
+    /** The value of `settings_version_` when the statement was planned */
+    uint64_t settings_version_;
+    /** Held while the statement executes, since its executions share the parameter values */
+    std::mutex latch_;
+  };
+
+  std::mutex prepared_statements_latch_;
+  std::unordered_map<std::string, std::shared_ptr<PreparedStatement>> prepared_statements_;
 };
 
 }  // namespace bustub
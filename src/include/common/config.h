@@ -35,7 +35,13 @@ static constexpr int BUSTUB_PAGE_SIZE = 4096;
 static constexpr int BUFFER_POOL_SIZE = 10;                                          // size of buffer pool
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * BUSTUB_PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                               // size of extendible hash bucket
-static constexpr int LRUK_REPLACER_K = 10;  // lookback window for lru-k replacer
+static constexpr int LRUK_REPLACER_K = 10;                       // lookback window for lru-k replacer
+static constexpr size_t BUSTUB_BATCH_SIZE = 1024;                // number of tuples moved per NextBatch call
+static constexpr size_t BUSTUB_MORSEL_SIZE = 8192;               // number of rows handed to a parallel worker at a time
+static constexpr size_t BUSTUB_HASH_JOIN_PARTITION_SIZE = 4096;  // build tuples per radix partition of a hash join
+static constexpr size_t BUSTUB_MEMORY_BUDGET = 64 << 20;         // bytes an operator may hold before spilling
+static constexpr size_t BUSTUB_SORT_CHUNK_SIZE = 1 << 16;        // rows sorted per thread of a parallel sort, at least
+static constexpr size_t BUSTUB_PLAN_CACHE_SIZE = 128;            // number of optimized plans kept per BusTub instance
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// plan_cache.h
+//
+// Identification: src/include/common/plan_cache.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/** An optimized plan, with what executing it takes besides the plan itself */
+struct CachedPlan {
+  /** The optimized plan */
+  AbstractPlanNodeRef plan_;
+  /** The output schema of the planned statement, whose column names head the result */
+  SchemaRef output_schema_;
+  /** Whether the statement deletes tuples, which the executor context is told about */
+  bool is_delete_;
+  /** The version of the catalog the plan was optimized against */
+  uint64_t catalog_version_;
+};
+
+/**
+ * PlanCache keeps the optimized plans of the most recently executed statements, keyed by their normalized SQL text, so
+ * that a statement executed again skips parsing, binding, planning and optimization.
+ *
+ * A plan optimized against an older version of the catalog is dropped when it is looked up, since a new index may make
+ * for a better plan. The cache holds at most a fixed number of plans, and evicts the least recently used one.
+ */
+class PlanCache {
+ public:
+  /** @param capacity the number of plans the cache holds at most */
+  explicit PlanCache(size_t capacity = BUSTUB_PLAN_CACHE_SIZE) : capacity_(capacity) {}
+
+  /**
+   * @return the text of a SQL statement with the comments and whitespace outside of quotes collapsed to single spaces
+   * and trailing semicolons removed, so that statements that only differ in their layout share a plan
+   */
+  static auto NormalizeSql(const std::string &sql) -> std::string;
+
+  /**
+   * @param key the normalized SQL text of a statement
+   * @param catalog_version the current version of the catalog
+   * @return the plan cached for the statement, or nullptr if there is none or it was optimized against an older
+   * catalog
+   */
+  auto Get(const std::string &key, uint64_t catalog_version) -> std::shared_ptr<const CachedPlan>;
+
+  /**
+   * Cache the plan of a statement, replacing the one cached before and evicting the least recently used one if full.
+   */
+  void Put(const std::string &key, std::shared_ptr<const CachedPlan> plan);
+
+  /** Drop every cached plan, e.g. when a session variable the optimizer reads changes. */
+  void Clear();
+
+  /** @return the number of cached plans */
+  auto Size() -> size_t;
+
+ private:
+  std::mutex latch_;
+  size_t capacity_;
+  /** The cached plans, the most recently used first */
+  std::list<std::pair<std::string, std::shared_ptr<const CachedPlan>>> entries_;
+  std::unordered_map<std::string, decltype(entries_)::iterator> index_;
+};
+
+}  // namespace bustub
@@ -45,6 +45,20 @@ class HashUtil {
     return HashBytes(reinterpret_cast<char *>(both), sizeof(hash_t) * 2);
   }
 
+  /**
+   * Scramble the bits of a hash, so that every bit of the result depends on every bit of the input. HashBytes() leaves
+   * the high bits of short inputs zero, so use this before taking a subset of the bits, e.g. to pick a partition.
+   */
+  static inline auto MixHash(hash_t hash) -> hash_t {
+    // The finalizer of MurmurHash3
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
   static inline auto SumHashes(hash_t l, hash_t r) -> hash_t {
     return (l % PRIME_FACTOR + r % PRIME_FACTOR) % PRIME_FACTOR;
   }
@@ -0,0 +1,142 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_hash_table.h
+//
+// Identification: src/include/execution/aggregation_hash_table.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/util/hash_util.h"
+#include "execution/expressions/compiled_expression.h"
+#include "execution/plans/aggregation_plan.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * AggregationHashTable holds the groups of an aggregation in a flat, open-addressing hash table.
+ *
+ * The group-by values of a row are encoded into one normalized byte string (see SortKeyEncoder), which is hashed once
+ * and compared with memcmp. Groups are numbered in the order they first appear. Their keys are packed one after the
+ * other in a single buffer, and the slots of the table only hold a hash and a group number, probed linearly.
+ *
+ * COUNT, and SUM, MIN and MAX over INTEGER, BIGINT and DECIMAL inputs, are accumulated as native 64-bit integers or
+ * doubles. Aggregates over other types fall back to combining Values.
+ */
+class AggregationHashTable {
+ public:
+  /**
+   * Construct a new AggregationHashTable instance.
+   * @param plan the aggregation plan
+   * @param child_schema the schema of the input tuples
+   */
+  AggregationHashTable(const AggregationPlanNode *plan, const Schema &child_schema);
+
+  /**
+   * Aggregate a batch of input tuples into their groups.
+   * @param tuples the input tuples
+   * @param[out] missed if not nullptr, no group is created: the rows whose group is not in the table yet are skipped,
+   * and listed here with the hash of their group-by values
+   */
+  void InsertBatch(const std::vector<Tuple> &tuples, std::vector<std::pair<size_t, hash_t>> *missed = nullptr);
+
+  /** Remove all the groups. */
+  void Clear();
+
+  /** @return the number of groups */
+  auto Size() const -> size_t { return num_groups_; }
+
+  /** @return an estimate of the bytes held by the groups, not counting the variable-length data of their Values */
+  auto MemoryUsage() const -> size_t {
+    return slots_.capacity() * sizeof(Slot) + keys_.capacity() + key_offsets_.capacity() * sizeof(size_t) +
+           (group_values_.capacity() + value_accumulators_.capacity()) * sizeof(Value) +
+           accumulators_.capacity() * sizeof(Accumulator);
+  }
+
+  /** @return the output tuple of a group, its group-by values followed by its aggregates */
+  auto GroupTuple(size_t group, const Schema &output_schema) const -> Tuple;
+
+  /** @return the output tuple of an aggregation without GROUP BY over an empty input */
+  auto EmptyTuple(const Schema &output_schema) const -> Tuple;
+
+ private:
+  /** How an aggregate is accumulated */
+  enum class AccumulatorKind : uint8_t { Count, Integer, Decimal, Value };
+
+  /** The running state of one aggregate of one group */
+  struct Accumulator {
+    int64_t integer_{0};
+    double decimal_{0};
+    bool is_null_{true};
+  };
+
+  /** One slot of the hash table. An empty slot has the group number `EMPTY_SLOT`. */
+  struct Slot {
+    hash_t hash_;
+    uint32_t group_;
+  };
+
+  static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+  /** @return the group of the key in `key_`, or `EMPTY_SLOT` if there is none */
+  auto FindGroup(hash_t hash) const -> uint32_t;
+
+  /** @return a new group for the key in `key_`, with the group-by values of a row of the current batch */
+  auto InsertGroup(hash_t hash, size_t row) -> uint32_t;
+
+  /** Double the number of slots, placing each group again from its saved hash. */
+  void Grow();
+
+  /** Fold the value of one aggregate of a row into an accumulator. */
+  void Update(size_t agg, const Value &val, Accumulator *acc, Value *value_acc);
+
+  /** @return the value of an accumulator */
+  auto AccumulatorValue(size_t agg, const Accumulator &acc, const Value *value_acc) const -> Value;
+
+  /** Evaluate an expression over a batch, compiled if it could be. */
+  void Evaluate(const AbstractExpressionRef &expr, CompiledExpression *compiled, const std::vector<Tuple> &tuples,
+                std::vector<Value> *values);
+
+  const AggregationPlanNode *plan_;
+  const Schema &child_schema_;
+  /** The compiled group-by and aggregate expressions, nullptr for the ones evaluated as expression trees */
+  std::vector<std::unique_ptr<CompiledExpression>> compiled_group_bys_;
+  std::vector<std::unique_ptr<CompiledExpression>> compiled_aggregates_;
+  /** The accumulator kind of each aggregate */
+  std::vector<AccumulatorKind> kinds_;
+  /** Whether some aggregate is accumulated as Values */
+  bool has_value_accumulators_{false};
+
+  /** The hash table, a power of two of slots kept at most half full */
+  std::vector<Slot> slots_;
+  size_t num_groups_{0};
+  /** The normalized keys of the groups, one after the other, and where each one starts. */
+  std::string keys_;
+  std::vector<size_t> key_offsets_{0};
+  /** The group-by values of the groups, for the output, `GetGroupBys().size()` per group */
+  std::vector<Value> group_values_;
+  /** The accumulators of the groups, `GetAggregates().size()` per group */
+  std::vector<Accumulator> accumulators_;
+  /** The Value accumulators of the groups, in the same layout, if some aggregate needs them */
+  std::vector<Value> value_accumulators_;
+
+  /** Scratch space: the key of the current row, and the values of a batch */
+  std::string key_;
+  std::vector<std::vector<Value>> group_by_values_;
+  std::vector<std::vector<Value>> aggregate_values_;
+};
+
+}  // namespace bustub
@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
@@ -53,6 +57,33 @@ class ExecutionEngine {
   // NOLINTNEXTLINE
   auto Execute(const AbstractPlanNodeRef &plan, std::vector<Tuple> *result_set, Transaction *txn,
                ExecutorContext *exec_ctx) -> bool {
+    auto executor_succeeded = ExecuteStreaming(
+        plan,
+        [result_set](std::vector<Tuple> *tuples) {
+          if (result_set != nullptr) {
+            std::move(tuples->begin(), tuples->end(), std::back_inserter(*result_set));
+          }
+        },
+        txn, exec_ctx);
+    if (!executor_succeeded && result_set != nullptr) {
+      result_set->clear();
+    }
+    return executor_succeeded;
+  }
+
+  /**
+   * Execute a query plan, handing its output to a consumer a batch at a time, as the root executor produces it. The
+   * output is never held in full, and the first rows can be consumed before the last ones are produced. If execution
+   * fails, the batches consumed so far are not taken back.
+   * @param plan The query plan to execute
+   * @param consumer Called with each batch of tuples produced by executing the plan, which it may move from
+   * @param txn The transaction context in which the query executes
+   * @param exec_ctx The executor context in which the query executes
+   * @param batch_size The maximum number of tuples in a batch
+   * @return `true` if execution of the query plan succeeds, `false` otherwise
+   */
+  auto ExecuteStreaming(const AbstractPlanNodeRef &plan, const std::function<void(std::vector<Tuple> *)> &consumer,
+                        Transaction *txn, ExecutorContext *exec_ctx, size_t batch_size = BUSTUB_BATCH_SIZE) -> bool {
     BUSTUB_ASSERT((txn == exec_ctx->GetTransaction()), "Broken Invariant");
 
     // Construct the executor for the abstract plan node
@@ -63,13 +94,10 @@ class ExecutionEngine {
 
     try {
       executor->Init();
-      PollExecutor(executor.get(), plan, result_set);
+      PollExecutor(executor.get(), consumer, batch_size);
       PerformChecks(exec_ctx);
     } catch (const ExecutionException &ex) {
       executor_succeeded = false;
-      if (result_set != nullptr) {
-        result_set->clear();
-      }
     }
 
     return executor_succeeded;
@@ -89,17 +117,15 @@ class ExecutionEngine {
   /**
    * Poll the executor until exhausted, or exception escapes.
    * @param executor The root executor
-   * @param plan The plan to execute
-   * @param result_set The tuple result set
+   * @param consumer The consumer of each batch of output tuples
+   * @param batch_size The maximum number of tuples in a batch
    */
-  static void PollExecutor(AbstractExecutor *executor, const AbstractPlanNodeRef &plan,
-                           std::vector<Tuple> *result_set) {
-    RID rid{};
-    Tuple tuple{};
-    while (executor->Next(&tuple, &rid)) {
-      if (result_set != nullptr) {
-        result_set->push_back(tuple);
-      }
+  static void PollExecutor(AbstractExecutor *executor, const std::function<void(std::vector<Tuple> *)> &consumer,
+                           size_t batch_size) {
+    std::vector<RID> rids{};
+    std::vector<Tuple> tuples{};
+    while (executor->NextBatch(&tuples, &rids, batch_size)) {
+      consumer(&tuples);
     }
   }
 
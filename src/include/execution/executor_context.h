@@ -14,6 +14,7 @@
 
 #include <deque>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -22,10 +23,12 @@
 #include "concurrency/transaction.h"
 #include "execution/check_options.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/parallel_context.h"
 #include "storage/page/tmp_tuple_page.h"
 
 namespace bustub {
 class AbstractExecutor;
+class RuntimeFilter;
 /**
  * ExecutorContext stores all the context necessary to run an executor.
  */
@@ -93,6 +96,39 @@ class ExecutorContext {
 
   auto IsDelete() const -> bool { return is_delete_; }
 
+  /** @return the number of bytes an operator may hold in memory before it spills to temporary pages */
+  auto GetMemoryBudget() const -> size_t { return memory_budget_; }
+
+  /** Set the number of bytes an operator may hold in memory before it spills to temporary pages. */
+  void SetMemoryBudget(size_t memory_budget) { memory_budget_ = memory_budget; }
+
+  /** @return the context shared with the other workers running the same plan fragment, nullptr if not in a worker */
+  auto GetParallelContext() const -> ParallelContext * { return parallel_ctx_.get(); }
+
+  /** @return the index of the worker this context belongs to, among the workers running the same plan fragment */
+  auto GetWorkerId() const -> size_t { return worker_id_; }
+
+  /**
+   * Make this the context of one worker running a copy of a parallel plan fragment.
+   * @param parallel_ctx the context shared by the workers
+   * @param worker_id the index of this worker
+   */
+  void SetParallelContext(std::shared_ptr<ParallelContext> parallel_ctx, size_t worker_id) {
+    parallel_ctx_ = std::move(parallel_ctx);
+    worker_id_ = worker_id;
+  }
+
+  /** @return the runtime filter published under an identifier, nullptr if its hash join has not built it yet */
+  auto GetRuntimeFilter(size_t filter_id) const -> RuntimeFilter * {
+    auto it = runtime_filters_.find(filter_id);
+    return it == runtime_filters_.end() ? nullptr : it->second.get();
+  }
+
+  /** Publish the runtime filter a hash join built, replacing the one it built before, if any. */
+  void SetRuntimeFilter(size_t filter_id, std::shared_ptr<RuntimeFilter> filter) {
+    runtime_filters_[filter_id] = std::move(filter);
+  }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -109,6 +145,14 @@ class ExecutorContext {
   /** The set of check options associated with this executor context */
   std::shared_ptr<CheckOptions> check_options_;
   bool is_delete_;
+  /** The number of bytes an operator may hold in memory before it spills */
+  size_t memory_budget_{BUSTUB_MEMORY_BUDGET};
+  /** The context shared by the workers of a parallel plan fragment, nullptr if not in a worker */
+  std::shared_ptr<ParallelContext> parallel_ctx_;
+  /** The index of this worker in the parallel plan fragment */
+  size_t worker_id_{0};
+  /** The runtime filters built by the hash joins of the plan, by identifier */
+  std::unordered_map<size_t, std::shared_ptr<RuntimeFilter>> runtime_filters_;
 };
 
 }  // namespace bustub
@@ -12,13 +12,17 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
 #include "execution/executor_context.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 class ExecutorContext;
 /**
- * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
+ * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model, with an optional batch interface.
  * This is the base class from which all executors in the BustTub execution
  * engine inherit, and defines the minimal interface that all executors support.
  */
@@ -47,6 +51,37 @@ class AbstractExecutor {
    */
   virtual auto Next(Tuple *tuple, RID *rid) -> bool = 0;
 
+  /**
+   * Yield a batch of tuples from this executor.
+   *
+   * The default implementation adapts Next(), so that tuple-at-a-time executors can be driven by batch-aware
+   * parents. Executors that can produce many tuples cheaply override it. A parent should stick to either Next() or
+   * NextBatch() on a given child between two Init() calls.
+   *
+   * @param[out] tuples The tuples produced by this executor, cleared before being filled
+   * @param[out] rids The RIDs of the produced tuples, one for each tuple
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  virtual auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+    tuples->clear();
+    rids->clear();
+    Tuple tuple{};
+    RID rid{};
+    while (tuples->size() < batch_size && Next(&tuple, &rid)) {
+      tuples->push_back(std::move(tuple));
+      rids->push_back(rid);
+    }
+    return !tuples->empty();
+  }
+
+  /**
+   * Tell the executor that its consumer is done with it, and will not pull another tuple before the next Init(), so
+   * that the work done ahead of the consumer can stop. Executors that stream the tuples of their children pass it on
+   * to them. The default implementation does nothing.
+   */
+  virtual void Close() {}
+
   /** @return The schema of the tuples that this executor produces */
   virtual auto GetOutputSchema() const -> const Schema & = 0;
 
@@ -57,4 +92,44 @@ class AbstractExecutor {
   /** The executor context in which the executor runs */
   ExecutorContext *exec_ctx_;
 };
+
+/**
+ * BatchCursor adapts NextBatch() to Next(), the mirror of the default NextBatch(), for executors that produce their
+ * tuples a batch at a time: it hands out the tuples of one batch, and pulls the next batch once they are all out.
+ */
+class BatchCursor {
+ public:
+  /** Drop the tuples of the current batch, when the executor is initialized again. */
+  void Reset() {
+    tuples_.clear();
+    rids_.clear();
+    cursor_ = 0;
+  }
+
+  /**
+   * Yield the next tuple of the current batch, or of the next batch of the executor once the current one is out.
+   * @param executor The executor whose batches are handed out
+   * @param[out] tuple The next tuple produced by the executor
+   * @param[out] rid The next tuple RID produced by the executor
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(AbstractExecutor *executor, Tuple *tuple, RID *rid) -> bool {
+    if (cursor_ == tuples_.size()) {
+      cursor_ = 0;
+      if (!executor->NextBatch(&tuples_, &rids_, BUSTUB_BATCH_SIZE)) {
+        return false;
+      }
+    }
+    *tuple = std::move(tuples_[cursor_]);
+    *rid = rids_[cursor_];
+    cursor_++;
+    return true;
+  }
+
+ private:
+  /** The current batch, and the next tuple of it to hand out */
+  std::vector<Tuple> tuples_;
+  std::vector<RID> rids_;
+  size_t cursor_{0};
+};
 }  // namespace bustub
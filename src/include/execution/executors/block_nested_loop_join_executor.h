@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// block_nested_loop_join_executor.h
+//
+// Identification: src/include/execution/executors/block_nested_loop_join_executor.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/block_nested_loop_join_plan.h"
+#include "storage/table/tmp_tuple_file.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * BlockNestedLoopJoinExecutor executes a join on any predicate, reading each child only once. Init() materializes the
+ * right child, in memory as long as it fits in the memory budget and in temporary pages otherwise. The left child is
+ * then read a block at a time, as many tuples as fit in what is left of the budget, and every right tuple is checked
+ * against the whole block, so that spilled right tuples are read back once per block rather than once per left tuple.
+ *
+ * A left tuple of a left join is padded with NULLs once the whole right side has been checked against its block.
+ */
+class BlockNestedLoopJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new BlockNestedLoopJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The block nested loop join plan to be executed
+   * @param left_executor The child executor that produces tuples for the left side of join
+   * @param right_executor The child executor that produces tuples for the right side of join
+   */
+  BlockNestedLoopJoinExecutor(ExecutorContext *exec_ctx, const BlockNestedLoopJoinPlanNode *plan,
+                              std::unique_ptr<AbstractExecutor> &&left_executor,
+                              std::unique_ptr<AbstractExecutor> &&right_executor);
+
+  /** Initialize the join, and materialize the right child */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join
+   * @param[out] rid The next tuple RID produced, not used by block nested loop join
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch of tuples from the join.
+   * @param[out] tuples The next tuples produced by the join
+   * @param[out] rids The RIDs of the produced tuples, not used by block nested loop join
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** Tell the left child that no more tuples are needed, the right one having been read in Init() */
+  void Close() override { left_executor_->Close(); }
+
+  /** @return The output schema for the join */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+ private:
+  /** Read the next block of left tuples, @return `false` if the left child is exhausted */
+  auto NextLeftBlock() -> bool;
+
+  /** Move on to the next right tuples to check against the block, @return `false` once all of them have been */
+  auto NextRightChunk() -> bool;
+
+  /** Join the current block with the next right tuples into `pending_`, @return `false` once the join is done */
+  auto JoinNext() -> bool;
+
+  /** The block nested loop join plan node to be executed */
+  const BlockNestedLoopJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  /** The right tuples, when they fit in memory */
+  std::vector<Tuple> right_tuples_;
+  /** The estimated memory `right_tuples_` holds */
+  size_t right_memory_{0};
+  /** The right tuples written out to temporary pages, nullptr if they fit in memory */
+  std::unique_ptr<TmpTupleFile> right_file_;
+  /** The right tuples read back from `right_file_` */
+  std::vector<Tuple> right_batch_;
+  /** The right tuples being checked against the block, and the next one of them */
+  const std::vector<Tuple> *right_chunk_{nullptr};
+  size_t right_cursor_{0};
+
+  /** The current block of left tuples, and whether each of them has found a match */
+  std::vector<Tuple> block_;
+  std::vector<bool> matched_;
+  /** Whether the whole right side has been checked against the block, so that the next block is read */
+  bool block_done_{true};
+  /** Whether the left child is exhausted */
+  bool left_done_{false};
+  /** The left batch being cut into blocks, and the next tuple of it */
+  std::vector<Tuple> left_batch_;
+  std::vector<RID> left_rids_;
+  size_t left_cursor_{0};
+
+  /** The joined tuples not handed out yet */
+  std::vector<Tuple> pending_;
+  size_t pending_cursor_{0};
+
+  /** The output batch handed out by Next() */
+  BatchCursor next_;
+};
+
+}  // namespace bustub
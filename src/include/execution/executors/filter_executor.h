@@ -17,6 +17,7 @@
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expressions/compiled_expression.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "storage/table/tuple.h"
@@ -48,6 +49,18 @@ class FilterExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the filter. Rejected tuples are compacted out of the child batch in place.
+   * @param[out] tuples The next tuples produced by the filter
+   * @param[out] rids The RIDs of the produced tuples
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** Tell the child that no more tuples are needed */
+  void Close() override { child_executor_->Close(); }
+
   /** @return The output schema for the filter plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -57,5 +70,10 @@ class FilterExecutor : public AbstractExecutor {
 
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The compiled predicate, nullptr if the predicate cannot be compiled */
+  std::unique_ptr<CompiledExpression> compiled_predicate_;
+  /** The result of the compiled predicate over the current batch */
+  std::vector<uint8_t> selection_;
 };
 }  // namespace bustub
@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.h
+//
+// Identification: src/include/execution/executors/gather_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/parallel_context.h"
+#include "execution/plans/gather_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * GatherExecutor runs one copy of its child plan per worker thread and hands out the batches the workers produce, in
+ * whatever order they arrive. The workers share a ParallelContext, through which the scans of the child plan split
+ * their input into morsels.
+ */
+class GatherExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new GatherExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The gather plan to be executed
+   */
+  GatherExecutor(ExecutorContext *exec_ctx, const GatherPlanNode *plan);
+
+  /** Stop and join the workers that are still running. */
+  ~GatherExecutor() override;
+
+  /** Initialize the gather, starting the workers */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the workers.
+   * @param[out] tuple The next tuple produced by the gather
+   * @param[out] rid The next tuple RID produced by the gather
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch of tuples from the workers.
+   * @param[out] tuples The next tuples produced by the gather
+   * @param[out] rids The RIDs of the produced tuples
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if every worker is done
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** Stop the workers, which otherwise keep producing batches until the queue is full */
+  void Close() override;
+
+  /** @return The output schema for the gather */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+ private:
+  /** Run the copy of the child plan of one worker, pushing its output to `batches_`. */
+  void RunWorker(size_t worker_id);
+
+  /** Cancel the running workers and wait for them to exit. */
+  void StopWorkers();
+
+  /**
+   * Wait for the next batch of the workers and make it the current batch. Rethrows the error of a failed worker.
+   * @return `false` if every worker is done
+   */
+  auto PopBatch() -> bool;
+
+  /** The gather plan node to be executed */
+  const GatherPlanNode *plan_;
+
+  /** The state shared by the workers */
+  std::shared_ptr<ParallelContext> parallel_ctx_;
+  /** The executor context of each worker */
+  std::vector<std::unique_ptr<ExecutorContext>> worker_ctxs_;
+  /** The copy of the child plan run by each worker */
+  std::vector<std::unique_ptr<AbstractExecutor>> worker_executors_;
+  /** The worker threads */
+  std::vector<std::thread> workers_;
+
+  /** Protects the fields below, which are shared with the workers */
+  std::mutex latch_;
+  /** Signaled when a batch is added, or a worker exits */
+  std::condition_variable not_empty_;
+  /** Signaled when a batch is taken, or the workers are cancelled */
+  std::condition_variable not_full_;
+  /** The batches produced by the workers and not taken yet */
+  std::deque<std::pair<std::vector<Tuple>, std::vector<RID>>> batches_;
+  /** The number of workers that have not exited */
+  size_t running_workers_{0};
+  /** Set to make the workers exit early */
+  bool cancelled_{false};
+  /** The first error raised by a worker */
+  std::exception_ptr error_;
+
+  /** The batch being handed out, only accessed by the thread calling Next() */
+  std::vector<Tuple> current_tuples_;
+  std::vector<RID> current_rids_;
+  size_t cursor_{0};
+};
+
+}  // namespace bustub
@@ -13,17 +13,94 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "common/util/hash_util.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/hash_join_plan.h"
+#include "execution/runtime_filter.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
+/** HashJoinKey represents the values of the join key expressions of one tuple */
+struct HashJoinKey {
+  /** The join key values */
+  std::vector<Value> keys_;
+  /** The hash of the key values, set by ComputeHash() */
+  hash_t hash_{0};
+
+  /**
+   * Compares two join keys for equality. NULL never equals anything, including NULL.
+   * @param other the other join key to be compared with
+   * @return `true` if both join keys have equivalent values, `false` otherwise
+   */
+  auto operator==(const HashJoinKey &other) const -> bool {
+    for (uint32_t i = 0; i < other.keys_.size(); i++) {
+      if (keys_[i].CompareEquals(other.keys_[i]) != CmpBool::CmpTrue) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /** @return `true` if any of the key values is NULL, in which case the key cannot match */
+  auto HasNull() const -> bool {
+    for (const auto &key : keys_) {
+      if (key.IsNull()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** Hash the non-NULL key values into `hash_`. */
+  void ComputeHash() {
+    hash_t curr_hash = 0;
+    for (const auto &key : keys_) {
+      if (!key.IsNull()) {
+        curr_hash = HashUtil::CombineHashes(curr_hash, HashUtil::HashValue(&key));
+      }
+    }
+    hash_ = HashUtil::MixHash(curr_hash);
+  }
+};
+
+}  // namespace bustub
+
+namespace std {
+
+/** Implements std::hash on HashJoinKey */
+template <>
+struct hash<bustub::HashJoinKey> {
+  auto operator()(const bustub::HashJoinKey &join_key) const -> std::size_t { return join_key.hash_; }
+};
+
+}  // namespace std
+
+namespace bustub {
+
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes an equi-join on two tables with a hash table. The hash table is built on the right child,
+ * and the left child probes it, so that left outer joins are supported.
+ *
+ * The hash table is radix-partitioned: right tuples are first scattered on the high bits of their key hash into
+ * partitions of about BUSTUB_HASH_JOIN_PARTITION_SIZE tuples, and a separate table is built for each partition, on
+ * several threads when there are several partitions. Each build then stays within a cache-sized table, and a probe
+ * goes straight to the one partition its key hashes to.
+ *
+ * The build side may hold at most the memory budget of the executor context. Right tuples are split on the low bits of
+ * their key hash into spill partitions, and when the budget is exceeded the largest spill partition is written out to
+ * temporary pages, along with the left tuples that hash to it later on. Partitions that stay in memory are joined
+ * right away, as in a hybrid hash join. Each spilled partition is then joined on its own once the left child is
+ * exhausted, spilling again on the next hash bits if it still does not fit.
+ *
+ * When the plan carries a runtime filter, the right join keys are also summarized into a RuntimeFilter while the right
+ * child is drained, and published in the executor context for the scans on the left side to drop non-matching rows.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -48,12 +125,118 @@ class HashJoinExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the join. The left child is probed a batch at a time.
+   * @param[out] tuples The next tuples produced by the join
+   * @param[out] rids The next tuple RIDs, not used by hash join
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** Tell the children that no more tuples are needed, the left one being the only one still pulled from */
+  void Close() override {
+    left_child_->Close();
+    right_child_->Close();
+  }
+
   /** @return The output schema for the join */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
-  /** The NestedLoopJoin plan node to be executed. */
+  /** A partition of both sides of the join written out to temporary pages, to be joined after the current pass */
+  struct SpilledPartition {
+    /** The right tuples of the partition */
+    std::unique_ptr<TmpTupleFile> build_;
+    /** The left tuples of the partition */
+    std::unique_ptr<TmpTupleFile> probe_;
+    /** The number of times the tuples have been split into spill partitions */
+    size_t level_;
+  };
+
+  /**
+   * Build the hash table of a pass, spilling partitions that do not fit in the memory budget.
+   * @param source the spilled right tuples to build from, or nullptr to drain the right child
+   */
+  void Build(TmpTupleFile *source);
+
+  /** Build the radix-partitioned in-memory hash table from the right tuples that stayed in memory. */
+  void BuildHashTable(std::vector<std::pair<HashJoinKey, Tuple>> &&entries);
+
+  /**
+   * Fetch the next batch of left tuples to probe with, into `left_tuples_` and `left_keys_`. Left tuples of spilled
+   * partitions are set aside, and a new pass over the next spilled partition starts when the current one is done.
+   * @return `false` if every pass is done
+   */
+  auto NextProbeBatch() -> bool;
+
+  /**
+   * Queue the partitions spilled by the current pass, and start a pass over the next queued partition.
+   * @return `false` if there are no partitions left
+   */
+  auto StartNextPass() -> bool;
+
+  /** @return The partition of the in-memory hash table a key hash belongs to */
+  auto PartitionOf(hash_t hash) const -> size_t {
+    return partition_bits_ == 0 ? 0 : hash >> (sizeof(hash_t) * 8 - partition_bits_);
+  }
+
+  /** @return The spill partition a key hash belongs to in the current pass */
+  auto SpillPartitionOf(hash_t hash) const -> size_t;
+
+  /** @return The join key of a left tuple */
+  auto MakeLeftJoinKey(const Tuple &tuple) const -> HashJoinKey;
+
+  /** @return The join key of a right tuple */
+  auto MakeRightJoinKey(const Tuple &tuple) const -> HashJoinKey;
+
+  /** Point the probe cursor at the matches of the left tuple under the left cursor. */
+  void Probe();
+
+  /**
+   * Emit the next output tuple for the left tuple under the probe cursor.
+   * @return `true` if a tuple was produced, `false` if the current left tuple has no more output
+   */
+  auto EmitNext(Tuple *tuple) -> bool;
+
+  /** The HashJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
+  /** The left child, which probes the hash table */
+  std::unique_ptr<AbstractExecutor> left_child_;
+  /** The right child, from which the hash table is built */
+  std::unique_ptr<AbstractExecutor> right_child_;
+  /** The hash table from join keys to right tuples, one per radix partition */
+  std::vector<std::unordered_map<HashJoinKey, std::vector<Tuple>>> partitions_;
+  /** The number of hash bits partitions are picked on */
+  size_t partition_bits_{0};
+
+  /** The number of times the tuples of the current pass have been split into spill partitions */
+  size_t level_{0};
+  /** The right tuples of the spill partitions written out by the current pass, nullptr for those kept in memory */
+  std::vector<std::unique_ptr<TmpTupleFile>> spilled_build_;
+  /** The left tuples of the spill partitions written out by the current pass */
+  std::vector<std::unique_ptr<TmpTupleFile>> spilled_probe_;
+  /** The spilled partitions waiting for their own pass */
+  std::vector<SpilledPartition> pending_;
+  /** The spilled left tuples probing the current pass, nullptr if the pass probes with the left child */
+  std::unique_ptr<TmpTupleFile> probe_source_;
+
+  /** The batch of left tuples being probed */
+  std::vector<Tuple> left_tuples_;
+  /** The join keys of the batch of left tuples */
+  std::vector<HashJoinKey> left_keys_;
+  /** The RIDs of the batch of left tuples, not used */
+  std::vector<RID> left_rids_;
+  /** The position of the left tuple being probed in `left_tuples_` */
+  size_t left_cursor_{0};
+  /** Whether the left tuple at `left_cursor_` is being probed */
+  bool probing_{false};
+  /** The matches of the left tuple being probed, nullptr if there are none */
+  const std::vector<Tuple> *matches_{nullptr};
+  /** The position of the next match to be emitted */
+  size_t match_cursor_{0};
+  /** Whether the NULL-padded tuple for the current left tuple of a left join has been emitted */
+  bool null_padded_emitted_{false};
 };
 
 }  // namespace bustub
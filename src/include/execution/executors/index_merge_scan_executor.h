@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_merge_scan_executor.h
+//
+// Identification: src/include/execution/executors/index_merge_scan_executor.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/rid.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/index_merge_scan_plan.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * IndexMergeScanExecutor looks up keys in several indexes of a table, merges the sorted RID sets they produce, and reads
+ * the tuples of the merged RIDs in page order.
+ */
+class IndexMergeScanExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new IndexMergeScanExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The index merge scan plan to be executed
+   */
+  IndexMergeScanExecutor(ExecutorContext *exec_ctx, const IndexMergeScanPlanNode *plan);
+
+  /** Look up the keys in every index and merge the RIDs found */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the index merge scan.
+   * @param[out] tuple The next tuple produced by the scan
+   * @param[out] rid The next tuple RID produced by the scan
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch of tuples from the index merge scan, fetching each heap page once for the batch.
+   * @param[out] tuples The next tuples produced by the scan
+   * @param[out] rids The RIDs of the produced tuples
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if the scan is complete
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** @return The output schema for the index merge scan */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+ private:
+  /** @return the RIDs of the tuples with any of the keys of a lookup, sorted and without duplicates */
+  auto LookUp(const IndexLookup &lookup) -> std::vector<RID>;
+
+  /** The index merge scan plan node to be executed */
+  const IndexMergeScanPlanNode *plan_;
+  /** The table heap the tuples are read from */
+  TableHeap *table_heap_{nullptr};
+  /** The merged RIDs, sorted, and the next one of them to read */
+  std::vector<RID> rids_;
+  size_t cursor_{0};
+  /** The RIDs of the tuples to read next */
+  std::vector<RID> batch_rids_;
+  /** The tuples read ahead by Next() */
+  BatchCursor next_;
+};
+}  // namespace bustub
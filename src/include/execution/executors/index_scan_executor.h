@@ -12,12 +12,15 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
+#include "catalog/catalog.h"
 #include "common/rid.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/index_scan_plan.h"
+#include "storage/index/b_plus_tree_index.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -41,8 +44,33 @@ class IndexScanExecutor : public AbstractExecutor {
 
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the index scan. With `sort_rids_`, the RIDs of the batch are in page order, so
+   * that each heap page is fetched once for all the tuples of the batch on it.
+   * @param[out] tuples The next tuples produced by the scan
+   * @param[out] rids The RIDs of the produced tuples
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if the scan is complete
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
  private:
+  /** Move the RIDs of up to `batch_size` more index entries into `batch_rids_`, @return false if there are none */
+  auto NextRids(size_t batch_size) -> bool;
+
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
+  /** The table the index is on */
+  TableInfo *table_info_{nullptr};
+  /** The iterator over the whole index, when there are no keys to look up */
+  std::optional<BPlusTreeIndexIteratorForTwoIntegerColumn> iter_;
+  /** The RIDs of the looked up keys, when there are some */
+  std::vector<RID> lookup_rids_;
+  /** The next RID of `lookup_rids_` to read */
+  size_t cursor_{0};
+  /** The RIDs of the tuples to read next */
+  std::vector<RID> batch_rids_;
+  /** The tuples read ahead by Next() */
+  BatchCursor next_;
 };
 }  // namespace bustub
@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.h
+//
+// Identification: src/include/execution/executors/merge_join_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/sort_key.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * MergeJoinExecutor executes an equi-join on two children sorted on their join keys. Both children are read once, in
+ * step: the right tuples with the key of the current left tuple are collected into a run, which every left tuple with
+ * that key is joined with, so that duplicate keys on both sides produce all their pairs. Only one run of right tuples
+ * is held at a time.
+ *
+ * Keys are compared as normalized sort keys (see SortKeyEncoder), in which NULLs sort at one end. A key with a NULL
+ * value never matches, so such left tuples are only padded with NULLs in a left join.
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new MergeJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The merge join plan to be executed
+   * @param left_child The child executor that produces tuples for the left side of join
+   * @param right_child The child executor that produces tuples for the right side of join
+   */
+  MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&left_child, std::unique_ptr<AbstractExecutor> &&right_child);
+
+  /** Initialize the join */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join
+   * @param[out] rid The next tuple RID produced by the join, not used by merge join
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch of tuples from the join.
+   * @param[out] tuples The next tuples produced by the join
+   * @param[out] rids The RIDs of the produced tuples, not used by merge join
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** Tell both children that no more tuples are needed, the two of them being read as the join goes */
+  void Close() override {
+    left_.child_->Close();
+    right_.child_->Close();
+  }
+
+  /** @return The output schema for the join */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+ private:
+  /** One child, read a batch at a time, and the join key of its current tuple */
+  struct Input {
+    std::unique_ptr<AbstractExecutor> child_;
+    const std::vector<AbstractExpressionRef> *key_expressions_;
+    std::vector<Tuple> tuples_;
+    std::vector<RID> rids_;
+    /** The position of the current tuple in `tuples_` */
+    size_t cursor_{0};
+    /** Whether there is a current tuple, `false` once the child is exhausted */
+    bool valid_{false};
+    /** The normalized join key of the current tuple, and whether one of its values is NULL */
+    SortKey key_;
+    bool key_has_null_{false};
+
+    /** @return the current tuple */
+    auto Current() const -> const Tuple & { return tuples_[cursor_]; }
+  };
+
+  /** Move an input to its next tuple, and compute its join key. */
+  void Advance(Input *input);
+
+  /** Collect the right tuples with the key of the current left tuple into `run_`, unless `run_` already has it. */
+  void FindRun();
+
+  /** The merge join plan node to be executed */
+  const MergeJoinPlanNode *plan_;
+
+  Input left_;
+  Input right_;
+
+  /** The right tuples whose key is `run_key_`, valid if `has_run_` */
+  std::vector<Tuple> run_;
+  SortKey run_key_;
+  bool has_run_{false};
+  /** Whether the current left tuple is being joined, and the next tuple of `run_` to join it with */
+  bool joining_{false};
+  size_t run_cursor_{0};
+
+  /** The output batch handed out by Next() */
+  BatchCursor next_;
+};
+
+}  // namespace bustub
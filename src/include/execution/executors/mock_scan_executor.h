@@ -18,7 +18,9 @@
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/parallel_context.h"
 #include "execution/plans/mock_scan_plan.h"
+#include "execution/runtime_filter.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -71,6 +73,15 @@ class MockScanExecutor : public AbstractExecutor {
   /** The cursor for the current mock scan */
   std::size_t cursor_{0};
 
+  /** One past the last row of the current morsel, or the size of the table when not running in a worker */
+  std::size_t end_{0};
+
+  /** The rows shared with the other workers, nullptr when not running in a worker */
+  RowMorselQueue *morsels_{nullptr};
+
+  /** The schema of the rows of the mock table, before the columns the scan does not output are dropped */
+  Schema table_schema_;
+
   /** The table function */
   std::function<Tuple(std::size_t)> func_;
 
@@ -79,6 +90,9 @@ class MockScanExecutor : public AbstractExecutor {
 
   /** The shuffled output */
   std::vector<size_t> shuffled_idx_;
+
+  /** The runtime filters pushed down from the hash joins above */
+  ScanRuntimeFilters runtime_filters_;
 };
 
 }  // namespace bustub
@@ -17,6 +17,7 @@
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expressions/compiled_expression.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "storage/table/tuple.h"
@@ -47,6 +48,18 @@ class ProjectionExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the projection.
+   * @param[out] tuples The next tuples produced by the projection
+   * @param[out] rids The RIDs of the produced tuples
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** Tell the child that no more tuples are needed */
+  void Close() override { child_executor_->Close(); }
+
   /** @return The output schema for the projection plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -56,5 +69,11 @@ class ProjectionExecutor : public AbstractExecutor {
 
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The batch of input tuples, reused across NextBatch() calls */
+  std::vector<Tuple> child_tuples_;
+  /** The compiled form of each expression, nullptr for column references and expressions that cannot be compiled */
+  std::vector<std::unique_ptr<CompiledExpression>> compiled_exprs_;
+  /** The values of each compiled expression over the current batch */
+  std::vector<std::vector<Value>> compiled_values_;
 };
 }  // namespace bustub
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// repartition_executor.h
+//
+// Identification: src/include/execution/executors/repartition_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/repartition_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * RepartitionExecutor is the exchange between the workers of a parallel plan fragment. Each copy drains its child,
+ * hands every tuple to the worker owning its hash partition, and then yields the tuples it was handed by all copies.
+ */
+class RepartitionExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new RepartitionExecutor instance.
+   * @param exec_ctx The executor context, which must belong to a worker of a parallel plan fragment
+   * @param plan The repartition plan to be executed
+   * @param child_executor The child executor from which tuples are obtained
+   */
+  RepartitionExecutor(ExecutorContext *exec_ctx, const RepartitionPlanNode *plan,
+                      std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the repartition, exchanging the tuples with the other workers */
+  void Init() override;
+
+  /**
+   * Yield the next tuple of the partition of this worker.
+   * @param[out] tuple The next tuple produced by the repartition
+   * @param[out] rid The next tuple RID produced by the repartition
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch of tuples of the partition of this worker.
+   * @param[out] tuples The next tuples produced by the repartition
+   * @param[out] rids The RIDs of the produced tuples
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** @return The output schema for the repartition */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+ private:
+  /** @return The partition a tuple of the child belongs to */
+  auto PartitionOf(const Tuple &tuple, size_t num_partitions) const -> size_t;
+
+  /** The repartition plan node to be executed */
+  const RepartitionPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The tuples of the partition of this worker */
+  std::vector<Tuple> tuples_;
+  /** The next tuple to yield */
+  size_t cursor_{0};
+};
+
+}  // namespace bustub
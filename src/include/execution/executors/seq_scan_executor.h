@@ -12,11 +12,17 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expressions/compiled_expression.h"
+#include "execution/parallel_context.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "execution/runtime_filter.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -44,11 +50,43 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the sequential scan.
+   * @param[out] tuples The next tuples produced by the scan
+   * @param[out] rids The RIDs of the produced tuples
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if the scan is complete
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
+  /** @return `true` if the iterator points at a tuple, after moving on to the next morsel if needed */
+  auto HasNext() -> bool;
+
+  /** @return `true` if the tuple under the iterator is visible and satisfies the pushed-down predicate */
+  auto IsTupleSelected(const TupleMeta &meta, const Tuple &tuple) const -> bool;
+
+  /** Narrow a selected tuple of the table down to the columns the scan outputs. */
+  void Project(Tuple *tuple) const;
+
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
+  /** The table heap being scanned */
+  TableHeap *table_heap_{nullptr};
+  /** The schema of the tuples in the table heap, which the pushed-down predicate reads */
+  const Schema *table_schema_{nullptr};
+  /** The iterator over the table heap, created in Init(), or over the current morsel when running in a worker */
+  std::unique_ptr<TableIterator> iter_;
+  /** The pages shared with the other workers, nullptr when not running in a worker */
+  PageMorselQueue *morsels_{nullptr};
+  /** The compiled pushed-down predicate, nullptr if there is none or it cannot be compiled */
+  std::unique_ptr<CompiledExpression> compiled_predicate_;
+  /** The result of the compiled predicate over the current batch */
+  std::vector<uint8_t> selection_;
+  /** The runtime filters pushed down from the hash joins above */
+  ScanRuntimeFilters runtime_filters_;
 };
 }  // namespace bustub
@@ -19,12 +19,68 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/sort_key.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
+/**
+ * RunMerger merges sorted runs into one sorted stream. The next tuple is picked with a loser tree, which costs about
+ * log2(k) key comparisons per tuple for k runs, one per level between the leaf of the last winner and the root.
+ */
+class RunMerger {
+ public:
+  /**
+   * Construct a new RunMerger instance.
+   * @param runs the runs to merge, each sorted by the keys of `encoder`
+   * @param encoder the encoder of the sort keys, used to re-encode the tuples read back from the runs
+   */
+  RunMerger(const std::vector<TmpTupleFile *> &runs, SortKeyEncoder *encoder);
+
+  /**
+   * Yield the next tuple in sort order. Ties are broken in favor of the run that comes first.
+   * @param[out] tuple the next tuple
+   * @return `false` once every run is exhausted
+   */
+  auto Next(Tuple *tuple) -> bool;
+
+ private:
+  /** The read position in one run */
+  struct RunCursor {
+    TmpTupleFile *run_;
+    /** The tuples read from the run and their keys */
+    std::vector<Tuple> tuples_;
+    std::vector<SortKey> keys_;
+    size_t pos_{0};
+    bool exhausted_{false};
+  };
+
+  /** Read the next tuples of a run, once the current ones are consumed. */
+  void Refill(size_t run);
+
+  /** @return whether the head of run `a` sorts before the head of run `b`; `Size()` stands for minus infinity */
+  auto Less(size_t a, size_t b) const -> bool;
+
+  /** Play the head of a run up the tree, from its leaf to the root. */
+  void Replay(size_t run);
+
+  auto Size() const -> size_t { return cursors_.size(); }
+
+  SortKeyEncoder *encoder_;
+  std::vector<RunCursor> cursors_;
+  /** The loser tree. Node 0 holds the overall winner, the inner nodes 1..k-1 hold the loser of their match. */
+  std::vector<size_t> tree_;
+};
+
 /**
  * The SortExecutor executor executes a sort.
+ *
+ * Tuples are sorted on normalized sort keys (see SortKeyEncoder). As long as the input fits in the memory budget of
+ * the executor, it is sorted in memory, on several threads if it is large enough. Only the tuple indexes are sorted,
+ * and the tuples are handed out from the buffer in that order. Otherwise, each budget's worth of input is sorted into
+ * a run on temporary pages, and the runs are merged with a RunMerger, in several passes if there are too many runs to
+ * merge at once.
  */
 class SortExecutor : public AbstractExecutor {
  public:
@@ -50,7 +106,34 @@ class SortExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
+  /** Sort the buffered tuples, filling `order_`. */
+  void SortBuffered();
+
+  /** Sort the buffered tuples into a new run, and clear the buffer. */
+  void SpillRun();
+
+  /** Merge runs into a single run. */
+  auto MergeRuns(const std::vector<TmpTupleFile *> &runs) -> std::unique_ptr<TmpTupleFile>;
+
   /** The sort plan node to be executed */
   const SortPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The encoder of the sort keys */
+  std::unique_ptr<SortKeyEncoder> encoder_;
+
+  /** The buffered tuples, their RIDs and their sort keys */
+  std::vector<Tuple> tuples_;
+  std::vector<RID> rids_;
+  std::vector<SortKey> keys_;
+  /** The buffered tuples in sort order, as indexes in `tuples_` */
+  std::vector<uint32_t> order_;
+  /** The next tuple to emit from the buffer, an index in `order_` */
+  size_t cursor_{0};
+
+  /** The sorted runs spilled to temporary pages */
+  std::vector<std::unique_ptr<TmpTupleFile>> runs_;
+  /** The merge of the runs, if the input did not fit in memory */
+  std::unique_ptr<RunMerger> merger_;
 };
 }  // namespace bustub
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// stream_aggregation_executor.h
+//
+// Identification: src/include/execution/executors/stream_aggregation_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/stream_aggregation_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * StreamAggregationExecutor aggregates a child whose output is ordered on the group-by columns. The rows of a group
+ * arrive one after the other, so each group is emitted as soon as a row of the next group shows up, and only the
+ * running aggregates of the current group are kept.
+ */
+class StreamAggregationExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new StreamAggregationExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The stream aggregation plan to be executed
+   * @param child The child executor, ordered on the group-by columns
+   */
+  StreamAggregationExecutor(ExecutorContext *exec_ctx, const StreamAggregationPlanNode *plan,
+                            std::unique_ptr<AbstractExecutor> &&child);
+
+  /** Initialize the aggregation */
+  void Init() override;
+
+  /**
+   * Yield the next group from the aggregation.
+   * @param[out] tuple The next tuple produced by the aggregation
+   * @param[out] rid The next tuple RID produced by the aggregation, not used by aggregation
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch of groups from the aggregation.
+   * @param[out] tuples The next tuples produced by the aggregation
+   * @param[out] rids The next tuple RIDs produced by the aggregation, not used by aggregation
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** Tell the child that no more tuples are needed */
+  void Close() override { child_->Close(); }
+
+  /** @return The output schema for the aggregation */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+ private:
+  /**
+   * Produce the next group, or, for an aggregation without GROUP BY over an empty input, the single row of initial
+   * aggregate values.
+   */
+  auto NextGroup(Tuple *tuple) -> bool;
+
+  /** Make the row at `cursor_` the first row of the current group. */
+  void StartGroup();
+
+  /** Fold the row at `cursor_` into the running aggregates of the current group. */
+  void Combine();
+
+  /** @return the output tuple of the current group */
+  auto GroupTuple() const -> Tuple;
+
+  /** The stream aggregation plan node */
+  const StreamAggregationPlanNode *plan_;
+  /** The child executor, ordered on the group-by columns */
+  std::unique_ptr<AbstractExecutor> child_;
+
+  /** The current batch of the child, and the next row of it to aggregate */
+  std::vector<Tuple> input_;
+  std::vector<RID> input_rids_;
+  size_t cursor_{0};
+  /** Whether the child is exhausted */
+  bool child_done_{false};
+
+  /** Whether a group is being aggregated, with its normalized key, group-by values and running aggregates */
+  bool has_group_{false};
+  std::string group_key_;
+  std::vector<Value> group_values_;
+  std::vector<Value> aggregates_;
+  /** Whether some row has been emitted */
+  bool emitted_{false};
+
+  /** Scratch space for the group-by values and normalized key of the row at `cursor_` */
+  std::vector<Value> row_values_;
+  std::string key_;
+};
+
+}  // namespace bustub
@@ -20,12 +20,15 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/topn_plan.h"
+#include "execution/sort_key.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * The TopNExecutor executor executes a topn.
+ * The TopNExecutor executor executes a topn. It keeps the first N tuples seen so far in a max-heap ordered on the same
+ * normalized sort keys as SortExecutor, so that each input tuple costs one key comparison with the heap top unless it
+ * makes it into the heap.
  */
 class TopNExecutor : public AbstractExecutor {
  public:
@@ -59,9 +62,21 @@ class TopNExecutor : public AbstractExecutor {
   auto GetNumInHeap() -> size_t;
 
  private:
+  /** A tuple in the heap. The sequence number breaks ties between equal keys in favor of the earliest tuple. */
+  struct HeapEntry {
+    SortKey key_;
+    size_t seq_;
+    Tuple tuple_;
+    RID rid_;
+  };
+
   /** The topn plan node to be executed */
   const TopNPlanNode *plan_;
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The best tuples seen so far, a max-heap while the input is consumed and sorted once it is */
+  std::vector<HeapEntry> heap_;
+  /** The next tuple to emit, an index in `heap_` */
+  size_t cursor_{0};
 };
 }  // namespace bustub
@@ -0,0 +1,163 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.h
+//
+// Identification: src/include/execution/expressions/compiled_expression.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/tuple.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * CompiledExpression is an expression tree flattened into register-based bytecode.
+ *
+ * Evaluating an AbstractExpression walks the tree with a virtual call per node and materializes a Value at every
+ * level. A compiled expression instead reads fixed-length columns straight out of the tuple data, keeps intermediates
+ * as 64-bit integers with a null flag, and runs each instruction over a whole batch of tuples before moving to the
+ * next one.
+ *
+ * Only integer and boolean column values, constants, arithmetic, comparisons and logic operators are compiled. For
+ * anything else, Compile() returns nullptr and the caller should keep evaluating the expression tree.
+ */
+class CompiledExpression {
+ public:
+  /**
+   * Compile an expression evaluated against tuples of one schema, as in AbstractExpression::Evaluate.
+   * @param expr the expression to compile
+   * @param schema the schema of the input tuples
+   * @return the compiled expression, or nullptr if the expression cannot be compiled
+   */
+  static auto Compile(const AbstractExpressionRef &expr, const Schema &schema) -> std::unique_ptr<CompiledExpression>;
+
+  /**
+   * Compile an expression evaluated against a pair of tuples, as in AbstractExpression::EvaluateJoin.
+   * @param expr the expression to compile
+   * @param left_schema the schema of the left tuples
+   * @param right_schema the schema of the right tuples
+   * @return the compiled expression, or nullptr if the expression cannot be compiled
+   */
+  static auto CompileJoin(const AbstractExpressionRef &expr, const Schema &left_schema, const Schema &right_schema)
+      -> std::unique_ptr<CompiledExpression>;
+
+  /** @return the value obtained by evaluating the tuple */
+  auto Evaluate(const Tuple *tuple) -> Value;
+
+  /** @return the value obtained by evaluating a pair of joined tuples */
+  auto EvaluateJoin(const Tuple *left_tuple, const Tuple *right_tuple) -> Value;
+
+  /**
+   * Evaluate the expression over a batch of tuples.
+   * @param tuples the input tuples
+   * @param[out] values the value obtained for each tuple
+   */
+  void EvaluateBatch(const std::vector<Tuple> &tuples, std::vector<Value> *values);
+
+  /**
+   * Evaluate a predicate over a batch of tuples.
+   * @param tuples the input tuples
+   * @param[out] selection 1 for each tuple the predicate is true on, 0 if it is false or NULL
+   * @return the number of selected tuples
+   */
+  auto SelectBatch(const std::vector<Tuple> &tuples, std::vector<uint8_t> *selection) -> size_t;
+
+  /**
+   * Evaluate a join predicate between one left tuple and a batch of right tuples.
+   * @param left_tuple the left tuple
+   * @param right_tuples the right tuples
+   * @param[out] selection 1 for each right tuple the predicate is true on, 0 if it is false or NULL
+   * @return the number of selected right tuples
+   */
+  auto SelectJoinBatch(const Tuple *left_tuple, const std::vector<Tuple> &right_tuples,
+                       std::vector<uint8_t> *selection) -> size_t;
+
+ private:
+  /** The operations of the bytecode. Every operation writes one register for each tuple of the batch. */
+  enum class OpCode : uint8_t {
+    LoadTinyInt,
+    LoadSmallInt,
+    LoadInteger,
+    LoadBigInt,
+    LoadBoolean,
+    LoadConstant,
+    Plus,
+    Minus,
+    Equal,
+    NotEqual,
+    LessThan,
+    LessThanOrEqual,
+    GreaterThan,
+    GreaterThanOrEqual,
+    And,
+    Or
+  };
+
+  /** One bytecode instruction */
+  struct Instruction {
+    OpCode op_;
+    /** The register written by the instruction */
+    uint32_t dst_{0};
+    /** The operand registers of binary operations */
+    uint32_t lhs_{0};
+    uint32_t rhs_{0};
+    /** The side of the join and the offset in the tuple data that loads read from */
+    uint32_t tuple_idx_{0};
+    uint32_t offset_{0};
+    /** The value and nullness of LoadConstant */
+    int64_t constant_{0};
+    bool constant_is_null_{false};
+  };
+
+  CompiledExpression() = default;
+
+  /**
+   * Emit the instructions computing an expression, children first.
+   * @return the register holding the result, or -1 if the expression cannot be compiled
+   */
+  auto Emit(const AbstractExpression &expr, const Schema &left_schema, const Schema *right_schema) -> int64_t;
+
+  /** Run the bytecode over `count` tuples, whose data pointers are in `left_data_` and `right_data_`. */
+  void Run(size_t count);
+
+  /** @return the result register of the i-th tuple of the last run as a Value */
+  auto ResultAt(size_t i) const -> Value;
+
+  /** Fill `selection` from the result register of the last run. */
+  auto Select(size_t count, std::vector<uint8_t> *selection) const -> size_t;
+
+  /** The bytecode, in evaluation order */
+  std::vector<Instruction> instructions_;
+  /** The number of registers used by the bytecode */
+  uint32_t num_registers_{0};
+  /** The register holding the result */
+  uint32_t result_{0};
+  /** The type of the result */
+  TypeId ret_type_{TypeId::INVALID};
+
+  /** The number of tuples the register file is sized for */
+  size_t capacity_{0};
+  /** Register values, `capacity_` slots per register */
+  std::vector<int64_t> values_;
+  /** Register null flags, `capacity_` slots per register */
+  std::vector<uint8_t> nulls_;
+  /** The data of the left (or only) tuple of each slot */
+  std::vector<const char *> left_data_;
+  /** The data of the right tuple of each slot */
+  std::vector<const char *> right_data_;
+};
+
+}  // namespace bustub
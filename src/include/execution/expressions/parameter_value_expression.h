@@ -0,0 +1,51 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parameter_value_expression.h
+//
+// Identification: src/include/execution/expressions/parameter_value_expression.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "fmt/format.h"
+
+namespace bustub {
+/**
+ * ParameterValueExpression represents a `$n` parameter of a prepared statement. Its value is read from the parameter
+ * values the prepared statement shares with all its parameter expressions, which EXECUTE sets before running the plan.
+ */
+class ParameterValueExpression : public AbstractExpression {
+ public:
+  /** Creates a new parameter expression reading the `param_idx`-th of the given parameter values. */
+  ParameterValueExpression(uint32_t param_idx, TypeId ret_type, std::shared_ptr<const std::vector<Value>> params)
+      : AbstractExpression({}, ret_type), param_idx_(param_idx), params_(std::move(params)) {}
+
+  auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override { return (*params_)[param_idx_]; }
+
+  auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
+                    const Schema &right_schema) const -> Value override {
+    return (*params_)[param_idx_];
+  }
+
+  /** @return the string representation of the plan node and its children */
+  auto ToString() const -> std::string override { return fmt::format("${}", param_idx_ + 1); }
+
+  BUSTUB_EXPR_CLONE_WITH_CHILDREN(ParameterValueExpression);
+
+  /** The index of the parameter, starting at 0 for `$1` */
+  uint32_t param_idx_;
+  /** The parameter values of the prepared statement */
+  std::shared_ptr<const std::vector<Value>> params_;
+};
+}  // namespace bustub
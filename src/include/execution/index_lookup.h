@@ -0,0 +1,56 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_lookup.h
+//
+// Identification: src/include/execution/index_lookup.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/schema.h"
+#include "common/rid.h"
+#include "concurrency/transaction.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/** @return whether `a` comes before `b` in page order, that is by page, and by slot within a page */
+inline auto RidLess(const RID &a, const RID &b) -> bool { return a.Get() < b.Get(); }
+
+/**
+ * Look up keys in an index.
+ * @param index_info The index to look the keys up in
+ * @param keys The keys to look up, which evaluate without a tuple
+ * @param txn The transaction the lookups run in
+ * @param in_page_order Whether to sort the RIDs in page order and drop the duplicates of a key looked up twice
+ * @return the RIDs of the tuples with any of the keys, in the order of the keys unless `in_page_order`
+ */
+auto LookUpIndexKeys(const IndexInfo &index_info, const std::vector<AbstractExpressionRef> &keys, Transaction *txn,
+                     bool in_page_order) -> std::vector<RID>;
+
+/**
+ * Read the tuples of the RIDs an index lookup found, keeping the visible ones that satisfy the predicate of the scan.
+ * The predicate may drop every tuple, in which case a scan producing batches reads on with the RIDs that come next.
+ * @param table_heap The table heap the tuples are read from
+ * @param lookup_rids The RIDs of the tuples to read
+ * @param in_page_order Whether the RIDs are in page order, which reads each heap page once for all its tuples
+ * @param predicate The predicate of the scan, or nullptr
+ * @param schema The schema the predicate is evaluated against
+ * @param[out] tuples The selected tuples, appended to
+ * @param[out] rids The RIDs of the selected tuples, appended to
+ */
+void ReadSelectedTuples(TableHeap *table_heap, const std::vector<RID> &lookup_rids, bool in_page_order,
+                        const AbstractExpressionRef &predicate, const Schema &schema, std::vector<Tuple> *tuples,
+                        std::vector<RID> *rids);
+
+}  // namespace bustub
@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_util.h
+//
+// Identification: src/include/execution/join_util.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "catalog/schema.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * Make an output tuple of a join, the columns of the left tuple followed by those of the right one.
+ * @param left The left tuple
+ * @param left_schema The schema of the left tuple
+ * @param right The right tuple, or nullptr to pad a left tuple that matched nothing with NULLs
+ * @param right_schema The schema of the right tuple
+ * @param out_schema The output schema of the join
+ * @return the joined tuple
+ */
+auto MakeJoinOutputTuple(const Tuple &left, const Schema &left_schema, const Tuple *right, const Schema &right_schema,
+                         const Schema &out_schema) -> Tuple;
+
+}  // namespace bustub
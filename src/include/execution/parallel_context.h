@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_context.h
+//
+// Identification: src/include/execution/parallel_context.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/table_iterator.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+class AbstractPlanNode;
+
+/**
+ * RowMorselQueue hands out consecutive row ranges of an input whose size is known upfront, such as a mock table.
+ */
+class RowMorselQueue {
+ public:
+  explicit RowMorselQueue(size_t size) : size_(size) {}
+
+  /**
+   * Claim the next morsel.
+   * @param[out] begin the first row of the morsel
+   * @param[out] end one past the last row of the morsel
+   * @return `false` if the input is exhausted
+   */
+  auto Next(size_t *begin, size_t *end) -> bool {
+    auto morsel_begin = next_.fetch_add(BUSTUB_MORSEL_SIZE);
+    if (morsel_begin >= size_) {
+      return false;
+    }
+    *begin = morsel_begin;
+    *end = std::min(size_, morsel_begin + BUSTUB_MORSEL_SIZE);
+    return true;
+  }
+
+ private:
+  const size_t size_;
+  std::atomic<size_t> next_{0};
+};
+
+/**
+ * PageMorselQueue hands out the pages of a table heap one at a time. Like TableHeap::MakeIterator(), it stops at the
+ * last tuple that existed when the queue was created.
+ */
+class PageMorselQueue {
+ public:
+  PageMorselQueue(TableHeap *table_heap, BufferPoolManager *bpm);
+
+  /** @return an iterator over the tuples of the next page, or std::nullopt if the table is exhausted */
+  auto Next() -> std::optional<TableIterator>;
+
+ private:
+  TableHeap *table_heap_;
+  BufferPoolManager *bpm_;
+  std::mutex latch_;
+  /** The next page to hand out, protected by latch_ */
+  page_id_t next_page_id_;
+  /** The last page to scan and its number of tuples when the queue was created */
+  page_id_t last_page_id_;
+  uint32_t last_page_tuples_{0};
+};
+
+/**
+ * RepartitionState is the meeting point of the workers of a repartition exchange. Every worker partitions its share
+ * of the input, hands it over, and then reads back the partition numbered after itself once all workers are done.
+ */
+class RepartitionState {
+ public:
+  explicit RepartitionState(size_t parallelism) : partitions_(parallelism) {}
+
+  /** Add the tuples of one producer, which must hold one vector per partition. */
+  void Produce(std::vector<std::vector<Tuple>> &&partitions);
+
+  /**
+   * Wait for every producer, then take a partition.
+   * @param partition the partition to take
+   * @param[out] tuples the tuples of the partition
+   * @return `false` if the query was aborted while waiting
+   */
+  auto Consume(size_t partition, std::vector<Tuple> *tuples) -> bool;
+
+  /** Wake up the waiting consumers of an aborted query. */
+  void Abort();
+
+ private:
+  std::mutex latch_;
+  std::condition_variable cv_;
+  std::vector<std::vector<Tuple>> partitions_;
+  size_t producers_done_{0};
+  bool aborted_{false};
+};
+
+/**
+ * ParallelContext is shared by the workers that run copies of the same plan fragment. It owns the morsel queues and
+ * exchange states of the fragment, keyed by the plan node they belong to, so that the copies of a scan split the
+ * input instead of each reading all of it.
+ */
+class ParallelContext {
+ public:
+  explicit ParallelContext(size_t parallelism) : parallelism_(parallelism) {}
+
+  /** @return the number of workers running the fragment */
+  auto GetParallelism() const -> size_t { return parallelism_; }
+
+  /** @return the morsel queue of a scan over `size` rows, created on first use */
+  auto GetRowMorselQueue(const AbstractPlanNode *plan, size_t size) -> RowMorselQueue *;
+
+  /** @return the morsel queue of a scan over a table heap, created on first use */
+  auto GetPageMorselQueue(const AbstractPlanNode *plan, TableHeap *table_heap, BufferPoolManager *bpm)
+      -> PageMorselQueue *;
+
+  /** @return the state of a repartition exchange, created on first use */
+  auto GetRepartitionState(const AbstractPlanNode *plan) -> RepartitionState *;
+
+  /** Abort the fragment, waking up every worker blocked on an exchange. */
+  void Abort();
+
+ private:
+  const size_t parallelism_;
+  std::mutex latch_;
+  std::unordered_map<const AbstractPlanNode *, std::unique_ptr<RowMorselQueue>> row_morsel_queues_;
+  std::unordered_map<const AbstractPlanNode *, std::unique_ptr<PageMorselQueue>> page_morsel_queues_;
+  std::unordered_map<const AbstractPlanNode *, std::unique_ptr<RepartitionState>> repartition_states_;
+  bool aborted_{false};
+};
+
+}  // namespace bustub
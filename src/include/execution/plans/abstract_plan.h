@@ -34,21 +34,27 @@ namespace bustub {
 enum class PlanType {
   SeqScan,
   IndexScan,
+  IndexMergeScan,
   Insert,
   Update,
   Delete,
   Aggregation,
+  StreamAggregation,
   Limit,
   NestedLoopJoin,
+  BlockNestedLoopJoin,
   NestedIndexJoin,
   HashJoin,
+  MergeJoin,
   Filter,
   Values,
   Projection,
   Sort,
   TopN,
   MockScan,
-  InitCheck
+  InitCheck,
+  Gather,
+  Repartition
 };
 
 class AbstractPlanNode;
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// block_nested_loop_join_plan.h
+//
+// Identification: src/include/execution/plans/block_nested_loop_join_plan.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "binder/table_ref/bound_join_ref.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "fmt/core.h"
+
+namespace bustub {
+
+/**
+ * BlockNestedLoopJoinPlanNode joins tuples from two child plan nodes on any predicate, like NestedLoopJoinPlanNode,
+ * but reads its right child only once: the right tuples are materialized, and every block of left tuples is joined
+ * with all of them. The output is in no particular order.
+ */
+class BlockNestedLoopJoinPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new BlockNestedLoopJoinPlanNode instance.
+   * @param output_schema The output schema of the join, the left columns followed by the right ones
+   * @param left The left child, read a block at a time
+   * @param right The right child, materialized once
+   * @param predicate The predicate to join with, the tuples are joined if predicate(left, right) = true
+   * @param join_type The join type, INNER or LEFT
+   */
+  BlockNestedLoopJoinPlanNode(SchemaRef output_schema, AbstractPlanNodeRef left, AbstractPlanNodeRef right,
+                              AbstractExpressionRef predicate, JoinType join_type)
+      : AbstractPlanNode(std::move(output_schema), {std::move(left), std::move(right)}),
+        predicate_(std::move(predicate)),
+        join_type_(join_type) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::BlockNestedLoopJoin; }
+
+  /** @return The predicate to be used in the join */
+  auto Predicate() const -> const AbstractExpressionRef & { return predicate_; }
+
+  /** @return The join type used in the join */
+  auto GetJoinType() const -> JoinType { return join_type_; };
+
+  /** @return The left plan node of the join */
+  auto GetLeftPlan() const -> AbstractPlanNodeRef { return GetChildAt(0); }
+
+  /** @return The right plan node of the join */
+  auto GetRightPlan() const -> AbstractPlanNodeRef { return GetChildAt(1); }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(BlockNestedLoopJoinPlanNode);
+
+  /** The join predicate */
+  AbstractExpressionRef predicate_;
+
+  /** The join type */
+  JoinType join_type_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override {
+    return fmt::format("BlockNestedLoopJoin {{ type={}, predicate={} }}", join_type_, predicate_);
+  }
+};
+
+}  // namespace bustub
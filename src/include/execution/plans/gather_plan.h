@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_plan.h
+//
+// Identification: src/include/execution/plans/gather_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "execution/plans/abstract_plan.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/**
+ * The GatherPlanNode runs several copies of its child plan on worker threads and merges their output. Scans in the
+ * child plan split their input between the copies in morsels, and repartition exchanges in the child plan route
+ * tuples between the copies.
+ */
+class GatherPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new GatherPlanNode instance.
+   * @param output The output schema of the gather node, the same as the child's
+   * @param child The plan fragment run by every worker
+   * @param parallelism The number of workers
+   */
+  GatherPlanNode(SchemaRef output, AbstractPlanNodeRef child, size_t parallelism)
+      : AbstractPlanNode(std::move(output), {std::move(child)}), parallelism_{parallelism} {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::Gather; }
+
+  /** @return The number of workers */
+  auto GetParallelism() const -> size_t { return parallelism_; }
+
+  /** @return The child plan node */
+  auto GetChildPlan() const -> AbstractPlanNodeRef {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Gather should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(GatherPlanNode);
+
+  /** The number of workers */
+  size_t parallelism_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override {
+    return fmt::format("Gather {{ parallelism={} }}", parallelism_);
+  }
+};
+
+}  // namespace bustub
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -76,6 +77,9 @@ class HashJoinPlanNode : public AbstractPlanNode {
   /** The join type */
   JoinType join_type_;
 
+  /** The runtime filter built over the right join keys for the scans of the left side, if it was pushed down */
+  std::optional<size_t> runtime_filter_id_;
+
  protected:
   auto PlanNodeToString() const -> std::string override;
 };
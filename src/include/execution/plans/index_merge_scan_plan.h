@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_merge_scan_plan.h
+//
+// Identification: src/include/execution/plans/index_merge_scan_plan.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/** IndexMergeType is how an index merge scan combines the RIDs found in each of its indexes. */
+enum class IndexMergeType { Intersect, Union };
+
+/** The keys an index merge scan looks up in one of its indexes, which match the tuples with any of them. */
+struct IndexLookup {
+  /** The index on one column of the table */
+  index_oid_t index_oid_;
+  /** The keys to look up, which evaluate without a tuple */
+  std::vector<AbstractExpressionRef> keys_;
+};
+
+/**
+ * The IndexMergeScanPlanNode looks up keys in several indexes on the same table, intersects or unions the sorted RID
+ * sets they produce, and only reads the surviving tuples, a heap page at a time. It answers `a = 1 AND b = 2` with an
+ * index on each column by intersection, and `a = 1 OR b = 2` by union.
+ */
+class IndexMergeScanPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new IndexMergeScanPlanNode instance.
+   * @param output The output schema of the scan, the same as a sequential scan of the table
+   * @param table_oid The identifier of the table to be scanned
+   * @param table_name The name of the table
+   * @param lookups The keys to look up in each index, at least two of them
+   * @param merge_type Whether a tuple must be found in all of the indexes or in any of them
+   * @param filter_predicate The predicate the tuples read must satisfy, or nullptr
+   */
+  IndexMergeScanPlanNode(SchemaRef output, table_oid_t table_oid, std::string table_name,
+                         std::vector<IndexLookup> lookups, IndexMergeType merge_type,
+                         AbstractExpressionRef filter_predicate)
+      : AbstractPlanNode(std::move(output), {}),
+        table_oid_(table_oid),
+        table_name_(std::move(table_name)),
+        lookups_(std::move(lookups)),
+        merge_type_(merge_type),
+        filter_predicate_(std::move(filter_predicate)) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::IndexMergeScan; }
+
+  /** @return The identifier of the table that should be scanned */
+  auto GetTableOid() const -> table_oid_t { return table_oid_; }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(IndexMergeScanPlanNode);
+
+  /** The table whose tuples should be scanned */
+  table_oid_t table_oid_;
+
+  /** The table name */
+  std::string table_name_;
+
+  /** The keys to look up in each index */
+  std::vector<IndexLookup> lookups_;
+
+  /** How the RIDs found in each index are combined */
+  IndexMergeType merge_type_;
+
+  /** The predicate the tuples read must satisfy, nullptr if every tuple is kept */
+  AbstractExpressionRef filter_predicate_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
+
+template <>
+struct fmt::formatter<bustub::IndexMergeType> : formatter<string_view> {
+  template <typename FormatContext>
+  auto format(bustub::IndexMergeType c, FormatContext &ctx) const {
+    string_view name = c == bustub::IndexMergeType::Intersect ? "Intersect" : "Union";
+    return formatter<string_view>::format(name, ctx);
+  }
+};
@@ -14,6 +14,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
@@ -22,16 +23,28 @@
 namespace bustub {
 /**
  * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
+ *
+ * Without lookup keys, the scan walks the whole index in key order. With lookup keys, it only reads the tuples whose
+ * index key equals one of them. When the output order does not matter, the scan can sort the RIDs it gets from the
+ * index by page before reading the tuples, so that each heap page is fetched once instead of once per tuple on it.
  */
 class IndexScanPlanNode : public AbstractPlanNode {
  public:
   /**
    * Creates a new index scan plan node.
    * @param output the output format of this scan plan node
-   * @param table_oid the identifier of table to be scanned
+   * @param index_oid the identifier of the index to be scanned
+   * @param pred_keys the keys to look up, or empty to scan the whole index
+   * @param filter_predicate the predicate the tuples read must satisfy, or nullptr
+   * @param sort_rids whether to read the tuples in RID order rather than in index order
    */
-  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
-      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, std::vector<AbstractExpressionRef> pred_keys = {},
+                    AbstractExpressionRef filter_predicate = nullptr, bool sort_rids = false)
+      : AbstractPlanNode(std::move(output), {}),
+        index_oid_(index_oid),
+        pred_keys_(std::move(pred_keys)),
+        filter_predicate_(std::move(filter_predicate)),
+        sort_rids_(sort_rids) {}
 
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
@@ -43,12 +56,17 @@ class IndexScanPlanNode : public AbstractPlanNode {
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
 
-  // Add anything you want here for index lookup
+  /** The keys to look up in the index, which evaluate without a tuple. The whole index is scanned if empty. */
+  std::vector<AbstractExpressionRef> pred_keys_;
+
+  /** The predicate the tuples read must satisfy, nullptr if every tuple is kept */
+  AbstractExpressionRef filter_predicate_;
+
+  /** Whether the tuples are read in RID order, a page at a time, instead of in index order */
+  bool sort_rids_;
 
  protected:
-  auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
-  }
+  auto PlanNodeToString() const -> std::string override;
 };
 
 }  // namespace bustub
@@ -14,10 +14,12 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/runtime_filter.h"
 
 namespace bustub {
 
@@ -43,8 +45,14 @@ class MockScanPlanNode : public AbstractPlanNode {
 
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(MockScanPlanNode);
 
+  /** The runtime filters of the hash joins this scan is on the probe side of */
+  std::vector<RuntimeFilterProbe> runtime_filters_;
+
+  /** The columns of the mock table the scan outputs, in order, or empty for all of them */
+  std::vector<uint32_t> column_ids_;
+
  protected:
-  auto PlanNodeToString() const -> std::string override { return fmt::format("MockScan {{ table={} }}", table_); }
+  auto PlanNodeToString() const -> std::string override;
 
  private:
   /** The table name of this mock scan executor */
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// repartition_plan.h
+//
+// Identification: src/include/execution/plans/repartition_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * The RepartitionPlanNode is an exchange between the workers below a Gather. Every worker hashes the tuples it reads
+ * from its copy of the child on the partition keys, and then continues with the tuples of one hash partition, so that
+ * tuples with equal keys end up in the same worker.
+ */
+class RepartitionPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new RepartitionPlanNode instance.
+   * @param output The output schema of the repartition node, the same as the child's
+   * @param child The child plan from which tuples are obtained
+   * @param partition_bys The expressions tuples are hashed on
+   */
+  RepartitionPlanNode(SchemaRef output, AbstractPlanNodeRef child, std::vector<AbstractExpressionRef> partition_bys)
+      : AbstractPlanNode(std::move(output), {std::move(child)}), partition_bys_(std::move(partition_bys)) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::Repartition; }
+
+  /** @return The expressions tuples are hashed on */
+  auto GetPartitionBys() const -> const std::vector<AbstractExpressionRef> & { return partition_bys_; }
+
+  /** @return The child plan node */
+  auto GetChildPlan() const -> AbstractPlanNodeRef {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Repartition should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(RepartitionPlanNode);
+
+  /** The expressions tuples are hashed on */
+  std::vector<AbstractExpressionRef> partition_bys_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -15,12 +15,14 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "binder/table_ref/bound_base_table_ref.h"
 #include "catalog/catalog.h"
 #include "catalog/schema.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/runtime_filter.h"
 
 namespace bustub {
 
@@ -62,13 +64,17 @@ class SeqScanPlanNode : public AbstractPlanNode {
   */
   AbstractExpressionRef filter_predicate_;
 
+  /** The runtime filters of the hash joins this scan is on the probe side of */
+  std::vector<RuntimeFilterProbe> runtime_filters_;
+
+  /**
+   * The columns of the table the scan outputs, in order, or empty for all of them. The filter predicate reads the
+   * columns of the table, as it is checked before the others are dropped.
+   */
+  std::vector<uint32_t> column_ids_;
+
  protected:
-  auto PlanNodeToString() const -> std::string override {
-    if (filter_predicate_) {
-      return fmt::format("SeqScan {{ table={}, filter={} }}", table_name_, filter_predicate_);
-    }
-    return fmt::format("SeqScan {{ table={} }}", table_name_);
-  }
+  auto PlanNodeToString() const -> std::string override;
 };
 
 }  // namespace bustub
@@ -0,0 +1,42 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// stream_aggregation_plan.h
+//
+// Identification: src/include/execution/plans/stream_aggregation_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "execution/plans/aggregation_plan.h"
+
+namespace bustub {
+
+/**
+ * StreamAggregationPlanNode is an aggregation over a child whose output is ordered on the group-by columns, so that
+ * the rows of each group arrive one after the other. It only holds the running aggregates of the current group.
+ */
+class StreamAggregationPlanNode : public AggregationPlanNode {
+ public:
+  /**
+   * Construct a new StreamAggregationPlanNode from the aggregation it replaces.
+   * @param plan The aggregation, whose child must be ordered on its group-by columns
+   */
+  explicit StreamAggregationPlanNode(const AggregationPlanNode &plan) : AggregationPlanNode(plan) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::StreamAggregation; }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(StreamAggregationPlanNode);
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter.h
+//
+// Identification: src/include/execution/runtime_filter.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/rid.h"
+#include "common/util/hash_util.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class ExecutorContext;
+
+/** A runtime filter pushed down to a scan: which filter to check, and how to compute its join key from a scan row */
+struct RuntimeFilterProbe {
+  /** The identifier of the filter, unique within a plan */
+  size_t filter_id_;
+  /** The join key expressions over the output of the scan, in the order of the join keys */
+  std::vector<AbstractExpressionRef> key_expressions_;
+};
+
+/**
+ * RuntimeFilter summarizes the join keys of the build side of a hash join, so that the scans on the probe side can
+ * drop the rows that cannot match before they flow through the operators in between.
+ *
+ * It holds the smallest and largest value of each key column, and a Bloom filter over the key hashes. Keys are added
+ * while the build side is drained, and the Bloom filter is sized in Finish(), once the number of keys is known.
+ *
+ * A filter that drops too few of the first rows it checks lets every later row through, since hashing them would only
+ * slow the scan down. A filter is checked by a single scan executor, so its counters are not synchronized.
+ */
+class RuntimeFilter {
+ public:
+  /** Add the join key of a build row, none of whose values is NULL. */
+  void Insert(const std::vector<Value> &keys);
+
+  /** Build the Bloom filter over the keys inserted so far. */
+  void Finish();
+
+  /** @return `false` if no build row has the join key of a probe row, `true` if some might */
+  auto MayContain(const std::vector<Value> &keys) -> bool;
+
+  /** @return the number of probe rows checked against the filter */
+  auto RowsChecked() const -> size_t { return rows_checked_; }
+
+  /** @return the number of probe rows the filter dropped */
+  auto RowsDropped() const -> size_t { return rows_dropped_; }
+
+ private:
+  /**
+   * @return the hash of a join key. HashUtil::HashValue() is linear in the bits of a value, so keys that differ in a
+   * few bits often collide, which the hash table sorts out by comparing keys but a Bloom filter cannot.
+   */
+  static auto HashKeys(const std::vector<Value> &keys) -> hash_t;
+
+  /** @return whether every bit of a key hash is set in the Bloom filter */
+  auto BloomContains(hash_t hash) const -> bool;
+
+  /** The hashes of the keys inserted since the last Finish() */
+  std::vector<hash_t> hashes_;
+  /** The bounds of each key column over the build rows, empty if there are none */
+  std::vector<Value> min_;
+  std::vector<Value> max_;
+  /** The Bloom filter, a power of two of bits, empty if there are no build rows */
+  std::vector<uint64_t> bits_;
+
+  size_t rows_checked_{0};
+  size_t rows_dropped_{0};
+  /** Whether the filter still drops enough rows to be worth checking */
+  bool enabled_{true};
+};
+
+/**
+ * ScanRuntimeFilters checks the rows of a scan against the runtime filters pushed down to it. The filters are looked up
+ * in the executor context on each call, since a hash join only publishes its filter once its build side is drained,
+ * and publishes a new one whenever it is initialized again.
+ */
+class ScanRuntimeFilters {
+ public:
+  /**
+   * @param exec_ctx the executor context the joins publish their filters to
+   * @param probes the runtime filters pushed down to the scan
+   * @param schema the output schema of the scan
+   */
+  ScanRuntimeFilters(ExecutorContext *exec_ctx, const std::vector<RuntimeFilterProbe> &probes, const Schema &schema)
+      : exec_ctx_(exec_ctx), probes_(probes), schema_(schema) {}
+
+  /** @return `false` if a published filter rules the tuple out */
+  auto Selects(const Tuple &tuple) -> bool;
+
+  /** Remove the tuples of a batch that a published filter rules out, along with their RIDs. */
+  void FilterBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids);
+
+ private:
+  ExecutorContext *exec_ctx_;
+  const std::vector<RuntimeFilterProbe> &probes_;
+  const Schema &schema_;
+  /** Scratch space for the join key of a row */
+  std::vector<Value> keys_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.h
+//
+// Identification: src/include/execution/sort_key.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/compiled_expression.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** A normalized sort key. Comparing two keys with memcmp (std::string::compare) gives the ORDER BY order. */
+using SortKey = std::string;
+
+/**
+ * SortKeyEncoder turns the ORDER BY values of a tuple into a normalized sort key, so that sorting compares keys with
+ * a single memcmp instead of one virtual Value comparison per ORDER BY column.
+ *
+ * Each ORDER BY value is encoded as a null marker byte followed, for non-NULL values, by a big-endian image of the
+ * value that compares as unsigned bytes in the value order: integers have their sign bit flipped, decimals have
+ * their sign bit flipped if positive and all bits flipped if negative, and varchars have their zero bytes escaped
+ * and are terminated by two zero bytes, so that a string sorts before any longer string it is a prefix of. All the
+ * bytes of a DESC value are then inverted. NULLs sort before every other value in ascending order, and after them
+ * in descending order. A NULL of a fixed-width type is padded with zero bytes to the width of its non-NULL values, so
+ * that the keys of ORDER BY clauses over integers all have the same length.
+ *
+ * Sort() orders such fixed-length keys with an LSD radix sort, and any other keys with a comparison sort that looks
+ * at the first 8 bytes of each key as one integer before falling back to comparing whole keys. On several threads,
+ * each thread sorts a chunk of the keys, then merges its slice of the output from all the sorted chunks.
+ */
+class SortKeyEncoder {
+ public:
+  /**
+   * Construct a new SortKeyEncoder instance.
+   * @param order_bys the ORDER BY clause
+   * @param schema the schema of the tuples to encode the keys of
+   */
+  SortKeyEncoder(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys, const Schema &schema);
+
+  /** @return the sort key of a tuple */
+  auto Encode(const Tuple &tuple) const -> SortKey;
+
+  /**
+   * Encode the sort keys of a batch of tuples.
+   * @param tuples the tuples
+   * @param[out] keys the sort key of each tuple
+   */
+  void EncodeBatch(const std::vector<Tuple> &tuples, std::vector<SortKey> *keys);
+
+  /**
+   * Sort a batch of keys produced by this encoder. Equal keys keep their order in `keys`.
+   * @param keys the keys to sort
+   * @param[out] order the indexes of the keys in `keys`, in sort order
+   * @param num_threads the number of threads to sort on
+   */
+  void Sort(const std::vector<SortKey> &keys, std::vector<uint32_t> *order, size_t num_threads = 1) const;
+
+  /** @return the length of every key if the ORDER BY values are all integers, 0 otherwise */
+  auto FixedKeySize() const -> size_t { return fixed_key_size_; }
+
+  /** Append the encoding of one ORDER BY value to a key. */
+  static void AppendValue(const Value &val, bool descending, SortKey *key);
+
+ private:
+  /** Sort the key indexes in [begin, end), which must be in increasing order, on the current thread. */
+  void SortRange(const std::vector<SortKey> &keys, uint32_t *begin, uint32_t *end) const;
+
+  const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys_;
+  const Schema &schema_;
+  /** The compiled ORDER BY expressions, nullptr for the ones evaluated as expression trees */
+  std::vector<std::unique_ptr<CompiledExpression>> compiled_;
+  /** See FixedKeySize() */
+  size_t fixed_key_size_{0};
+  /** Scratch space for the values of a batch */
+  std::vector<Value> values_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/logic_expression.h"
+
+namespace bustub {
+
+/**
+ * Split an expression into the operands of its tree of `logic_type` expressions.
+ * @param expr The expression to split
+ * @param logic_type Whether to split a conjunction or a disjunction
+ * @param[out] terms The operands, appended to
+ */
+void SplitTerms(const AbstractExpressionRef &expr, LogicType logic_type, std::vector<AbstractExpressionRef> *terms);
+
+/**
+ * Split a predicate into the expressions it is the conjunction of, leaving out the TRUE constants.
+ * @param expr The predicate to split
+ * @param[out] conjuncts The conjuncts of the predicate, appended to
+ */
+void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts);
+
+/** @return the conjunction of the expressions, TRUE if there is none */
+auto MakeConjunction(const std::vector<AbstractExpressionRef> &exprs) -> AbstractExpressionRef;
+
+}  // namespace bustub
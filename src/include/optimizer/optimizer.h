@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "binder/bound_order_by.h"
 #include "catalog/catalog.h"
 #include "concurrency/transaction.h"
 #include "execution/expressions/abstract_expression.h"
@@ -19,13 +20,32 @@ namespace bustub {
  */
 class Optimizer {
  public:
-  explicit Optimizer(const Catalog &catalog, bool force_starter_rule)
-      : catalog_(catalog), force_starter_rule_(force_starter_rule) {}
+  /** The output columns a plan is ordered on, the most significant first, with their direction */
+  using Ordering = std::vector<std::pair<OrderByType, uint32_t>>;
+
+  explicit Optimizer(const Catalog &catalog, bool force_starter_rule, size_t parallelism = 1)
+      : catalog_(catalog), force_starter_rule_(force_starter_rule), parallelism_(parallelism) {}
 
   auto Optimize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
   auto OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief estimate the number of rows a plan outputs, from the statistics of the tables it reads when they have been
+   * analyzed, and from guesses otherwise.
+   */
+  auto EstimateCardinality(const AbstractPlanNodeRef &plan) -> double;
+
+  /**
+   * @brief estimate the fraction of the rows a predicate keeps, its column values referring to the output of `left`, or
+   * for a join predicate, of `left` (tuple index 0) and `right` (tuple index 1).
+   */
+  auto EstimateSelectivity(const AbstractExpressionRef &predicate, const AbstractPlanNodeRef &left,
+                           const AbstractPlanNodeRef &right = nullptr) -> double;
+
+  /** @brief estimate the number of distinct values of an output column of a plan. */
+  auto EstimateDistinctCount(const AbstractPlanNodeRef &plan, uint32_t col_idx) -> double;
+
  private:
   /**
    * @brief merge projections that do identical project.
@@ -41,6 +61,26 @@ class Optimizer {
    */
   auto OptimizeMergeFilterNLJ(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief split the predicates into conjuncts and check each of them as far down the plan as it can go: into the scan
+   * of the one table it reads, or into the lowest join having all of its columns. Equalities to a constant are carried
+   * over the equi-join conditions, so `a = b AND b = 5` also filters `a = 5` below the join.
+   */
+  auto OptimizePushDownPredicates(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief evaluate the constant subtrees of expressions and simplify their boolean algebra, dropping the comparisons
+   * others imply. A predicate found always false, or an operator left without input, is replaced by empty Values.
+   */
+  auto OptimizeSimplifyExpressions(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief reorder the relations of each tree of inner joins by their estimated cost, trying every join order of up to
+   * 10 relations and joining more greedily. The conjuncts of one relation filter it before it is joined, the others
+   * are checked by the lowest join having all of their columns.
+   */
+  auto OptimizeJoinOrder(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief optimize nested loop join into hash join.
    * In the starter code, we will check NLJs with exactly one equal condition. You can further support optimizing joins
@@ -48,6 +88,12 @@ class Optimizer {
    */
   auto OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief optimize the nested loop joins left by the other join rules into block nested loop joins, which read their
+   * right child once instead of once per left tuple.
+   */
+  auto OptimizeNLJAsBlockNLJ(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief optimize nested loop join into index join.
    */
@@ -75,6 +121,18 @@ class Optimizer {
   auto RewriteExpressionForJoin(const AbstractExpressionRef &expr, size_t left_column_cnt, size_t right_column_cnt)
       -> AbstractExpressionRef;
 
+  /**
+   * @brief collect the join keys of a predicate that is a conjunction of `<column expr> = <column expr>`, where the
+   * two columns come from different sides of the join.
+   *
+   * @param expr the join predicate
+   * @param[out] left_keys key expressions to be evaluated on the left child
+   * @param[out] right_keys key expressions to be evaluated on the right child
+   * @return false if the predicate contains anything other than such equalities
+   */
+  auto ExtractEquiJoinKeys(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *left_keys,
+                           std::vector<AbstractExpressionRef> *right_keys) -> bool;
+
   /** @brief check if the predicate is true::boolean */
   auto IsPredicateTrue(const AbstractExpressionRef &expr) -> bool;
 
@@ -83,6 +141,13 @@ class Optimizer {
    */
   auto OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief look up the keys of an equality predicate over a scanned table in an index on the compared column. The
+   * index scan reads the matching tuples a heap page at a time, since the scan they replace had no order to keep.
+   * Lookups in several indexes are intersected when they are ANDed, and united when they are ORed.
+   */
+  auto OptimizeFilterAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /** @brief check if the index can be matched */
   auto MatchIndex(const std::string &table_name, uint32_t index_key_idx)
       -> std::optional<std::tuple<index_oid_t, std::string>>;
@@ -93,20 +158,85 @@ class Optimizer {
   auto OptimizeSortLimitAsTopN(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
   /**
-   * @brief get the estimated cardinality for a table based on the table name. Useful when join reordering. BusTub
-   * doesn't support statistics for now, so it's the only way for you to get the table size :(
+   * @brief join with a MergeJoin when both inputs of a hash join are already sorted on the join keys, or when the
+   * join is sorted on its left join keys afterwards, in which case the inputs are sorted instead of the output.
+   */
+  auto OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief aggregate with a StreamAggregation when the child is already ordered on the group-by columns.
+   */
+  auto OptimizeAggAsStreamAgg(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief drop the columns no operator above reads: scans output only the columns of the table that are needed,
+   * projections and aggregations compute only what is read, and joins pass on only the columns of their children that
+   * are left. The column indexes of the expressions are rewritten to match.
+   */
+  auto OptimizeColumnPruning(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief get the ordering of the output of a plan. Rows that agree on a prefix of its columns come out one after
+   * the other. NULLs sort first in ascending order, as in SortKeyEncoder.
+   */
+  auto OutputOrdering(const AbstractPlanNodeRef &plan) -> Ordering;
+
+  /**
+   * @brief run the read-only parts of the plan on `parallelism_` workers. Scans, filters and projections above them,
+   * hash joins and grouped aggregations are put below a Gather, with Repartition exchanges routing the tuples of a
+   * join key or group to a single worker. Aggregations run in two phases: each worker pre-aggregates its input, and
+   * the partial groups are merged by partition, or above the Gather without group-bys.
+   */
+  auto OptimizeParallelize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief rewrite a plan so that running one copy of it per worker produces the original output, split between the
+   * workers.
+   * @return the rewritten plan, or nullptr if the plan cannot run in parallel
+   */
+  auto MakeParallelFragment(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief push a runtime filter from each inner hash join down to the scan its left keys come from, through filters,
+   * projections and the left side of other hash joins. The join builds the filter over its right keys before the scan
+   * produces any row. Plans below a Gather are left alone, since each worker only builds a part of the right side.
+   */
+  auto OptimizePushRuntimeFilters(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief move each limit below the projections and into the workers of the Gathers under it, so that the scans feeding
+   * them stop as soon as enough tuples are produced. A copy of the limit stays above each Gather.
+   */
+  auto OptimizePushLimits(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief get the estimated cardinality for a table, from its statistics if it has been analyzed, and from its name
+   * otherwise. Useful when join reordering.
    *
    * @param table_name
    * @return std::optional<size_t>
    */
   auto EstimatedCardinality(const std::string &table_name) -> std::optional<size_t>;
 
+  /** @brief get the cardinality a table name suggests, such as 1000 for `__mock_t_1k`. */
+  auto EstimatedCardinalityFromName(const std::string &table_name) -> std::optional<size_t>;
+
+  /**
+   * @brief estimate the fraction of the pairs of rows of `left` and `right` whose columns are equal, assuming the
+   * values of the column with fewer distinct values are all found in the other one.
+   */
+  auto EstimateEquiJoinSelectivity(const AbstractPlanNodeRef &left, uint32_t left_col_idx,
+                                   const AbstractPlanNodeRef &right, uint32_t right_col_idx) -> double;
+
   /** Catalog will be used during the planning process. USERS SHOULD ENSURE IT OUTLIVES
    * OPTIMIZER, otherwise it's a dangling reference.
    */
   const Catalog &catalog_;
 
   const bool force_starter_rule_;
+
+  /** The number of workers a query may use */
+  const size_t parallelism_;
 };
 
 }  // namespace bustub
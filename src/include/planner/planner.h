@@ -26,6 +26,7 @@ class BoundExpression;
 class BoundTableRef;
 class BoundBinaryOp;
 class BoundConstant;
+class BoundParameter;
 class BoundColumnRef;
 class BoundUnaryOp;
 class BoundBaseTableRef;
@@ -128,6 +129,9 @@ class Planner {
   auto PlanConstant(const BoundConstant &expr, const std::vector<AbstractPlanNodeRef> &children)
       -> AbstractExpressionRef;
 
+  auto PlanParameter(const BoundParameter &expr, const std::vector<AbstractPlanNodeRef> &children)
+      -> AbstractExpressionRef;
+
   auto PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRef child) -> AbstractPlanNodeRef;
 
   auto PlanAggCall(const BoundAggCall &agg_call, const std::vector<AbstractPlanNodeRef> &children)
@@ -151,6 +155,9 @@ class Planner {
   /** the root plan node of the plan tree */
   AbstractPlanNodeRef plan_;
 
+  /** the parameter values the `$n` parameters of a prepared statement are read from when the plan is executed */
+  std::shared_ptr<std::vector<Value>> parameters_{std::make_shared<std::vector<Value>>()};
+
  private:
   PlannerContext ctx_;
 
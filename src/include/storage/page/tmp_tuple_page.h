@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstring>
+
 #include "storage/page/page.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
@@ -22,15 +24,53 @@ class TmpTuplePage : public Page {
  public:
   void Init(page_id_t page_id, uint32_t page_size) {
     memcpy(GetData(), &page_id, sizeof(page_id_t));
-    memcpy(GetData() + sizeof(page_id_t), &page_size, sizeof(uint32_t));
+    SetLSN(INVALID_LSN);
+    SetFreeSpacePointer(page_size);
   }
 
-  auto GetTablePageId() -> page_id_t { return INVALID_PAGE_ID; }
+  auto GetTablePageId() -> page_id_t { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  /**
+   * Append a tuple to the page.
+   * @param tuple the tuple to append
+   * @param[out] out the location of the tuple in the page
+   * @return `false` if the page does not have room for the tuple
+   */
+  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool {
+    auto free_space_pointer = GetFreeSpacePointer();
+    auto size = static_cast<uint32_t>(sizeof(uint32_t) + tuple.GetLength());
+    if (free_space_pointer < SIZE_TMP_PAGE_HEADER + size) {
+      return false;
+    }
+    free_space_pointer -= size;
+    tuple.SerializeTo(GetData() + free_space_pointer);
+    SetFreeSpacePointer(free_space_pointer);
+    *out = TmpTuple(GetTablePageId(), free_space_pointer);
+    return true;
+  }
 
-  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool { return false; }
+  /**
+   * Read a tuple back.
+   * @param offset the offset of the tuple in the page, as returned by Insert()
+   * @param[out] tuple the tuple
+   * @return the offset of the tuple inserted right before this one, or the page size if it is the first one
+   */
+  auto Get(uint32_t offset, Tuple *tuple) -> uint32_t {
+    tuple->DeserializeFrom(GetData() + offset);
+    return offset + sizeof(uint32_t) + tuple->GetLength();
+  }
+
+  /** @return the offset of the last inserted tuple, or the page size if the page is empty */
+  auto GetFreeSpacePointer() -> uint32_t { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
 
  private:
+  void SetFreeSpacePointer(uint32_t free_space_pointer) {
+    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
+  }
+
   static_assert(sizeof(page_id_t) == 4);
+  static constexpr size_t OFFSET_FREE_SPACE = SIZE_PAGE_HEADER;
+  static constexpr size_t SIZE_TMP_PAGE_HEADER = OFFSET_FREE_SPACE + sizeof(uint32_t);
 };
 
 }  // namespace bustub
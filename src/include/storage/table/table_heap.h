@@ -12,9 +12,11 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>  // NOLINT
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "common/config.h"
@@ -27,6 +29,8 @@
 
 namespace bustub {
 
+class TableStats;
+
 /**
  * TableHeap represents a physical table on disk.
  * This is just a doubly-linked list of pages.
@@ -67,6 +71,14 @@ class TableHeap {
    */
   auto GetTuple(RID rid) -> std::pair<TupleMeta, Tuple>;
 
+  /**
+   * Read a batch of tuples from the table, fetching a page once for all the rids in a row that are on it. Sort the rids
+   * by page beforehand to fetch each page once.
+   * @param rids rids of the tuples to read
+   * @return the meta and tuple of each rid, in the same order
+   */
+  auto GetTuples(const std::vector<RID> &rids) -> std::vector<std::pair<TupleMeta, Tuple>>;
+
   /**
    * Read a tuple meta from the table. Note: if you want to get tuple and meta together, use `GetTuple` insead
    * to ensure atomicity.
@@ -84,6 +96,12 @@ class TableHeap {
   /** @return the id of the first page of this table */
   inline auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
 
+  /** @return the id of the last page of this table */
+  inline auto GetLastPageId() -> page_id_t {
+    std::scoped_lock guard(latch_);
+    return last_page_id_;
+  }
+
   /**
    * Update a tuple in place. SHOULD NOT BE USED UNLESS YOU WANT TO OPTIMIZE FOR PROJECT 4.
    * @param meta new tuple meta
@@ -92,12 +110,22 @@ class TableHeap {
    */
   void UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tuple, RID rid);
 
+  /**
+   * Keep statistics up to date with the tuples inserted, deleted and updated from now on.
+   * @param stats the statistics of this table, or nullptr to stop maintaining any
+   */
+  void SetStats(std::shared_ptr<TableStats> stats);
+
  private:
+  /** @return the statistics of this table, or nullptr if it has never been analyzed */
+  auto GetStats() -> std::shared_ptr<TableStats>;
+
   BufferPoolManager *bpm_;
   page_id_t first_page_id_{INVALID_PAGE_ID};
 
   std::mutex latch_;
   page_id_t last_page_id_{INVALID_PAGE_ID}; /* protected by latch_ */
+  std::shared_ptr<TableStats> stats_;       /* protected by latch_ */
 };
 
 }  // namespace bustub
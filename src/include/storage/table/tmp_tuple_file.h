@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.h
+//
+// Identification: src/include/storage/table/tmp_tuple_file.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "common/macros.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TmpTupleFile is a sequence of tuples spilled by an operator to temporary pages, e.g. one partition of a hash join
+ * that does not fit in memory. Tuples are appended to an in-memory TmpTuplePage, which is written out through the
+ * buffer pool once it is full, so that a file only pins a page for the duration of a copy. Once every tuple has been
+ * appended, the file is read back in the order the tuples were appended. The pages are deleted with the file.
+ */
+class TmpTupleFile {
+ public:
+  explicit TmpTupleFile(BufferPoolManager *bpm);
+
+  ~TmpTupleFile();
+
+  DISALLOW_COPY_AND_MOVE(TmpTupleFile);
+
+  /** Append a tuple to the file. */
+  void Append(const Tuple &tuple);
+
+  /** @return the number of tuples appended to the file */
+  auto Size() const -> size_t { return num_tuples_; }
+
+  /** @return the number of bytes of tuple data appended to the file */
+  auto Bytes() const -> size_t { return num_bytes_; }
+
+  /** Start reading the file from its first tuple. */
+  void Rewind();
+
+  /**
+   * Read the next tuples of the file.
+   * @param[out] tuples the tuples read
+   * @param batch_size the maximum number of tuples to read
+   * @return `false` if the whole file has been read
+   */
+  auto ReadBatch(std::vector<Tuple> *tuples, size_t batch_size) -> bool;
+
+ private:
+  /** Write the page being filled out through the buffer pool. */
+  void FlushBuffer();
+
+  /** Read the tuples of the next page into `read_buffer_`. */
+  void LoadPage(page_id_t page_id);
+
+  BufferPoolManager *bpm_;
+  /** The pages written out, in order */
+  std::vector<page_id_t> page_ids_;
+  /** The page being filled */
+  TmpTuplePage buffer_;
+  /** The number of tuples in `buffer_` */
+  size_t buffer_tuples_{0};
+  size_t num_tuples_{0};
+  size_t num_bytes_{0};
+
+  /** The next page to read, an index in `page_ids_` */
+  size_t read_page_{0};
+  /** The tuples of the page being read, in the order they were appended */
+  std::vector<Tuple> read_buffer_;
+  /** The next tuple to read, an index in `read_buffer_` */
+  size_t read_cursor_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,52 @@
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/stream_aggregation_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeAggAsStreamAgg(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeAggAsStreamAgg(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Aggregation) {
+    return optimized_plan;
+  }
+  const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+  if (agg_plan.GetGroupBys().empty()) {
+    return optimized_plan;
+  }
+  std::set<uint32_t> group_by_columns;
+  for (const auto &expr : agg_plan.GetGroupBys()) {
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+    if (column_value_expr == nullptr) {
+      return optimized_plan;
+    }
+    group_by_columns.insert(column_value_expr->GetColIdx());
+  }
+
+  // The groups are contiguous if the child is sorted on the group-by columns first, in any order
+  auto ordering = OutputOrdering(agg_plan.GetChildPlan());
+  if (ordering.size() < group_by_columns.size()) {
+    return optimized_plan;
+  }
+  std::set<uint32_t> leading_columns;
+  for (size_t i = 0; i < group_by_columns.size(); i++) {
+    leading_columns.insert(ordering[i].second);
+  }
+  if (leading_columns != group_by_columns) {
+    return optimized_plan;
+  }
+  return std::make_shared<StreamAggregationPlanNode>(agg_plan);
+}
+
+}  // namespace bustub
@@ -0,0 +1,300 @@
+#include <memory>
+#include <optional>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/block_nested_loop_join_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/stream_aggregation_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** For each output column of a plan, its index once the plan is pruned, or nullopt if it is dropped */
+using ColumnMap = std::vector<std::optional<uint32_t>>;
+
+/** A pruned plan. It keeps its columns in their order, so that the columns of the map are increasing. */
+struct PrunedPlan {
+  AbstractPlanNodeRef plan_;
+  ColumnMap columns_;
+};
+
+template <class PlanNode>
+static auto Copy(const AbstractPlanNodeRef &plan) -> std::shared_ptr<PlanNode> {
+  return std::make_shared<PlanNode>(dynamic_cast<const PlanNode &>(*plan));
+}
+
+/** @return the indexes of all the output columns of the plan */
+static auto AllColumns(const AbstractPlanNodeRef &plan) -> std::set<uint32_t> {
+  std::set<uint32_t> columns;
+  for (uint32_t i = 0; i < plan->OutputSchema().GetColumnCount(); i++) {
+    columns.insert(i);
+  }
+  return columns;
+}
+
+/** @return the schema with only the kept columns, and where each column of the schema ends up */
+static auto KeepColumns(const Schema &schema, const std::set<uint32_t> &kept) -> std::pair<SchemaRef, ColumnMap> {
+  std::vector<Column> columns;
+  ColumnMap column_map(schema.GetColumnCount());
+  for (const auto i : kept) {
+    column_map[i] = columns.size();
+    columns.push_back(schema.GetColumn(i));
+  }
+  return {std::make_shared<Schema>(columns), std::move(column_map)};
+}
+
+/** Add the columns the expression reads of tuple 0 to `left`, and those of tuple 1 to `right`. */
+static void CollectColumns(const AbstractExpressionRef &expr, std::set<uint32_t> *left, std::set<uint32_t> *right) {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    (column->GetTupleIdx() == 0 ? left : right)->insert(column->GetColIdx());
+    return;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectColumns(child, left, right);
+  }
+}
+
+/** @return the expression reading the columns of tuple 0 where `left` moved them, and those of tuple 1 by `right` */
+static auto Remap(const AbstractExpressionRef &expr, const ColumnMap &left, const ColumnMap &right)
+    -> AbstractExpressionRef {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    const auto &col_idx = (column->GetTupleIdx() == 0 ? left : right)[column->GetColIdx()];
+    BUSTUB_ASSERT(col_idx.has_value(), "a column read by the plan must be kept");
+    return std::make_shared<ColumnValueExpression>(column->GetTupleIdx(), *col_idx, column->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(Remap(child, left, right));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+static auto Prune(const AbstractPlanNodeRef &plan, std::set<uint32_t> required) -> PrunedPlan;
+
+/** @return the plan with its children pruned to what it needs, and all of its own columns kept */
+static auto KeepAll(const AbstractPlanNodeRef &plan) -> PrunedPlan {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(Prune(child, AllColumns(child)).plan_);
+  }
+  return {plan->CloneWithChildren(std::move(children)), KeepColumns(plan->OutputSchema(), AllColumns(plan)).second};
+}
+
+/** @return a plan outputting the tuples of its child as they are, with the child pruned */
+template <class PlanNode>
+static auto PrunePassThrough(const AbstractPlanNodeRef &plan, std::set<uint32_t> required) -> PrunedPlan {
+  auto pruned_plan = Copy<PlanNode>(plan);
+  if constexpr (std::is_same_v<PlanNode, FilterPlanNode>) {
+    CollectColumns(pruned_plan->predicate_, &required, &required);
+  }
+  if constexpr (std::is_same_v<PlanNode, SortPlanNode> || std::is_same_v<PlanNode, TopNPlanNode>) {
+    for (const auto &[order_by_type, expr] : pruned_plan->order_bys_) {
+      CollectColumns(expr, &required, &required);
+    }
+  }
+  auto child = Prune(plan->GetChildAt(0), std::move(required));
+  if constexpr (std::is_same_v<PlanNode, FilterPlanNode>) {
+    pruned_plan->predicate_ = Remap(pruned_plan->predicate_, child.columns_, child.columns_);
+  }
+  if constexpr (std::is_same_v<PlanNode, SortPlanNode> || std::is_same_v<PlanNode, TopNPlanNode>) {
+    for (auto &[order_by_type, expr] : pruned_plan->order_bys_) {
+      expr = Remap(expr, child.columns_, child.columns_);
+    }
+  }
+  pruned_plan->output_schema_ = child.plan_->output_schema_;
+  pruned_plan->children_ = {child.plan_};
+  return {std::move(pruned_plan), std::move(child.columns_)};
+}
+
+static auto PruneProjection(const AbstractPlanNodeRef &plan, const std::set<uint32_t> &required) -> PrunedPlan {
+  auto pruned_plan = Copy<ProjectionPlanNode>(plan);
+  std::set<uint32_t> child_required;
+  for (const auto i : required) {
+    CollectColumns(pruned_plan->expressions_[i], &child_required, &child_required);
+  }
+  auto child = Prune(plan->GetChildAt(0), std::move(child_required));
+  std::vector<AbstractExpressionRef> exprs;
+  for (const auto i : required) {
+    exprs.emplace_back(Remap(pruned_plan->expressions_[i], child.columns_, child.columns_));
+  }
+  auto [schema, columns] = KeepColumns(plan->OutputSchema(), required);
+  pruned_plan->expressions_ = std::move(exprs);
+  pruned_plan->output_schema_ = std::move(schema);
+  pruned_plan->children_ = {child.plan_};
+  return {std::move(pruned_plan), std::move(columns)};
+}
+
+/** @return the aggregation with all of its groups, but only the aggregates that are read */
+template <class PlanNode>
+static auto PruneAggregation(const AbstractPlanNodeRef &plan, const std::set<uint32_t> &required) -> PrunedPlan {
+  auto pruned_plan = Copy<PlanNode>(plan);
+  const auto group_count = pruned_plan->group_bys_.size();
+  std::set<uint32_t> kept;
+  std::set<uint32_t> child_required;
+  for (uint32_t i = 0; i < group_count; i++) {
+    kept.insert(i);
+    CollectColumns(pruned_plan->group_bys_[i], &child_required, &child_required);
+  }
+  for (const auto i : required) {
+    if (i >= group_count) {
+      kept.insert(i);
+      CollectColumns(pruned_plan->aggregates_[i - group_count], &child_required, &child_required);
+    }
+  }
+  auto child = Prune(plan->GetChildAt(0), std::move(child_required));
+  std::vector<AbstractExpressionRef> group_bys;
+  for (const auto &expr : pruned_plan->group_bys_) {
+    group_bys.emplace_back(Remap(expr, child.columns_, child.columns_));
+  }
+  std::vector<AbstractExpressionRef> aggregates;
+  std::vector<AggregationType> agg_types;
+  for (const auto i : kept) {
+    if (i >= group_count) {
+      aggregates.emplace_back(Remap(pruned_plan->aggregates_[i - group_count], child.columns_, child.columns_));
+      agg_types.push_back(pruned_plan->agg_types_[i - group_count]);
+    }
+  }
+  auto [schema, columns] = KeepColumns(plan->OutputSchema(), kept);
+  pruned_plan->group_bys_ = std::move(group_bys);
+  pruned_plan->aggregates_ = std::move(aggregates);
+  pruned_plan->agg_types_ = std::move(agg_types);
+  pruned_plan->output_schema_ = std::move(schema);
+  pruned_plan->children_ = {child.plan_};
+  return {std::move(pruned_plan), std::move(columns)};
+}
+
+/** @return the join of its children pruned to the required columns and those of the join predicate or keys */
+template <class PlanNode>
+static auto PruneJoin(const AbstractPlanNodeRef &plan, const std::set<uint32_t> &required) -> PrunedPlan {
+  constexpr bool has_keys = std::is_same_v<PlanNode, HashJoinPlanNode> || std::is_same_v<PlanNode, MergeJoinPlanNode>;
+  auto pruned_plan = Copy<PlanNode>(plan);
+  const auto left_column_count = plan->GetChildAt(0)->OutputSchema().GetColumnCount();
+  std::set<uint32_t> left_required;
+  std::set<uint32_t> right_required;
+  for (const auto i : required) {
+    if (i < left_column_count) {
+      left_required.insert(i);
+    } else {
+      right_required.insert(i - left_column_count);
+    }
+  }
+  // The keys of each side are evaluated on its own tuples, whatever tuple index they read
+  if constexpr (has_keys) {
+    for (const auto &expr : pruned_plan->left_key_expressions_) {
+      CollectColumns(expr, &left_required, &left_required);
+    }
+    for (const auto &expr : pruned_plan->right_key_expressions_) {
+      CollectColumns(expr, &right_required, &right_required);
+    }
+  } else {
+    CollectColumns(pruned_plan->predicate_, &left_required, &right_required);
+  }
+
+  auto left = Prune(plan->GetChildAt(0), std::move(left_required));
+  auto right = Prune(plan->GetChildAt(1), std::move(right_required));
+  if constexpr (has_keys) {
+    for (auto &expr : pruned_plan->left_key_expressions_) {
+      expr = Remap(expr, left.columns_, left.columns_);
+    }
+    for (auto &expr : pruned_plan->right_key_expressions_) {
+      expr = Remap(expr, right.columns_, right.columns_);
+    }
+  } else {
+    pruned_plan->predicate_ = Remap(pruned_plan->predicate_, left.columns_, right.columns_);
+  }
+
+  // The join outputs all the columns its children keep, which may be more than it needs
+  std::set<uint32_t> kept;
+  for (uint32_t i = 0; i < left.columns_.size(); i++) {
+    if (left.columns_[i].has_value()) {
+      kept.insert(i);
+    }
+  }
+  for (uint32_t i = 0; i < right.columns_.size(); i++) {
+    if (right.columns_[i].has_value()) {
+      kept.insert(left_column_count + i);
+    }
+  }
+  auto [schema, columns] = KeepColumns(plan->OutputSchema(), kept);
+  pruned_plan->output_schema_ = std::move(schema);
+  pruned_plan->children_ = {left.plan_, right.plan_};
+  return {std::move(pruned_plan), std::move(columns)};
+}
+
+/** @return the scan outputting only the required columns of the table */
+template <class PlanNode>
+static auto PruneScan(const AbstractPlanNodeRef &plan, const std::set<uint32_t> &required) -> PrunedPlan {
+  const auto &scan_plan = dynamic_cast<const PlanNode &>(*plan);
+  // The keys of the runtime filters are columns of the output
+  if (required.size() == plan->OutputSchema().GetColumnCount() || !scan_plan.runtime_filters_.empty()) {
+    return KeepAll(plan);
+  }
+  auto pruned_plan = Copy<PlanNode>(plan);
+  std::vector<uint32_t> column_ids;
+  for (const auto i : required) {
+    column_ids.push_back(scan_plan.column_ids_.empty() ? i : scan_plan.column_ids_[i]);
+  }
+  auto [schema, columns] = KeepColumns(plan->OutputSchema(), required);
+  pruned_plan->column_ids_ = std::move(column_ids);
+  pruned_plan->output_schema_ = std::move(schema);
+  return {std::move(pruned_plan), std::move(columns)};
+}
+
+/** @return the plan outputting the required columns and as few of the others as it can */
+static auto Prune(const AbstractPlanNodeRef &plan, std::set<uint32_t> required) -> PrunedPlan {
+  // Keep a column even if none is read, so that the operators above still see every row
+  if (required.empty() && plan->OutputSchema().GetColumnCount() > 0) {
+    required.insert(0);
+  }
+  switch (plan->GetType()) {
+    case PlanType::Projection:
+      return PruneProjection(plan, required);
+    case PlanType::Filter:
+      return PrunePassThrough<FilterPlanNode>(plan, std::move(required));
+    case PlanType::Sort:
+      return PrunePassThrough<SortPlanNode>(plan, std::move(required));
+    case PlanType::TopN:
+      return PrunePassThrough<TopNPlanNode>(plan, std::move(required));
+    case PlanType::Limit:
+      return PrunePassThrough<LimitPlanNode>(plan, std::move(required));
+    case PlanType::Aggregation:
+      return PruneAggregation<AggregationPlanNode>(plan, required);
+    case PlanType::StreamAggregation:
+      return PruneAggregation<StreamAggregationPlanNode>(plan, required);
+    case PlanType::NestedLoopJoin:
+      return PruneJoin<NestedLoopJoinPlanNode>(plan, required);
+    case PlanType::BlockNestedLoopJoin:
+      return PruneJoin<BlockNestedLoopJoinPlanNode>(plan, required);
+    case PlanType::HashJoin:
+      return PruneJoin<HashJoinPlanNode>(plan, required);
+    case PlanType::MergeJoin:
+      return PruneJoin<MergeJoinPlanNode>(plan, required);
+    case PlanType::SeqScan:
+      return PruneScan<SeqScanPlanNode>(plan, required);
+    case PlanType::MockScan:
+      return PruneScan<MockScanPlanNode>(plan, required);
+    default:
+      return KeepAll(plan);
+  }
+}
+
+auto Optimizer::OptimizeColumnPruning(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  return Prune(plan, AllColumns(plan)).plan_;
+}
+
+}  // namespace bustub
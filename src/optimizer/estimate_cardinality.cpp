@@ -0,0 +1,475 @@
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "catalog/catalog.h"
+#include "catalog/table_stats.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/block_nested_loop_join_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_merge_scan_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/nested_index_join_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "execution/plans/values_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** The fraction of the rows an equality on a column without statistics is assumed to select */
+static constexpr double DEFAULT_EQUAL_SELECTIVITY = 0.1;
+/** The fraction of the rows a range predicate on a column without statistics is assumed to select */
+static constexpr double DEFAULT_RANGE_SELECTIVITY = 1.0 / 3;
+/** The fraction of the rows any other predicate is assumed to select */
+static constexpr double DEFAULT_SELECTIVITY = 0.5;
+/** The number of rows of a table that has neither statistics nor a size suffix */
+static constexpr double DEFAULT_TABLE_CARDINALITY = 1000;
+
+/** The column of a table an output column of a plan is read from, with the statistics of the table */
+struct ColumnOrigin {
+  std::shared_ptr<const TableStats> stats_;
+  uint32_t col_idx_;
+};
+
+/** @return the origin of a column of a table, if the table has statistics */
+static auto TableColumn(const Catalog &catalog, table_oid_t table_oid, uint32_t col_idx)
+    -> std::optional<ColumnOrigin> {
+  auto stats = catalog.GetTableStats(table_oid);
+  if (stats == nullptr) {
+    return std::nullopt;
+  }
+  return ColumnOrigin{std::move(stats), col_idx};
+}
+
+/** @return the origin of a column of a table given by name, if the table has statistics */
+static auto TableColumn(const Catalog &catalog, const std::string &table_name, uint32_t col_idx)
+    -> std::optional<ColumnOrigin> {
+  const auto *table_info = catalog.GetTable(table_name);
+  if (table_info == Catalog::NULL_TABLE_INFO) {
+    return std::nullopt;
+  }
+  return TableColumn(catalog, table_info->oid_, col_idx);
+}
+
+/**
+ * @return the table column an output column of a plan passes on unchanged, if there is one and its table has
+ * statistics. The distribution of the column is that of the whole table, whatever the plan filtered out.
+ */
+static auto TraceColumn(const Catalog &catalog, const AbstractPlanNodeRef &plan, uint32_t col_idx)
+    -> std::optional<ColumnOrigin> {
+  /** @return the origin of the column of a join, the right columns following the left ones */
+  auto trace_join = [&](const AbstractPlanNodeRef &left, const AbstractPlanNodeRef &right) {
+    const auto left_columns = left->OutputSchema().GetColumnCount();
+    if (col_idx < left_columns) {
+      return TraceColumn(catalog, left, col_idx);
+    }
+    return TraceColumn(catalog, right, col_idx - left_columns);
+  };
+
+  switch (plan->GetType()) {
+    case PlanType::SeqScan: {
+      const auto &scan_plan = dynamic_cast<const SeqScanPlanNode &>(*plan);
+      return TableColumn(catalog, scan_plan.GetTableOid(),
+                         scan_plan.column_ids_.empty() ? col_idx : scan_plan.column_ids_[col_idx]);
+    }
+    case PlanType::MockScan: {
+      const auto &scan_plan = dynamic_cast<const MockScanPlanNode &>(*plan);
+      return TableColumn(catalog, scan_plan.GetTable(),
+                         scan_plan.column_ids_.empty() ? col_idx : scan_plan.column_ids_[col_idx]);
+    }
+    case PlanType::IndexScan: {
+      const auto *index_info = catalog.GetIndex(dynamic_cast<const IndexScanPlanNode &>(*plan).GetIndexOid());
+      if (index_info == Catalog::NULL_INDEX_INFO) {
+        return std::nullopt;
+      }
+      return TableColumn(catalog, index_info->table_name_, col_idx);
+    }
+    case PlanType::IndexMergeScan:
+      return TableColumn(catalog, dynamic_cast<const IndexMergeScanPlanNode &>(*plan).GetTableOid(), col_idx);
+    case PlanType::Filter:
+    case PlanType::Sort:
+    case PlanType::Limit:
+    case PlanType::TopN:
+    case PlanType::InitCheck:
+    case PlanType::Gather:
+    case PlanType::Repartition:
+      return TraceColumn(catalog, plan->GetChildAt(0), col_idx);
+    case PlanType::Projection: {
+      const auto &expr = dynamic_cast<const ProjectionPlanNode &>(*plan).GetExpressions()[col_idx];
+      if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+        return TraceColumn(catalog, plan->GetChildAt(0), column->GetColIdx());
+      }
+      return std::nullopt;
+    }
+    case PlanType::Aggregation:
+    case PlanType::StreamAggregation: {
+      const auto &group_bys = dynamic_cast<const AggregationPlanNode &>(*plan).GetGroupBys();
+      if (col_idx >= group_bys.size()) {
+        return std::nullopt;
+      }
+      if (const auto *column = dynamic_cast<const ColumnValueExpression *>(group_bys[col_idx].get());
+          column != nullptr) {
+        return TraceColumn(catalog, plan->GetChildAt(0), column->GetColIdx());
+      }
+      return std::nullopt;
+    }
+    case PlanType::NestedLoopJoin:
+    case PlanType::BlockNestedLoopJoin:
+    case PlanType::HashJoin:
+    case PlanType::MergeJoin:
+      return trace_join(plan->GetChildAt(0), plan->GetChildAt(1));
+    case PlanType::NestedIndexJoin: {
+      const auto &join_plan = dynamic_cast<const NestedIndexJoinPlanNode &>(*plan);
+      const auto left_columns = join_plan.GetChildPlan()->OutputSchema().GetColumnCount();
+      if (col_idx < left_columns) {
+        return TraceColumn(catalog, join_plan.GetChildPlan(), col_idx);
+      }
+      return TableColumn(catalog, join_plan.GetInnerTableOid(), col_idx - left_columns);
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+/** @return the flipped comparison, such that `a op b` is `b flipped_op a` */
+static auto FlipComparison(ComparisonType comp_type) -> ComparisonType {
+  switch (comp_type) {
+    case ComparisonType::LessThan:
+      return ComparisonType::GreaterThan;
+    case ComparisonType::LessThanOrEqual:
+      return ComparisonType::GreaterThanOrEqual;
+    case ComparisonType::GreaterThan:
+      return ComparisonType::LessThan;
+    case ComparisonType::GreaterThanOrEqual:
+      return ComparisonType::LessThanOrEqual;
+    default:
+      return comp_type;
+  }
+}
+
+/**
+ * @return the fraction of the rows for which `column op value` is true, `value` being a constant, or `std::nullopt`
+ * for a value unknown until the plan runs, such as a parameter
+ */
+static auto ColumnValueSelectivity(const std::optional<ColumnOrigin> &origin, ComparisonType comp_type,
+                                   const std::optional<Value> &value) -> double {
+  const bool is_equality = comp_type == ComparisonType::Equal || comp_type == ComparisonType::NotEqual;
+  if (!origin.has_value()) {
+    const auto selectivity = is_equality ? DEFAULT_EQUAL_SELECTIVITY : DEFAULT_RANGE_SELECTIVITY;
+    return comp_type == ComparisonType::NotEqual ? 1 - selectivity : selectivity;
+  }
+
+  const auto &stats = *origin->stats_;
+  const auto col_idx = origin->col_idx_;
+  const auto non_null = 1 - stats.NullFraction(col_idx);
+  if (!value.has_value()) {
+    const auto equal = non_null / stats.DistinctCount(col_idx);
+    switch (comp_type) {
+      case ComparisonType::Equal:
+        return equal;
+      case ComparisonType::NotEqual:
+        return non_null - equal;
+      default:
+        return non_null * DEFAULT_RANGE_SELECTIVITY;
+    }
+  }
+
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      return stats.EqualSelectivity(col_idx, *value);
+    case ComparisonType::NotEqual:
+      return value->IsNull() ? 0 : non_null - stats.EqualSelectivity(col_idx, *value);
+    case ComparisonType::LessThan:
+      return stats.LessSelectivity(col_idx, *value, false);
+    case ComparisonType::LessThanOrEqual:
+      return stats.LessSelectivity(col_idx, *value, true);
+    case ComparisonType::GreaterThan:
+      return value->IsNull() ? 0 : non_null - stats.LessSelectivity(col_idx, *value, true);
+    case ComparisonType::GreaterThanOrEqual:
+      return value->IsNull() ? 0 : non_null - stats.LessSelectivity(col_idx, *value, false);
+  }
+  return DEFAULT_SELECTIVITY;
+}
+
+auto Optimizer::EstimatedCardinality(const std::string &table_name) -> std::optional<size_t> {
+  if (const auto *table_info = catalog_.GetTable(table_name); table_info != Catalog::NULL_TABLE_INFO) {
+    if (auto stats = catalog_.GetTableStats(table_info->oid_); stats != nullptr) {
+      return static_cast<size_t>(stats->RowCount());
+    }
+  }
+  return EstimatedCardinalityFromName(table_name);
+}
+
+auto Optimizer::EstimateDistinctCount(const AbstractPlanNodeRef &plan, uint32_t col_idx) -> double {
+  const auto cardinality = EstimateCardinality(plan);
+  if (auto origin = TraceColumn(catalog_, plan, col_idx); origin.has_value()) {
+    return std::min(origin->stats_->DistinctCount(origin->col_idx_), std::max(cardinality, 1.0));
+  }
+  // Without statistics, every value is assumed to be distinct
+  return std::max(cardinality, 1.0);
+}
+
+auto Optimizer::EstimateEquiJoinSelectivity(const AbstractPlanNodeRef &left, uint32_t left_col_idx,
+                                            const AbstractPlanNodeRef &right, uint32_t right_col_idx) -> double {
+  // NULLs match nothing, and the other values of the column with fewer distinct values are assumed to all be found in
+  // the other column
+  double non_null = 1;
+  if (auto origin = TraceColumn(catalog_, left, left_col_idx); origin.has_value()) {
+    non_null *= 1 - origin->stats_->NullFraction(origin->col_idx_);
+  }
+  if (auto origin = TraceColumn(catalog_, right, right_col_idx); origin.has_value()) {
+    non_null *= 1 - origin->stats_->NullFraction(origin->col_idx_);
+  }
+  return non_null /
+         std::max(EstimateDistinctCount(left, left_col_idx), EstimateDistinctCount(right, right_col_idx));
+}
+
+auto Optimizer::EstimateSelectivity(const AbstractExpressionRef &predicate, const AbstractPlanNodeRef &left,
+                                    const AbstractPlanNodeRef &right) -> double {
+  if (predicate == nullptr) {
+    return 1;
+  }
+  if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(predicate.get()); constant != nullptr) {
+    return !constant->val_.IsNull() && constant->val_.GetAs<bool>() ? 1 : 0;
+  }
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(predicate.get()); logic != nullptr) {
+    const auto first = EstimateSelectivity(logic->GetChildAt(0), left, right);
+    const auto second = EstimateSelectivity(logic->GetChildAt(1), left, right);
+    // The terms are assumed to be independent
+    return logic->logic_type_ == LogicType::And ? first * second : first + second - first * second;
+  }
+
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(predicate.get());
+  if (comparison == nullptr) {
+    return DEFAULT_SELECTIVITY;
+  }
+  const auto *left_column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0).get());
+  const auto *right_column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1).get());
+  /** @return the plan a column of the predicate is read from */
+  auto input_of = [&](const ColumnValueExpression &column) -> const AbstractPlanNodeRef & {
+    return column.GetTupleIdx() == 1 && right != nullptr ? right : left;
+  };
+
+  if (left_column != nullptr && right_column != nullptr) {
+    if (comparison->comp_type_ != ComparisonType::Equal) {
+      return DEFAULT_RANGE_SELECTIVITY;
+    }
+    const auto &left_input = input_of(*left_column);
+    const auto &right_input = input_of(*right_column);
+    if (right != nullptr && left_input != right_input) {
+      return EstimateEquiJoinSelectivity(left_input, left_column->GetColIdx(), right_input, right_column->GetColIdx());
+    }
+    // Both columns are of the same rows, whose number is not known yet without going round in circles
+    auto left_origin = TraceColumn(catalog_, left_input, left_column->GetColIdx());
+    auto right_origin = TraceColumn(catalog_, right_input, right_column->GetColIdx());
+    if (!left_origin.has_value() || !right_origin.has_value()) {
+      return DEFAULT_EQUAL_SELECTIVITY;
+    }
+    return (1 - left_origin->stats_->NullFraction(left_origin->col_idx_)) *
+           (1 - right_origin->stats_->NullFraction(right_origin->col_idx_)) /
+           std::max(left_origin->stats_->DistinctCount(left_origin->col_idx_),
+                    right_origin->stats_->DistinctCount(right_origin->col_idx_));
+  }
+
+  auto comp_type = comparison->comp_type_;
+  const auto *column = left_column;
+  auto other = comparison->GetChildAt(1);
+  if (column == nullptr) {
+    column = right_column;
+    other = comparison->GetChildAt(0);
+    comp_type = FlipComparison(comp_type);
+  }
+  if (column == nullptr || !other->GetChildren().empty()) {
+    return comp_type == ComparisonType::Equal ? DEFAULT_EQUAL_SELECTIVITY : DEFAULT_SELECTIVITY;
+  }
+  std::optional<Value> value;
+  if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(other.get()); constant != nullptr) {
+    value = constant->val_;
+  }
+  return ColumnValueSelectivity(TraceColumn(catalog_, input_of(*column), column->GetColIdx()), comp_type, value);
+}
+
+auto Optimizer::EstimateCardinality(const AbstractPlanNodeRef &plan) -> double {
+  /** @return the number of rows of a table */
+  auto table_cardinality = [&](const std::string &table_name) {
+    auto cardinality = EstimatedCardinality(table_name);
+    return cardinality.has_value() ? static_cast<double>(*cardinality) : DEFAULT_TABLE_CARDINALITY;
+  };
+  /** @return the number of rows of a join, a left join keeping every left row */
+  auto join_cardinality = [&](JoinType join_type, double left, double right, double selectivity) {
+    const auto cardinality = left * right * selectivity;
+    return join_type == JoinType::LEFT ? std::max(cardinality, left) : cardinality;
+  };
+  /** @return the fraction of the rows of an equi-join of `left` and `right` on keys */
+  auto keys_selectivity = [&](const AbstractPlanNodeRef &left, const AbstractPlanNodeRef &right,
+                              const std::vector<AbstractExpressionRef> &left_keys,
+                              const std::vector<AbstractExpressionRef> &right_keys) {
+    double selectivity = 1;
+    for (size_t i = 0; i < left_keys.size(); i++) {
+      const auto *left_column = dynamic_cast<const ColumnValueExpression *>(left_keys[i].get());
+      const auto *right_column = dynamic_cast<const ColumnValueExpression *>(right_keys[i].get());
+      if (left_column == nullptr || right_column == nullptr) {
+        selectivity *= DEFAULT_EQUAL_SELECTIVITY;
+        continue;
+      }
+      selectivity *= EstimateEquiJoinSelectivity(left, left_column->GetColIdx(), right, right_column->GetColIdx());
+    }
+    return selectivity;
+  };
+
+  switch (plan->GetType()) {
+    case PlanType::SeqScan: {
+      const auto &scan_plan = dynamic_cast<const SeqScanPlanNode &>(*plan);
+      if (!scan_plan.column_ids_.empty()) {
+        // The predicate reads the columns of the table, which a scan of all of them passes on as they are
+        auto table_scan = std::make_shared<SeqScanPlanNode>(scan_plan);
+        table_scan->column_ids_.clear();
+        return EstimateCardinality(table_scan);
+      }
+      return table_cardinality(scan_plan.table_name_) * EstimateSelectivity(scan_plan.filter_predicate_, plan);
+    }
+    case PlanType::MockScan:
+      return table_cardinality(dynamic_cast<const MockScanPlanNode &>(*plan).GetTable());
+    case PlanType::IndexScan: {
+      const auto &scan_plan = dynamic_cast<const IndexScanPlanNode &>(*plan);
+      const auto *index_info = catalog_.GetIndex(scan_plan.GetIndexOid());
+      if (index_info == Catalog::NULL_INDEX_INFO) {
+        return DEFAULT_TABLE_CARDINALITY;
+      }
+      auto cardinality = table_cardinality(index_info->table_name_);
+      if (!scan_plan.pred_keys_.empty()) {
+        // Each key is looked up in turn, and matches rows of its own
+        auto origin = TraceColumn(catalog_, plan, index_info->index_->GetKeyAttrs()[0]);
+        double selectivity = 0;
+        for (const auto &key : scan_plan.pred_keys_) {
+          const auto *constant = dynamic_cast<const ConstantValueExpression *>(key.get());
+          selectivity += ColumnValueSelectivity(
+              origin, ComparisonType::Equal,
+              constant != nullptr ? std::make_optional(constant->val_) : std::optional<Value>{});
+        }
+        cardinality *= std::min(selectivity, 1.0);
+      }
+      return cardinality * EstimateSelectivity(scan_plan.filter_predicate_, plan);
+    }
+    case PlanType::IndexMergeScan: {
+      const auto &scan_plan = dynamic_cast<const IndexMergeScanPlanNode &>(*plan);
+      const bool is_union = scan_plan.merge_type_ == IndexMergeType::Union;
+      double selectivity = is_union ? 0 : 1;
+      for (const auto &lookup : scan_plan.lookups_) {
+        const auto *index_info = catalog_.GetIndex(lookup.index_oid_);
+        if (index_info == Catalog::NULL_INDEX_INFO) {
+          continue;
+        }
+        auto origin = TraceColumn(catalog_, plan, index_info->index_->GetKeyAttrs()[0]);
+        double lookup_selectivity = 0;
+        for (const auto &key : lookup.keys_) {
+          const auto *constant = dynamic_cast<const ConstantValueExpression *>(key.get());
+          lookup_selectivity += ColumnValueSelectivity(
+              origin, ComparisonType::Equal,
+              constant != nullptr ? std::make_optional(constant->val_) : std::optional<Value>{});
+        }
+        lookup_selectivity = std::min(lookup_selectivity, 1.0);
+        selectivity = is_union ? selectivity + lookup_selectivity - selectivity * lookup_selectivity
+                               : selectivity * lookup_selectivity;
+      }
+      return table_cardinality(scan_plan.table_name_) * selectivity *
+             EstimateSelectivity(scan_plan.filter_predicate_, plan);
+    }
+    case PlanType::Filter: {
+      const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*plan);
+      return EstimateCardinality(filter_plan.GetChildPlan()) *
+             EstimateSelectivity(filter_plan.GetPredicate(), filter_plan.GetChildPlan());
+    }
+    case PlanType::Limit:
+      return std::min(EstimateCardinality(plan->GetChildAt(0)),
+                      static_cast<double>(dynamic_cast<const LimitPlanNode &>(*plan).GetLimit()));
+    case PlanType::TopN:
+      return std::min(EstimateCardinality(plan->GetChildAt(0)),
+                      static_cast<double>(dynamic_cast<const TopNPlanNode &>(*plan).GetN()));
+    case PlanType::Values:
+      return static_cast<double>(dynamic_cast<const ValuesPlanNode &>(*plan).GetValues().size());
+    case PlanType::Aggregation:
+    case PlanType::StreamAggregation: {
+      const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*plan);
+      const auto input = EstimateCardinality(agg_plan.GetChildPlan());
+      if (agg_plan.GetGroupBys().empty()) {
+        return 1;
+      }
+      double groups = 1;
+      for (const auto &group_by : agg_plan.GetGroupBys()) {
+        const auto *column = dynamic_cast<const ColumnValueExpression *>(group_by.get());
+        groups *= column != nullptr ? EstimateDistinctCount(agg_plan.GetChildPlan(), column->GetColIdx()) : input;
+      }
+      return std::min(groups, input);
+    }
+    case PlanType::NestedLoopJoin: {
+      const auto &join_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+      return join_cardinality(join_plan.GetJoinType(), EstimateCardinality(join_plan.GetLeftPlan()),
+                              EstimateCardinality(join_plan.GetRightPlan()),
+                              EstimateSelectivity(join_plan.Predicate(), join_plan.GetLeftPlan(),
+                                                  join_plan.GetRightPlan()));
+    }
+    case PlanType::BlockNestedLoopJoin: {
+      const auto &join_plan = dynamic_cast<const BlockNestedLoopJoinPlanNode &>(*plan);
+      return join_cardinality(join_plan.GetJoinType(), EstimateCardinality(join_plan.GetLeftPlan()),
+                              EstimateCardinality(join_plan.GetRightPlan()),
+                              EstimateSelectivity(join_plan.Predicate(), join_plan.GetLeftPlan(),
+                                                  join_plan.GetRightPlan()));
+    }
+    case PlanType::HashJoin: {
+      const auto &join_plan = dynamic_cast<const HashJoinPlanNode &>(*plan);
+      return join_cardinality(join_plan.GetJoinType(), EstimateCardinality(join_plan.GetLeftPlan()),
+                              EstimateCardinality(join_plan.GetRightPlan()),
+                              keys_selectivity(join_plan.GetLeftPlan(), join_plan.GetRightPlan(),
+                                               join_plan.left_key_expressions_, join_plan.right_key_expressions_));
+    }
+    case PlanType::MergeJoin: {
+      const auto &join_plan = dynamic_cast<const MergeJoinPlanNode &>(*plan);
+      return join_cardinality(join_plan.GetJoinType(), EstimateCardinality(join_plan.GetLeftPlan()),
+                              EstimateCardinality(join_plan.GetRightPlan()),
+                              keys_selectivity(join_plan.GetLeftPlan(), join_plan.GetRightPlan(),
+                                               join_plan.left_key_expressions_, join_plan.right_key_expressions_));
+    }
+    case PlanType::NestedIndexJoin: {
+      const auto &join_plan = dynamic_cast<const NestedIndexJoinPlanNode &>(*plan);
+      const auto left = EstimateCardinality(join_plan.GetChildPlan());
+      double matches = 1;
+      if (const auto *index_info = catalog_.GetIndex(join_plan.GetIndexOid());
+          index_info != Catalog::NULL_INDEX_INFO) {
+        // Each left row matches the inner rows sharing one of the distinct values of the index key
+        const auto inner = table_cardinality(index_info->table_name_);
+        auto origin = TableColumn(catalog_, join_plan.GetInnerTableOid(), index_info->index_->GetKeyAttrs()[0]);
+        matches = origin.has_value()
+                      ? inner * (1 - origin->stats_->NullFraction(origin->col_idx_)) /
+                            origin->stats_->DistinctCount(origin->col_idx_)
+                      : 1;
+      }
+      return join_cardinality(join_plan.GetJoinType(), left, matches, 1);
+    }
+    case PlanType::Insert:
+    case PlanType::Update:
+    case PlanType::Delete:
+      return 1;
+    default:
+      // Projections, sorts and the operators that only move rows around keep their number
+      if (plan->GetChildren().empty()) {
+        return DEFAULT_TABLE_CARDINALITY;
+      }
+      return EstimateCardinality(plan->GetChildAt(0));
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,44 @@
+#include "optimizer/expression_util.h"
+
+#include <memory>
+#include <utility>
+
+#include "execution/expressions/constant_value_expression.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+void SplitTerms(const AbstractExpressionRef &expr, LogicType logic_type, std::vector<AbstractExpressionRef> *terms) {
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(expr.get());
+      logic != nullptr && logic->logic_type_ == logic_type) {
+    SplitTerms(logic->GetChildAt(0), logic_type, terms);
+    SplitTerms(logic->GetChildAt(1), logic_type, terms);
+    return;
+  }
+  terms->push_back(expr);
+}
+
+void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts) {
+  std::vector<AbstractExpressionRef> terms;
+  SplitTerms(expr, LogicType::And, &terms);
+  for (auto &term : terms) {
+    if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(term.get());
+        constant != nullptr && !constant->val_.IsNull() && constant->val_.GetAs<bool>()) {
+      continue;
+    }
+    conjuncts->push_back(std::move(term));
+  }
+}
+
+auto MakeConjunction(const std::vector<AbstractExpressionRef> &exprs) -> AbstractExpressionRef {
+  if (exprs.empty()) {
+    return std::make_shared<ConstantValueExpression>(ValueFactory::GetBooleanValue(true));
+  }
+  auto conjunction = exprs[0];
+  for (size_t i = 1; i < exprs.size(); i++) {
+    conjunction = std::make_shared<LogicExpression>(std::move(conjunction), exprs[i], LogicType::And);
+  }
+  return conjunction;
+}
+
+}  // namespace bustub
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/expressions/parameter_value_expression.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_merge_scan_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/expression_util.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** @return whether an expression evaluates without a tuple, so that it can be looked up in an index */
+static auto IsLookupKey(const AbstractExpression &expr) -> bool {
+  return dynamic_cast<const ConstantValueExpression *>(&expr) != nullptr ||
+         dynamic_cast<const ParameterValueExpression *>(&expr) != nullptr;
+}
+
+/** @return the column and the key of `column = key` or `key = column`, or nullopt if the predicate has another shape */
+static auto MatchKeyEquality(const AbstractExpressionRef &expr)
+    -> std::optional<std::pair<uint32_t, AbstractExpressionRef>> {
+  const auto *comp_expr = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (comp_expr == nullptr || comp_expr->comp_type_ != ComparisonType::Equal) {
+    return std::nullopt;
+  }
+  for (size_t i = 0; i < 2; i++) {
+    const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(comp_expr->GetChildAt(i).get());
+    const auto &key = comp_expr->GetChildAt(1 - i);
+    if (column_expr != nullptr && IsLookupKey(*key) && key->GetReturnType() == column_expr->GetReturnType()) {
+      return std::make_pair(column_expr->GetColIdx(), key);
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * Match a disjunction of `column = key` terms, over one or more columns.
+ * @return the keys each column is compared to, in the order the columns first appear, or nullopt if some term has
+ * another shape
+ */
+static auto MatchKeyLookups(const AbstractExpressionRef &expr)
+    -> std::optional<std::vector<std::pair<uint32_t, std::vector<AbstractExpressionRef>>>> {
+  std::vector<AbstractExpressionRef> disjuncts;
+  SplitTerms(expr, LogicType::Or, &disjuncts);
+  std::vector<std::pair<uint32_t, std::vector<AbstractExpressionRef>>> lookups;
+  for (const auto &disjunct : disjuncts) {
+    auto equality = MatchKeyEquality(disjunct);
+    if (!equality.has_value()) {
+      return std::nullopt;
+    }
+    auto it = std::find_if(lookups.begin(), lookups.end(),
+                           [&](const auto &lookup) { return lookup.first == equality->first; });
+    if (it == lookups.end()) {
+      lookups.emplace_back(equality->first, std::vector<AbstractExpressionRef>{});
+      it = std::prev(lookups.end());
+    }
+    it->second.push_back(std::move(equality->second));
+  }
+  return lookups;
+}
+
+auto Optimizer::OptimizeFilterAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeFilterAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  // The predicate is either in a filter right above the scan, or already merged into it
+  const SeqScanPlanNode *seq_scan = nullptr;
+  AbstractExpressionRef predicate;
+  if (optimized_plan->GetType() == PlanType::Filter &&
+      optimized_plan->GetChildAt(0)->GetType() == PlanType::SeqScan) {
+    seq_scan = dynamic_cast<const SeqScanPlanNode *>(optimized_plan->GetChildAt(0).get());
+    if (seq_scan->filter_predicate_ != nullptr) {
+      return optimized_plan;
+    }
+    predicate = dynamic_cast<const FilterPlanNode &>(*optimized_plan).GetPredicate();
+  } else if (optimized_plan->GetType() == PlanType::SeqScan) {
+    seq_scan = dynamic_cast<const SeqScanPlanNode *>(optimized_plan.get());
+    predicate = seq_scan->filter_predicate_;
+  }
+  if (seq_scan == nullptr || predicate == nullptr || !seq_scan->runtime_filters_.empty()) {
+    return optimized_plan;
+  }
+
+  // Each conjunct comparing an indexed column to keys narrows down the tuples to read, and so does a conjunct comparing
+  // several indexed columns to keys, e.g. `a = 1 OR b = 2`, through the union of the lookups
+  std::vector<IndexLookup> intersected;
+  std::optional<std::vector<IndexLookup>> united;
+  std::vector<AbstractExpressionRef> conjuncts;
+  SplitTerms(predicate, LogicType::And, &conjuncts);
+  for (const auto &conjunct : conjuncts) {
+    auto column_lookups = MatchKeyLookups(conjunct);
+    if (!column_lookups.has_value()) {
+      continue;
+    }
+    std::vector<IndexLookup> lookups;
+    for (auto &[column, keys] : *column_lookups) {
+      auto index = MatchIndex(seq_scan->table_name_, column);
+      if (!index.has_value()) {
+        lookups.clear();
+        break;
+      }
+      lookups.push_back(IndexLookup{std::get<0>(*index), std::move(keys)});
+    }
+    if (lookups.size() == 1) {
+      bool seen = std::any_of(intersected.begin(), intersected.end(),
+                              [&](const IndexLookup &lookup) { return lookup.index_oid_ == lookups[0].index_oid_; });
+      if (!seen) {
+        intersected.push_back(std::move(lookups[0]));
+      }
+    } else if (lookups.size() > 1 && !united.has_value()) {
+      united = std::move(lookups);
+    }
+  }
+
+  // The index scans produce the tuples in RID order, which is the heap order of the scan they replace, so they read
+  // each heap page once. The indexes only narrow down the tuples to read, which are all checked against the whole
+  // predicate. Equality lookups are taken to be selective enough that reading the RIDs of every index is cheaper than
+  // reading the tuples they rule out.
+  if (intersected.size() == 1) {
+    return std::make_shared<IndexScanPlanNode>(seq_scan->output_schema_, intersected[0].index_oid_,
+                                               std::move(intersected[0].keys_), predicate, true);
+  }
+  if (intersected.size() > 1) {
+    return std::make_shared<IndexMergeScanPlanNode>(seq_scan->output_schema_, seq_scan->table_oid_,
+                                                    seq_scan->table_name_, std::move(intersected),
+                                                    IndexMergeType::Intersect, predicate);
+  }
+  if (united.has_value()) {
+    return std::make_shared<IndexMergeScanPlanNode>(seq_scan->output_schema_, seq_scan->table_oid_,
+                                                    seq_scan->table_name_, std::move(*united), IndexMergeType::Union,
+                                                    predicate);
+  }
+  return optimized_plan;
+}
+
+}  // namespace bustub
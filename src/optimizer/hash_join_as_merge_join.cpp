@@ -0,0 +1,146 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** @return the column of a join key, or nullptr if it is not a plain column */
+static auto KeyColumn(const AbstractExpressionRef &expr) -> const ColumnValueExpression * {
+  return dynamic_cast<const ColumnValueExpression *>(expr.get());
+}
+
+/** @return the plan, or a sort of it on the keys if its output is not sorted on them yet */
+static auto SortedOn(const AbstractPlanNodeRef &plan, const Optimizer::Ordering &ordering,
+                     const std::vector<AbstractExpressionRef> &keys, const std::vector<OrderByType> &key_orders)
+    -> AbstractPlanNodeRef {
+  bool sorted = ordering.size() >= keys.size();
+  for (size_t i = 0; sorted && i < keys.size(); i++) {
+    sorted = ordering[i].first == key_orders[i] && ordering[i].second == KeyColumn(keys[i])->GetColIdx();
+  }
+  if (sorted) {
+    return plan;
+  }
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys;
+  for (size_t i = 0; i < keys.size(); i++) {
+    order_bys.emplace_back(key_orders[i], keys[i]);
+  }
+  return std::make_shared<SortPlanNode>(plan->output_schema_, plan, std::move(order_bys));
+}
+
+auto Optimizer::OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeHashJoinAsMergeJoin(child));
+  }
+  AbstractPlanNodeRef optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  // A sort on the join keys over a hash join, possibly through a projection, becomes a merge join of sorted inputs,
+  // whose output is already sorted
+  const SortPlanNode *sort_plan = nullptr;
+  const ProjectionPlanNode *projection_plan = nullptr;
+  AbstractPlanNodeRef join_plan_ref = optimized_plan;
+  if (optimized_plan->GetType() == PlanType::Sort) {
+    sort_plan = dynamic_cast<const SortPlanNode *>(optimized_plan.get());
+    join_plan_ref = sort_plan->GetChildPlan();
+    if (join_plan_ref->GetType() == PlanType::Projection) {
+      projection_plan = dynamic_cast<const ProjectionPlanNode *>(join_plan_ref.get());
+      join_plan_ref = projection_plan->GetChildPlan();
+    }
+  }
+  if (join_plan_ref->GetType() != PlanType::HashJoin) {
+    return optimized_plan;
+  }
+  const auto &join_plan = dynamic_cast<const HashJoinPlanNode &>(*join_plan_ref);
+  const auto &left_keys = join_plan.LeftJoinKeyExpressions();
+  const auto &right_keys = join_plan.RightJoinKeyExpressions();
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    // Keys of different types would not have comparable normalized encodings
+    if (KeyColumn(left_keys[i]) == nullptr || KeyColumn(right_keys[i]) == nullptr ||
+        left_keys[i]->GetReturnType() != right_keys[i]->GetReturnType()) {
+      return optimized_plan;
+    }
+  }
+
+  // The keys in merge order, with their direction
+  std::vector<size_t> key_idxs;
+  std::vector<OrderByType> key_orders;
+  std::vector<bool> used(left_keys.size(), false);
+  auto add_key = [&](size_t key_idx, OrderByType order) {
+    key_idxs.push_back(key_idx);
+    key_orders.push_back(order);
+    used[key_idx] = true;
+  };
+
+  auto left_ordering = OutputOrdering(join_plan.GetLeftPlan());
+  auto right_ordering = OutputOrdering(join_plan.GetRightPlan());
+  if (sort_plan != nullptr) {
+    // Every ORDER BY column has to be a distinct left join key, which the output keeps at the same position
+    for (const auto &[order_type, expr] : sort_plan->GetOrderBy()) {
+      const auto *column = KeyColumn(expr);
+      if (column != nullptr && projection_plan != nullptr) {
+        column = KeyColumn(projection_plan->GetExpressions()[column->GetColIdx()]);
+      }
+      size_t key_idx = 0;
+      while (column != nullptr && key_idx < left_keys.size() &&
+             (used[key_idx] || KeyColumn(left_keys[key_idx])->GetColIdx() != column->GetColIdx())) {
+        key_idx++;
+      }
+      if (column == nullptr || key_idx == left_keys.size()) {
+        return optimized_plan;
+      }
+      add_key(key_idx, order_type == OrderByType::DESC ? OrderByType::DESC : OrderByType::ASC);
+    }
+    for (size_t i = 0; i < left_keys.size(); i++) {
+      if (!used[i]) {
+        add_key(i, OrderByType::ASC);
+      }
+    }
+  } else {
+    // Both inputs have to be sorted on all the keys already, in the same key order and directions
+    if (left_ordering.size() < left_keys.size() || right_ordering.size() < left_keys.size()) {
+      return optimized_plan;
+    }
+    for (size_t i = 0; i < left_keys.size(); i++) {
+      if (left_ordering[i].first != right_ordering[i].first) {
+        return optimized_plan;
+      }
+      size_t key_idx = 0;
+      while (key_idx < left_keys.size() &&
+             (used[key_idx] || KeyColumn(left_keys[key_idx])->GetColIdx() != left_ordering[i].second ||
+              KeyColumn(right_keys[key_idx])->GetColIdx() != right_ordering[i].second)) {
+        key_idx++;
+      }
+      if (key_idx == left_keys.size()) {
+        return optimized_plan;
+      }
+      add_key(key_idx, left_ordering[i].first);
+    }
+  }
+
+  std::vector<AbstractExpressionRef> merge_left_keys;
+  std::vector<AbstractExpressionRef> merge_right_keys;
+  for (auto key_idx : key_idxs) {
+    merge_left_keys.push_back(left_keys[key_idx]);
+    merge_right_keys.push_back(right_keys[key_idx]);
+  }
+  auto left = SortedOn(join_plan.GetLeftPlan(), left_ordering, merge_left_keys, key_orders);
+  auto right = SortedOn(join_plan.GetRightPlan(), right_ordering, merge_right_keys, key_orders);
+  AbstractPlanNodeRef merge_join = std::make_shared<MergeJoinPlanNode>(
+      join_plan.output_schema_, std::move(left), std::move(right), std::move(merge_left_keys),
+      std::move(merge_right_keys), std::move(key_orders), join_plan.GetJoinType());
+  if (projection_plan != nullptr) {
+    return projection_plan->CloneWithChildren({std::move(merge_join)});
+  }
+  return merge_join;
+}
+
+}  // namespace bustub
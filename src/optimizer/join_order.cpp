@@ -0,0 +1,398 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "optimizer/expression_util.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** The largest number of relations whose join orders are all enumerated, beyond which they are joined greedily */
+static constexpr size_t DP_JOIN_LIMIT = 10;
+
+/** The largest number of relations a join tree is reordered with, one bit of a relation set each */
+static constexpr size_t MAX_JOIN_RELATIONS = 64;
+
+/** The cost of inserting a tuple into the hash table of a hash join, relative to that of probing it with one */
+static constexpr double HASH_BUILD_COST = 2;
+
+/** The cost of checking a pair of tuples against the predicate of a nested loop join, relative to a hash probe */
+static constexpr double NLJ_PAIR_COST = 1;
+
+/** A set of the relations of a join tree, relation `i` being bit `i` */
+using RelationSet = uint64_t;
+
+/** A conjunct of the predicates of a join tree, whose columns are numbered across the output of the whole tree */
+struct JoinConjunct {
+  AbstractExpressionRef expr_;
+  /** The relations the conjunct reads columns of */
+  RelationSet relations_{0};
+  /** For an equality of columns of two relations, which a hash join can take as a key, the two relations */
+  std::optional<std::pair<size_t, size_t>> equi_;
+  /** The selectivity of the conjunct, estimated once the first time a join applies it */
+  std::optional<double> selectivity_;
+};
+
+/** A tree of inner joins, flattened into the relations it joins and the conjuncts of all of its predicates */
+struct JoinGraph {
+  std::vector<AbstractPlanNodeRef> relations_;
+  /** The first column of each relation in the output of the tree */
+  std::vector<uint32_t> offsets_;
+  /** The relation of each column of the output of the tree */
+  std::vector<size_t> relation_of_;
+  std::vector<JoinConjunct> conjuncts_;
+};
+
+/** The best plan found to join a set of relations */
+struct JoinEntry {
+  RelationSet relations_;
+  AbstractPlanNodeRef plan_;
+  /** The column of the output of the join tree each output column of the plan is */
+  std::vector<uint32_t> columns_;
+  double cardinality_;
+  double cost_;
+};
+
+/** @return whether a plan is an inner nested loop join, whose children can be joined in any order */
+static auto IsInnerJoin(const AbstractPlanNodeRef &plan) -> bool {
+  return plan->GetType() == PlanType::NestedLoopJoin &&
+         dynamic_cast<const NestedLoopJoinPlanNode &>(*plan).GetJoinType() == JoinType::INNER;
+}
+
+/** @return whether a plan is an inner join, or a filter right above one, its predicate being one more join predicate */
+static auto IsJoinTree(const AbstractPlanNodeRef &plan) -> bool {
+  return IsInnerJoin(plan) || (plan->GetType() == PlanType::Filter && IsInnerJoin(plan->GetChildAt(0)));
+}
+
+/** @return the expression with column `c` of tuple 0 and 1 numbered `left_offset + c` and `right_offset + c` */
+static auto NumberColumns(const AbstractExpressionRef &expr, uint32_t left_offset, uint32_t right_offset)
+    -> AbstractExpressionRef {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    const auto offset = column->GetTupleIdx() == 0 ? left_offset : right_offset;
+    return std::make_shared<ColumnValueExpression>(0, offset + column->GetColIdx(), column->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(NumberColumns(child, left_offset, right_offset));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+/** @return the expression with each column of the join tree replaced by the (tuple, column) it is at in a plan */
+static auto PlaceColumns(const AbstractExpressionRef &expr, const std::vector<std::pair<uint32_t, uint32_t>> &places)
+    -> AbstractExpressionRef {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    const auto [tuple_idx, col_idx] = places[column->GetColIdx()];
+    return std::make_shared<ColumnValueExpression>(tuple_idx, col_idx, column->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(PlaceColumns(child, places));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+static void CollectRelations(const AbstractExpressionRef &expr, const JoinGraph &graph, RelationSet *relations) {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    *relations |= RelationSet{1} << graph.relation_of_[column->GetColIdx()];
+    return;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectRelations(child, graph, relations);
+  }
+}
+
+/**
+ * Flatten a join tree whose output starts at column `offset` of the output of the whole tree, numbering the columns of
+ * its predicates accordingly. The relations joined are optimized with `optimize_relation`.
+ */
+template <typename F>
+static void FlattenJoinTree(const AbstractPlanNodeRef &plan, uint32_t offset, JoinGraph *graph,
+                            const F &optimize_relation) {
+  std::vector<AbstractExpressionRef> conjuncts;
+  if (IsInnerJoin(plan)) {
+    const auto &join_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+    const auto right_offset = offset + join_plan.GetLeftPlan()->OutputSchema().GetColumnCount();
+    FlattenJoinTree(join_plan.GetLeftPlan(), offset, graph, optimize_relation);
+    FlattenJoinTree(join_plan.GetRightPlan(), right_offset, graph, optimize_relation);
+    SplitConjuncts(join_plan.Predicate(), &conjuncts);
+    for (const auto &conjunct : conjuncts) {
+      graph->conjuncts_.push_back({NumberColumns(conjunct, offset, right_offset), 0, std::nullopt, std::nullopt});
+    }
+  } else if (IsJoinTree(plan)) {
+    const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*plan);
+    FlattenJoinTree(filter_plan.GetChildPlan(), offset, graph, optimize_relation);
+    SplitConjuncts(filter_plan.GetPredicate(), &conjuncts);
+    for (const auto &conjunct : conjuncts) {
+      graph->conjuncts_.push_back({NumberColumns(conjunct, offset, offset), 0, std::nullopt, std::nullopt});
+    }
+  } else {
+    graph->offsets_.push_back(offset);
+    graph->relation_of_.resize(offset + plan->OutputSchema().GetColumnCount(), graph->relations_.size());
+    graph->relations_.push_back(optimize_relation(plan));
+  }
+}
+
+/** @return the (tuple, column) of each column of the join tree in the output of a join of `left` and `right` */
+static auto JoinPlaces(const JoinGraph &graph, const JoinEntry &left, const JoinEntry &right, bool concatenated)
+    -> std::vector<std::pair<uint32_t, uint32_t>> {
+  std::vector<std::pair<uint32_t, uint32_t>> places(graph.relation_of_.size());
+  for (uint32_t i = 0; i < left.columns_.size(); i++) {
+    places[left.columns_[i]] = {0, i};
+  }
+  for (uint32_t i = 0; i < right.columns_.size(); i++) {
+    places[right.columns_[i]] = concatenated ? std::make_pair(0U, static_cast<uint32_t>(left.columns_.size()) + i)
+                                             : std::make_pair(1U, i);
+  }
+  return places;
+}
+
+/** @return whether a join of `left` and `right` is the lowest join a conjunct can be checked at */
+static auto AppliesTo(const JoinConjunct &conjunct, const JoinEntry &left, const JoinEntry &right) -> bool {
+  const auto relations = left.relations_ | right.relations_;
+  return (conjunct.relations_ & ~relations) == 0 && (conjunct.relations_ & ~left.relations_) != 0 &&
+         (conjunct.relations_ & ~right.relations_) != 0;
+}
+
+/** @return whether a conjunct is an equality of a column of `left` and one of `right` */
+static auto IsHashKey(const JoinConjunct &conjunct, const JoinEntry &left, const JoinEntry &right) -> bool {
+  if (!conjunct.equi_.has_value()) {
+    return false;
+  }
+  const auto first = RelationSet{1} << conjunct.equi_->first;
+  const auto second = RelationSet{1} << conjunct.equi_->second;
+  return ((left.relations_ & first) != 0 && (right.relations_ & second) != 0) ||
+         ((left.relations_ & second) != 0 && (right.relations_ & first) != 0);
+}
+
+/** @return the estimated cardinality and cost of joining `left` and `right`, `right` being the build side */
+static auto EstimateJoin(Optimizer &optimizer, JoinGraph *graph, const JoinEntry &left, const JoinEntry &right)
+    -> std::pair<double, double> {
+  double selectivity = 1;
+  bool hash_join = false;
+  for (auto &conjunct : graph->conjuncts_) {
+    if (!AppliesTo(conjunct, left, right)) {
+      continue;
+    }
+    if (!conjunct.selectivity_.has_value()) {
+      auto expr = PlaceColumns(conjunct.expr_, JoinPlaces(*graph, left, right, false));
+      conjunct.selectivity_ = optimizer.EstimateSelectivity(expr, left.plan_, right.plan_);
+    }
+    selectivity *= *conjunct.selectivity_;
+    hash_join |= IsHashKey(conjunct, left, right);
+  }
+
+  const auto cardinality = left.cardinality_ * right.cardinality_ * selectivity;
+  // A hash join builds a hash table of its right child and probes it with each left tuple, while a nested loop join
+  // checks every pair of tuples
+  const auto join_cost = hash_join ? HASH_BUILD_COST * right.cardinality_ + left.cardinality_
+                                   : NLJ_PAIR_COST * left.cardinality_ * right.cardinality_;
+  return {cardinality, left.cost_ + right.cost_ + join_cost + cardinality};
+}
+
+/**
+ * @return the join of `left` and `right`. Its predicate only has the equalities a hash join takes as keys, if there
+ * are some, the other conjuncts being checked by a filter above it.
+ */
+static auto MakeJoin(Optimizer &optimizer, JoinGraph *graph, const JoinEntry &left, const JoinEntry &right)
+    -> JoinEntry {
+  auto [cardinality, cost] = EstimateJoin(optimizer, graph, left, right);
+  const auto join_places = JoinPlaces(*graph, left, right, false);
+  const auto output_places = JoinPlaces(*graph, left, right, true);
+  std::vector<AbstractExpressionRef> keys;
+  std::vector<AbstractExpressionRef> others;
+  for (const auto &conjunct : graph->conjuncts_) {
+    if (!AppliesTo(conjunct, left, right)) {
+      continue;
+    }
+    if (IsHashKey(conjunct, left, right)) {
+      keys.push_back(PlaceColumns(conjunct.expr_, join_places));
+    } else {
+      others.push_back(conjunct.expr_);
+    }
+  }
+
+  std::vector<Column> columns = left.plan_->OutputSchema().GetColumns();
+  for (const auto &column : right.plan_->OutputSchema().GetColumns()) {
+    columns.push_back(column);
+  }
+  auto schema = std::make_shared<Schema>(columns);
+  AbstractPlanNodeRef plan;
+  if (keys.empty()) {
+    for (auto &other : others) {
+      other = PlaceColumns(other, join_places);
+    }
+    plan = std::make_shared<NestedLoopJoinPlanNode>(schema, left.plan_, right.plan_, MakeConjunction(others),
+                                                    JoinType::INNER);
+  } else {
+    plan = std::make_shared<NestedLoopJoinPlanNode>(schema, left.plan_, right.plan_, MakeConjunction(keys),
+                                                    JoinType::INNER);
+    if (!others.empty()) {
+      for (auto &other : others) {
+        other = PlaceColumns(other, output_places);
+      }
+      plan = std::make_shared<FilterPlanNode>(schema, MakeConjunction(others), std::move(plan));
+    }
+  }
+
+  auto output_columns = left.columns_;
+  output_columns.insert(output_columns.end(), right.columns_.begin(), right.columns_.end());
+  return {left.relations_ | right.relations_, std::move(plan), std::move(output_columns), cardinality, cost};
+}
+
+/** @return the cheapest join of all the relations, of all the join orders if there are few of them */
+static auto EnumerateJoins(Optimizer &optimizer, JoinGraph *graph, std::vector<JoinEntry> relations) -> JoinEntry {
+  const auto n = relations.size();
+  if (n <= DP_JOIN_LIMIT) {
+    // Each set of relations is joined best by splitting it in two smaller ones, joined best before
+    const RelationSet all = (RelationSet{1} << n) - 1;
+    std::vector<std::optional<JoinEntry>> best(all + 1);
+    for (size_t i = 0; i < n; i++) {
+      best[RelationSet{1} << i] = std::move(relations[i]);
+    }
+    for (RelationSet set = 1; set <= all; set++) {
+      if ((set & (set - 1)) == 0) {
+        continue;
+      }
+      auto best_cost = std::numeric_limits<double>::infinity();
+      RelationSet best_left = 0;
+      // The subsets of `set` in increasing order, trying the written order first and keeping it on ties
+      for (RelationSet left = set & (~set + 1); left != set; left = (left - set) & set) {
+        auto [cardinality, cost] = EstimateJoin(optimizer, graph, *best[left], *best[set ^ left]);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_left = left;
+        }
+      }
+      best[set] = MakeJoin(optimizer, graph, *best[best_left], *best[set ^ best_left]);
+    }
+    return std::move(*best[all]);
+  }
+
+  // Too many relations to try all the orders: join the two whose join is the cheapest until one is left
+  while (relations.size() > 1) {
+    auto best_cost = std::numeric_limits<double>::infinity();
+    size_t best_left = 0;
+    size_t best_right = 1;
+    for (size_t i = 0; i < relations.size(); i++) {
+      for (size_t j = 0; j < relations.size(); j++) {
+        if (i == j) {
+          continue;
+        }
+        auto [cardinality, cost] = EstimateJoin(optimizer, graph, relations[i], relations[j]);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_left = i;
+          best_right = j;
+        }
+      }
+    }
+    auto join = MakeJoin(optimizer, graph, relations[best_left], relations[best_right]);
+    relations.erase(relations.begin() + std::max(best_left, best_right));
+    relations.erase(relations.begin() + std::min(best_left, best_right));
+    relations.push_back(std::move(join));
+  }
+  return std::move(relations[0]);
+}
+
+auto Optimizer::OptimizeJoinOrder(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  if (!IsJoinTree(plan)) {
+    std::vector<AbstractPlanNodeRef> children;
+    for (const auto &child : plan->GetChildren()) {
+      children.emplace_back(OptimizeJoinOrder(child));
+    }
+    return plan->CloneWithChildren(std::move(children));
+  }
+
+  JoinGraph graph;
+  FlattenJoinTree(plan, 0, &graph, [this](const AbstractPlanNodeRef &relation) { return OptimizeJoinOrder(relation); });
+  const auto n = graph.relations_.size();
+  if (n > MAX_JOIN_RELATIONS) {
+    return plan;
+  }
+
+  std::vector<AbstractExpressionRef> constant_conjuncts;
+  std::vector<std::vector<AbstractExpressionRef>> relation_conjuncts(n);
+  for (auto &conjunct : graph.conjuncts_) {
+    CollectRelations(conjunct.expr_, graph, &conjunct.relations_);
+    if (conjunct.relations_ == 0) {
+      constant_conjuncts.push_back(conjunct.expr_);
+    } else if ((conjunct.relations_ & (conjunct.relations_ - 1)) == 0) {
+      relation_conjuncts[__builtin_ctzll(conjunct.relations_)].push_back(conjunct.expr_);
+    }
+    const auto *comparison = dynamic_cast<const ComparisonExpression *>(conjunct.expr_.get());
+    if (comparison != nullptr && comparison->comp_type_ == ComparisonType::Equal) {
+      const auto *lhs = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0).get());
+      const auto *rhs = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1).get());
+      if (lhs != nullptr && rhs != nullptr &&
+          graph.relation_of_[lhs->GetColIdx()] != graph.relation_of_[rhs->GetColIdx()]) {
+        conjunct.equi_ = {graph.relation_of_[lhs->GetColIdx()], graph.relation_of_[rhs->GetColIdx()]};
+      }
+    }
+  }
+
+  // The conjuncts of a single relation filter it before any join, so that the joins see how few of its rows are left
+  std::vector<JoinEntry> relations;
+  for (size_t i = 0; i < n; i++) {
+    auto relation = graph.relations_[i];
+    const auto column_count = relation->OutputSchema().GetColumnCount();
+    std::vector<uint32_t> columns(column_count);
+    std::vector<std::pair<uint32_t, uint32_t>> places(graph.relation_of_.size());
+    for (uint32_t j = 0; j < column_count; j++) {
+      columns[j] = graph.offsets_[i] + j;
+      places[columns[j]] = {0, j};
+    }
+    if (!relation_conjuncts[i].empty()) {
+      for (auto &conjunct : relation_conjuncts[i]) {
+        conjunct = PlaceColumns(conjunct, places);
+      }
+      relation = std::make_shared<FilterPlanNode>(relation->output_schema_, MakeConjunction(relation_conjuncts[i]),
+                                                  std::move(relation));
+    }
+    const auto cardinality = EstimateCardinality(relation);
+    relations.push_back({RelationSet{1} << i, std::move(relation), std::move(columns), cardinality, cardinality});
+  }
+
+  auto join = EnumerateJoins(*this, &graph, std::move(relations));
+
+  // The conjuncts of no relation are checked once, and the columns are put back in the order of the join tree
+  std::vector<std::pair<uint32_t, uint32_t>> places(graph.relation_of_.size());
+  for (uint32_t i = 0; i < join.columns_.size(); i++) {
+    places[join.columns_[i]] = {0, i};
+  }
+  auto result = join.plan_;
+  if (!constant_conjuncts.empty()) {
+    for (auto &conjunct : constant_conjuncts) {
+      conjunct = PlaceColumns(conjunct, places);
+    }
+    result = std::make_shared<FilterPlanNode>(result->output_schema_, MakeConjunction(constant_conjuncts),
+                                              std::move(result));
+  }
+  bool reordered = false;
+  for (uint32_t i = 0; i < join.columns_.size(); i++) {
+    reordered |= join.columns_[i] != i;
+  }
+  if (!reordered) {
+    return result;
+  }
+  std::vector<AbstractExpressionRef> exprs;
+  for (uint32_t i = 0; i < graph.relation_of_.size(); i++) {
+    exprs.push_back(std::make_shared<ColumnValueExpression>(0, places[i].second,
+                                                            plan->OutputSchema().GetColumn(i).GetType()));
+  }
+  return std::make_shared<ProjectionPlanNode>(plan->output_schema_, std::move(exprs), std::move(result));
+}
+
+}  // namespace bustub
@@ -0,0 +1,29 @@
+#include <memory>
+#include <vector>
+
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/block_nested_loop_join_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeNLJAsBlockNLJ(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeNLJAsBlockNLJ(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::NestedLoopJoin) {
+    const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan);
+    BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
+    return std::make_shared<BlockNestedLoopJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(),
+                                                         nlj_plan.GetRightPlan(), nlj_plan.Predicate(),
+                                                         nlj_plan.GetJoinType());
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
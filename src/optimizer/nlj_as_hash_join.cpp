@@ -7,6 +7,7 @@
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/comparison_expression.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/hash_join_plan.h"
@@ -17,12 +18,56 @@
 
 namespace bustub {
 
+auto Optimizer::ExtractEquiJoinKeys(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *left_keys,
+                                    std::vector<AbstractExpressionRef> *right_keys) -> bool {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get()); logic_expr != nullptr) {
+    return logic_expr->logic_type_ == LogicType::And &&
+           ExtractEquiJoinKeys(logic_expr->GetChildAt(0), left_keys, right_keys) &&
+           ExtractEquiJoinKeys(logic_expr->GetChildAt(1), left_keys, right_keys);
+  }
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (cmp_expr == nullptr || cmp_expr->comp_type_ != ComparisonType::Equal) {
+    return false;
+  }
+  const auto *lhs = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(0).get());
+  const auto *rhs = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(1).get());
+  if (lhs == nullptr || rhs == nullptr || lhs->GetTupleIdx() == rhs->GetTupleIdx()) {
+    return false;
+  }
+  if (lhs->GetTupleIdx() == 1) {
+    std::swap(lhs, rhs);
+  }
+  // Key expressions are evaluated against a single side, so both of them refer to tuple 0.
+  left_keys->emplace_back(std::make_shared<ColumnValueExpression>(0, lhs->GetColIdx(), lhs->GetReturnType()));
+  right_keys->emplace_back(std::make_shared<ColumnValueExpression>(0, rhs->GetColIdx(), rhs->GetReturnType()));
+  return true;
+}
+
 auto Optimizer::OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
-  // TODO(student): implement NestedLoopJoin -> HashJoin optimizer rule
-  // Note for 2023 Spring: You should at least support join keys of the form:
-  // 1. <column expr> = <column expr>
-  // 2. <column expr> = <column expr> AND <column expr> = <column expr>
-  return plan;
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeNLJAsHashJoin(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::NestedLoopJoin) {
+    const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan);
+    // Has exactly two children
+    BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
+    if (nlj_plan.GetJoinType() != JoinType::INNER && nlj_plan.GetJoinType() != JoinType::LEFT) {
+      return optimized_plan;
+    }
+
+    std::vector<AbstractExpressionRef> left_keys;
+    std::vector<AbstractExpressionRef> right_keys;
+    if (ExtractEquiJoinKeys(nlj_plan.Predicate(), &left_keys, &right_keys)) {
+      return std::make_shared<HashJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(),
+                                                nlj_plan.GetRightPlan(), std::move(left_keys), std::move(right_keys),
+                                                nlj_plan.GetJoinType());
+    }
+  }
+
+  return optimized_plan;
 }
 
 }  // namespace bustub
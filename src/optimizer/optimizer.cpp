@@ -19,7 +19,7 @@ auto Optimizer::Optimize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef
   return OptimizeCustom(plan);
 }
 
-auto Optimizer::EstimatedCardinality(const std::string &table_name) -> std::optional<size_t> {
+auto Optimizer::EstimatedCardinalityFromName(const std::string &table_name) -> std::optional<size_t> {
   if (StringUtil::EndsWith(table_name, "_1m")) {
     return std::make_optional(1000000);
   }
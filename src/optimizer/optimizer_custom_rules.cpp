@@ -11,9 +11,22 @@ auto Optimizer::OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanN
   auto p = plan;
   p = OptimizeMergeProjection(p);
   p = OptimizeMergeFilterNLJ(p);
+  p = OptimizePushDownPredicates(p);
+  p = OptimizeSimplifyExpressions(p);
+  p = OptimizeJoinOrder(p);
   p = OptimizeNLJAsHashJoin(p);
+  p = OptimizeNLJAsBlockNLJ(p);
+  p = OptimizeFilterAsIndexScan(p);
   p = OptimizeOrderByAsIndexScan(p);
   p = OptimizeSortLimitAsTopN(p);
+  p = OptimizeHashJoinAsMergeJoin(p);
+  p = OptimizeAggAsStreamAgg(p);
+  p = OptimizeColumnPruning(p);
+  if (parallelism_ > 1) {
+    p = OptimizeParallelize(p);
+  }
+  p = OptimizePushLimits(p);
+  p = OptimizePushRuntimeFilters(p);
   return p;
 }
 
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** @return the columns a list of order-bys sorts on, up to the first one that is not a plain column */
+static auto OrderByColumns(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys)
+    -> std::vector<std::pair<OrderByType, uint32_t>> {
+  std::vector<std::pair<OrderByType, uint32_t>> columns;
+  for (const auto &[order_type, expr] : order_bys) {
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+    if (column_value_expr == nullptr) {
+      break;
+    }
+    columns.emplace_back(order_type == OrderByType::DESC ? OrderByType::DESC : OrderByType::ASC,
+                         column_value_expr->GetColIdx());
+  }
+  return columns;
+}
+
+auto Optimizer::OutputOrdering(const AbstractPlanNodeRef &plan) -> Ordering {
+  switch (plan->GetType()) {
+    case PlanType::Sort:
+      return OrderByColumns(dynamic_cast<const SortPlanNode &>(*plan).GetOrderBy());
+    case PlanType::TopN:
+      return OrderByColumns(dynamic_cast<const TopNPlanNode &>(*plan).GetOrderBy());
+
+    // The index scan walks the B+ tree in key order, unless it reads the tuples in RID order
+    case PlanType::IndexScan: {
+      const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*plan);
+      const auto *index_info = catalog_.GetIndex(index_scan.GetIndexOid());
+      if (index_info == Catalog::NULL_INDEX_INFO || index_scan.sort_rids_) {
+        return {};
+      }
+      Ordering columns;
+      for (auto column : index_info->index_->GetKeyAttrs()) {
+        columns.emplace_back(OrderByType::ASC, column);
+      }
+      return columns;
+    }
+
+    // A merge join emits its matches in the order of its left join keys, which keep their columns in the output
+    case PlanType::MergeJoin: {
+      const auto &join_plan = dynamic_cast<const MergeJoinPlanNode &>(*plan);
+      Ordering columns;
+      for (size_t i = 0; i < join_plan.LeftJoinKeyExpressions().size(); i++) {
+        const auto &key = dynamic_cast<const ColumnValueExpression &>(*join_plan.LeftJoinKeyExpressions()[i]);
+        columns.emplace_back(join_plan.GetKeyOrders()[i], key.GetColIdx());
+      }
+      return columns;
+    }
+
+    // Filters and limits drop rows without reordering the others
+    case PlanType::Filter:
+    case PlanType::Limit:
+      return OutputOrdering(plan->GetChildAt(0));
+
+    // Projections keep the ordering of the columns they pass through, up to the first one they drop
+    case PlanType::Projection: {
+      const auto &exprs = dynamic_cast<const ProjectionPlanNode &>(*plan).GetExpressions();
+      Ordering columns;
+      for (const auto &[order_type, child_column] : OutputOrdering(plan->GetChildAt(0))) {
+        auto it = std::find_if(exprs.begin(), exprs.end(), [&](const AbstractExpressionRef &expr) {
+          const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+          return column_value_expr != nullptr && column_value_expr->GetColIdx() == child_column;
+        });
+        if (it == exprs.end()) {
+          break;
+        }
+        columns.emplace_back(order_type, static_cast<uint32_t>(it - exprs.begin()));
+      }
+      return columns;
+    }
+
+    // A stream aggregation emits its groups in the order of its child
+    case PlanType::StreamAggregation: {
+      const auto &group_bys = dynamic_cast<const AggregationPlanNode &>(*plan).GetGroupBys();
+      Ordering columns;
+      for (const auto &[order_type, child_column] : OutputOrdering(plan->GetChildAt(0))) {
+        auto it = std::find_if(group_bys.begin(), group_bys.end(), [&](const AbstractExpressionRef &expr) {
+          const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+          return column_value_expr != nullptr && column_value_expr->GetColIdx() == child_column;
+        });
+        if (it == group_bys.end()) {
+          break;
+        }
+        columns.emplace_back(order_type, static_cast<uint32_t>(it - group_bys.begin()));
+      }
+      return columns;
+    }
+
+    default:
+      return {};
+  }
+}
+
+}  // namespace bustub
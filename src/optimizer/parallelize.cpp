@@ -0,0 +1,161 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/gather_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/repartition_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/**
+ * Make the first phase of a two-phase aggregation, which each worker runs over its own share of the input. Its output
+ * has the same layout as the aggregation's, with the aggregates typed after their inputs so that partial sums and
+ * extremes keep their values until they are merged.
+ */
+static auto MakePartialAggregation(const AggregationPlanNode &plan, AbstractPlanNodeRef child) -> AbstractPlanNodeRef {
+  std::vector<Column> columns;
+  for (uint32_t i = 0; i < plan.GetGroupBys().size(); i++) {
+    columns.emplace_back(plan.output_schema_->GetColumn(i));
+  }
+  for (size_t i = 0; i < plan.GetAggregates().size(); i++) {
+    auto agg_type = plan.GetAggregateTypes()[i];
+    auto type = plan.GetAggregates()[i]->GetReturnType();
+    if (agg_type == AggregationType::CountStarAggregate || agg_type == AggregationType::CountAggregate) {
+      columns.emplace_back("<unnamed>", TypeId::INTEGER);
+    } else if (type == TypeId::VARCHAR) {
+      columns.emplace_back("<unnamed>", type, 128);
+    } else {
+      columns.emplace_back("<unnamed>", type);
+    }
+  }
+  return std::make_shared<AggregationPlanNode>(std::make_shared<Schema>(columns), std::move(child), plan.GetGroupBys(),
+                                               plan.GetAggregates(), plan.GetAggregateTypes());
+}
+
+/**
+ * Make the second phase of a two-phase aggregation, which merges the partial groups of `partial` into the output of
+ * the aggregation: counts are summed, and sums, minimums and maximums are combined with themselves.
+ */
+static auto MakeFinalAggregation(const AggregationPlanNode &plan, AbstractPlanNodeRef partial) -> AbstractPlanNodeRef {
+  const auto &partial_schema = partial->OutputSchema();
+  const auto num_group_bys = plan.GetGroupBys().size();
+  std::vector<AbstractExpressionRef> group_bys;
+  for (uint32_t i = 0; i < num_group_bys; i++) {
+    group_bys.emplace_back(std::make_shared<ColumnValueExpression>(0, i, partial_schema.GetColumn(i).GetType()));
+  }
+  std::vector<AbstractExpressionRef> aggregates;
+  std::vector<AggregationType> agg_types;
+  for (size_t i = 0; i < plan.GetAggregates().size(); i++) {
+    auto col_idx = static_cast<uint32_t>(num_group_bys + i);
+    aggregates.emplace_back(
+        std::make_shared<ColumnValueExpression>(0, col_idx, partial_schema.GetColumn(col_idx).GetType()));
+    auto agg_type = plan.GetAggregateTypes()[i];
+    if (agg_type == AggregationType::CountStarAggregate || agg_type == AggregationType::CountAggregate) {
+      agg_type = AggregationType::SumAggregate;
+    }
+    agg_types.push_back(agg_type);
+  }
+  return std::make_shared<AggregationPlanNode>(plan.output_schema_, std::move(partial), std::move(group_bys),
+                                               std::move(aggregates), std::move(agg_types));
+}
+
+auto Optimizer::MakeParallelFragment(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  switch (plan->GetType()) {
+    // Scans split their input into morsels between the workers.
+    case PlanType::SeqScan:
+    case PlanType::MockScan:
+      return plan;
+
+    // Tuple-at-a-time operators work on whatever part of the input their worker gets.
+    case PlanType::Filter:
+    case PlanType::Projection: {
+      auto child = MakeParallelFragment(plan->GetChildAt(0));
+      if (child == nullptr) {
+        return nullptr;
+      }
+      return plan->CloneWithChildren({std::move(child)});
+    }
+
+    // Each worker pre-aggregates its share of the input in its own table, and then merges the partial groups of one
+    // hash partition. Without group-bys, there is a single group, which has to be merged above the gather.
+    case PlanType::Aggregation: {
+      const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*plan);
+      if (agg_plan.GetGroupBys().empty()) {
+        return nullptr;
+      }
+      auto child = MakeParallelFragment(agg_plan.GetChildPlan());
+      if (child == nullptr) {
+        return nullptr;
+      }
+      auto partial = MakePartialAggregation(agg_plan, std::move(child));
+      // The partial groups are hashed on their group-by columns
+      std::vector<AbstractExpressionRef> partition_bys;
+      for (uint32_t i = 0; i < agg_plan.GetGroupBys().size(); i++) {
+        partition_bys.emplace_back(
+            std::make_shared<ColumnValueExpression>(0, i, partial->OutputSchema().GetColumn(i).GetType()));
+      }
+      auto repartition =
+          std::make_shared<RepartitionPlanNode>(partial->output_schema_, std::move(partial), std::move(partition_bys));
+      return MakeFinalAggregation(agg_plan, std::move(repartition));
+    }
+
+    // Each worker joins the tuples of one hash partition of the join keys on both sides.
+    case PlanType::HashJoin: {
+      const auto &join_plan = dynamic_cast<const HashJoinPlanNode &>(*plan);
+      auto left = MakeParallelFragment(join_plan.GetLeftPlan());
+      auto right = MakeParallelFragment(join_plan.GetRightPlan());
+      if (left == nullptr || right == nullptr) {
+        return nullptr;
+      }
+      auto left_repartition = std::make_shared<RepartitionPlanNode>(left->output_schema_, std::move(left),
+                                                                    join_plan.LeftJoinKeyExpressions());
+      auto right_repartition = std::make_shared<RepartitionPlanNode>(right->output_schema_, std::move(right),
+                                                                     join_plan.RightJoinKeyExpressions());
+      return plan->CloneWithChildren({std::move(left_repartition), std::move(right_repartition)});
+    }
+
+    default:
+      return nullptr;
+  }
+}
+
+auto Optimizer::OptimizeParallelize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  if (auto fragment = MakeParallelFragment(plan); fragment != nullptr) {
+    return std::make_shared<GatherPlanNode>(plan->output_schema_, std::move(fragment), parallelism_);
+  }
+
+  switch (plan->GetType()) {
+    // Each worker pre-aggregates its share of the input, and the single group is merged above the gather.
+    case PlanType::Aggregation: {
+      const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*plan);
+      if (auto child = MakeParallelFragment(agg_plan.GetChildPlan()); child != nullptr) {
+        auto partial = MakePartialAggregation(agg_plan, std::move(child));
+        auto gather = std::make_shared<GatherPlanNode>(partial->output_schema_, std::move(partial), parallelism_);
+        return MakeFinalAggregation(agg_plan, std::move(gather));
+      }
+      break;
+    }
+    // The inner side of a nested loop join is re-initialized for every outer tuple, which would restart the workers
+    // every time.
+    case PlanType::NestedLoopJoin:
+    // Updates and deletes modify the table they scan, so the scan stays on the calling thread.
+    case PlanType::Update:
+    case PlanType::Delete:
+      return plan;
+    default:
+      break;
+  }
+
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeParallelize(child));
+  }
+  return plan->CloneWithChildren(std::move(children));
+}
+
+}  // namespace bustub
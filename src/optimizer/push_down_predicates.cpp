@@ -0,0 +1,268 @@
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/expression_util.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** @return whether every column the expression reads satisfies `pred` */
+static auto AllColumns(const AbstractExpressionRef &expr,
+                       const std::function<bool(const ColumnValueExpression &)> &pred) -> bool {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    return pred(*column);
+  }
+  for (const auto &child : expr->GetChildren()) {
+    if (!AllColumns(child, pred)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @return the expression with each column replaced by what `map` makes of it */
+static auto MapColumns(const AbstractExpressionRef &expr,
+                       const std::function<AbstractExpressionRef(const ColumnValueExpression &)> &map)
+    -> AbstractExpressionRef {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    return map(*column);
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(MapColumns(child, map));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+/** @return the expression with column `i` replaced by the expression `i` of the child it is evaluated on */
+static auto Substitute(const AbstractExpressionRef &expr, const std::vector<AbstractExpressionRef> &exprs)
+    -> AbstractExpressionRef {
+  return MapColumns(expr, [&](const ColumnValueExpression &column) { return exprs[column.GetColIdx()]; });
+}
+
+/** @return the expression with all of its columns read from tuple 0, for a child of a join to evaluate */
+static auto ToChild(const AbstractExpressionRef &expr) -> AbstractExpressionRef {
+  return MapColumns(expr, [](const ColumnValueExpression &column) {
+    return std::make_shared<ColumnValueExpression>(0, column.GetColIdx(), column.GetReturnType());
+  });
+}
+
+/** @return an expression on the output of a join, with the columns of its right child read from tuple 1 instead */
+static auto ToJoin(const AbstractExpressionRef &expr, uint32_t left_column_count) -> AbstractExpressionRef {
+  return MapColumns(expr, [&](const ColumnValueExpression &column) {
+    if (column.GetColIdx() < left_column_count) {
+      return std::make_shared<ColumnValueExpression>(0, column.GetColIdx(), column.GetReturnType());
+    }
+    return std::make_shared<ColumnValueExpression>(1, column.GetColIdx() - left_column_count, column.GetReturnType());
+  });
+}
+
+/** @return whether the expression reads a column of the given tuple */
+static auto ReadsTuple(const AbstractExpressionRef &expr, uint32_t tuple_idx) -> bool {
+  return !AllColumns(expr, [&](const ColumnValueExpression &column) { return column.GetTupleIdx() != tuple_idx; });
+}
+
+/**
+ * Add the equalities of a column and a constant the conjuncts imply, such as `a = 5` from `a = b AND b = 5`, so that
+ * each of them can be pushed to the relation of its column.
+ */
+static void AddTransitiveEqualities(std::vector<AbstractExpressionRef> *conjuncts) {
+  using ColumnKey = std::pair<uint32_t, uint32_t>;
+  std::map<ColumnKey, size_t> ids;
+  std::vector<AbstractExpressionRef> columns;
+  std::vector<size_t> parents;
+  auto id_of = [&](const AbstractExpressionRef &expr) {
+    const auto &column = dynamic_cast<const ColumnValueExpression &>(*expr);
+    auto [it, inserted] = ids.emplace(ColumnKey{column.GetTupleIdx(), column.GetColIdx()}, columns.size());
+    if (inserted) {
+      columns.push_back(expr);
+      parents.push_back(it->second);
+    }
+    return it->second;
+  };
+  std::function<size_t(size_t)> find = [&](size_t id) {
+    return parents[id] == id ? id : parents[id] = find(parents[id]);
+  };
+
+  std::vector<std::pair<size_t, AbstractExpressionRef>> constants;
+  std::set<std::pair<size_t, std::string>> known;
+  for (const auto &conjunct : *conjuncts) {
+    const auto *comparison = dynamic_cast<const ComparisonExpression *>(conjunct.get());
+    if (comparison == nullptr || comparison->comp_type_ != ComparisonType::Equal) {
+      continue;
+    }
+    auto lhs = comparison->GetChildAt(0);
+    auto rhs = comparison->GetChildAt(1);
+    if (dynamic_cast<const ColumnValueExpression *>(lhs.get()) == nullptr) {
+      std::swap(lhs, rhs);
+    }
+    if (dynamic_cast<const ColumnValueExpression *>(lhs.get()) == nullptr) {
+      continue;
+    }
+    if (dynamic_cast<const ColumnValueExpression *>(rhs.get()) != nullptr) {
+      parents[find(id_of(lhs))] = find(id_of(rhs));
+    } else if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(rhs.get()); constant != nullptr) {
+      const auto id = id_of(lhs);
+      constants.emplace_back(id, rhs);
+      known.emplace(id, constant->val_.ToString());
+    }
+  }
+
+  for (const auto &[id, constant] : constants) {
+    const auto value = dynamic_cast<const ConstantValueExpression &>(*constant).val_.ToString();
+    for (size_t other = 0; other < columns.size(); other++) {
+      if (find(other) == find(id) && known.emplace(other, value).second) {
+        conjuncts->push_back(std::make_shared<ComparisonExpression>(columns[other], constant, ComparisonType::Equal));
+      }
+    }
+  }
+}
+
+static auto PushDown(const AbstractPlanNodeRef &plan, std::vector<AbstractExpressionRef> conjuncts)
+    -> AbstractPlanNodeRef;
+
+/** @return the plan with the predicates below it pushed down, and the conjuncts checked by a filter right above it */
+static auto KeepAbove(const AbstractPlanNodeRef &plan, const std::vector<AbstractExpressionRef> &conjuncts)
+    -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(PushDown(child, {}));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+  if (conjuncts.empty()) {
+    return optimized_plan;
+  }
+  return std::make_shared<FilterPlanNode>(optimized_plan->output_schema_, MakeConjunction(conjuncts),
+                                          std::move(optimized_plan));
+}
+
+/** @return the plan with the conjuncts, which are on its output, checked as far down as they can go */
+static auto PushDown(const AbstractPlanNodeRef &plan, std::vector<AbstractExpressionRef> conjuncts)
+    -> AbstractPlanNodeRef {
+  switch (plan->GetType()) {
+    case PlanType::Filter: {
+      const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*plan);
+      SplitConjuncts(filter_plan.GetPredicate(), &conjuncts);
+      return PushDown(filter_plan.GetChildPlan(), std::move(conjuncts));
+    }
+    // Sorting keeps the tuples as they are, and a projection computes its columns the same way below it
+    case PlanType::Sort:
+      return plan->CloneWithChildren({PushDown(plan->GetChildAt(0), std::move(conjuncts))});
+    case PlanType::Projection: {
+      const auto &projection_plan = dynamic_cast<const ProjectionPlanNode &>(*plan);
+      for (auto &conjunct : conjuncts) {
+        conjunct = Substitute(conjunct, projection_plan.GetExpressions());
+      }
+      return plan->CloneWithChildren({PushDown(projection_plan.GetChildPlan(), std::move(conjuncts))});
+    }
+    // A conjunct of the group-by columns only drops whole groups. Without group-bys, the aggregation outputs a row
+    // even for no input, so nothing goes below it.
+    case PlanType::Aggregation: {
+      const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*plan);
+      const auto &group_bys = agg_plan.GetGroupBys();
+      std::vector<AbstractExpressionRef> below;
+      std::vector<AbstractExpressionRef> above;
+      for (const auto &conjunct : conjuncts) {
+        if (!group_bys.empty() && AllColumns(conjunct, [&](const ColumnValueExpression &column) {
+              return column.GetColIdx() < group_bys.size();
+            })) {
+          below.push_back(Substitute(conjunct, group_bys));
+        } else {
+          above.push_back(conjunct);
+        }
+      }
+      auto optimized_plan = plan->CloneWithChildren({PushDown(agg_plan.GetChildPlan(), std::move(below))});
+      if (above.empty()) {
+        return optimized_plan;
+      }
+      return std::make_shared<FilterPlanNode>(plan->output_schema_, MakeConjunction(above), std::move(optimized_plan));
+    }
+    case PlanType::NestedLoopJoin: {
+      const auto &join_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+      const auto left_column_count = join_plan.GetLeftPlan()->OutputSchema().GetColumnCount();
+      std::vector<AbstractExpressionRef> join_conjuncts;
+      SplitConjuncts(join_plan.Predicate(), &join_conjuncts);
+      std::vector<AbstractExpressionRef> left;
+      std::vector<AbstractExpressionRef> right;
+      std::vector<AbstractExpressionRef> on;
+      std::vector<AbstractExpressionRef> above;
+      if (join_plan.GetJoinType() == JoinType::INNER) {
+        // The WHERE and ON conjuncts of an inner join are alike: each goes to the one child it reads, if there is one
+        for (const auto &conjunct : conjuncts) {
+          join_conjuncts.push_back(ToJoin(conjunct, left_column_count));
+        }
+        AddTransitiveEqualities(&join_conjuncts);
+        for (const auto &conjunct : join_conjuncts) {
+          if (!ReadsTuple(conjunct, 1)) {
+            left.push_back(ToChild(conjunct));
+          } else if (!ReadsTuple(conjunct, 0)) {
+            right.push_back(ToChild(conjunct));
+          } else {
+            on.push_back(conjunct);
+          }
+        }
+      } else if (join_plan.GetJoinType() == JoinType::LEFT) {
+        // Each left tuple is output whether it matches or not, so only a WHERE conjunct can drop one, and only an ON
+        // conjunct can drop a right tuple
+        for (const auto &conjunct : conjuncts) {
+          if (AllColumns(conjunct, [&](const ColumnValueExpression &column) {
+                return column.GetColIdx() < left_column_count;
+              })) {
+            left.push_back(conjunct);
+          } else {
+            above.push_back(conjunct);
+          }
+        }
+        for (const auto &conjunct : join_conjuncts) {
+          if (!ReadsTuple(conjunct, 0)) {
+            right.push_back(ToChild(conjunct));
+          } else {
+            on.push_back(conjunct);
+          }
+        }
+      } else {
+        return KeepAbove(plan, conjuncts);
+      }
+      AbstractPlanNodeRef optimized_plan = std::make_shared<NestedLoopJoinPlanNode>(
+          join_plan.output_schema_, PushDown(join_plan.GetLeftPlan(), std::move(left)),
+          PushDown(join_plan.GetRightPlan(), std::move(right)), MakeConjunction(on), join_plan.GetJoinType());
+      if (above.empty()) {
+        return optimized_plan;
+      }
+      return std::make_shared<FilterPlanNode>(plan->output_schema_, MakeConjunction(above), std::move(optimized_plan));
+    }
+    case PlanType::SeqScan: {
+      const auto &scan_plan = dynamic_cast<const SeqScanPlanNode &>(*plan);
+      if (conjuncts.empty()) {
+        return plan;
+      }
+      if (scan_plan.filter_predicate_ != nullptr) {
+        SplitConjuncts(scan_plan.filter_predicate_, &conjuncts);
+      }
+      return std::make_shared<SeqScanPlanNode>(scan_plan.output_schema_, scan_plan.table_oid_, scan_plan.table_name_,
+                                               MakeConjunction(conjuncts));
+    }
+    default:
+      return KeepAbove(plan, conjuncts);
+  }
+}
+
+auto Optimizer::OptimizePushDownPredicates(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  return PushDown(plan, {});
+}
+
+}  // namespace bustub
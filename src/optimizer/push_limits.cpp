@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/gather_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** @return whether the workers running `plan` trade tuples through a repartition exchange */
+static auto HasExchange(const AbstractPlanNode &plan) -> bool {
+  if (plan.GetType() == PlanType::Repartition) {
+    return true;
+  }
+  return std::any_of(plan.GetChildren().begin(), plan.GetChildren().end(),
+                     [](const AbstractPlanNodeRef &child) { return HasExchange(*child); });
+}
+
+/** @return a plan producing the first `limit` tuples of `plan`, with the limit moved as far down as it goes */
+static auto PushLimit(const AbstractPlanNodeRef &plan, size_t limit) -> AbstractPlanNodeRef {
+  switch (plan->GetType()) {
+    // A limit of a limit keeps the smaller one.
+    case PlanType::Limit: {
+      const auto &limit_plan = dynamic_cast<const LimitPlanNode &>(*plan);
+      return PushLimit(limit_plan.GetChildPlan(), std::min(limit, limit_plan.GetLimit()));
+    }
+    // A projection maps each input tuple to one output tuple, so it only has to evaluate the first `limit` of them.
+    case PlanType::Projection: {
+      const auto &projection_plan = dynamic_cast<const ProjectionPlanNode &>(*plan);
+      return plan->CloneWithChildren({PushLimit(projection_plan.GetChildPlan(), limit)});
+    }
+    // Each worker stops after `limit` tuples, and the limit above the gather keeps the first `limit` of all of them.
+    // Workers trading tuples through an exchange have to drain their input for the others, so they are left alone.
+    case PlanType::Gather: {
+      const auto &gather_plan = dynamic_cast<const GatherPlanNode &>(*plan);
+      if (HasExchange(*gather_plan.GetChildPlan())) {
+        break;
+      }
+      auto gather = plan->CloneWithChildren({PushLimit(gather_plan.GetChildPlan(), limit)});
+      return std::make_shared<LimitPlanNode>(plan->output_schema_, std::move(gather), limit);
+    }
+    default:
+      break;
+  }
+  return std::make_shared<LimitPlanNode>(plan->output_schema_, plan, limit);
+}
+
+auto Optimizer::OptimizePushLimits(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizePushLimits(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Limit) {
+    const auto &limit_plan = dynamic_cast<const LimitPlanNode &>(*optimized_plan);
+    return PushLimit(limit_plan.GetChildPlan(), limit_plan.GetLimit());
+  }
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,130 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** @return the join key expressions over the output of a scan, for the join key columns of its output */
+static auto ScanKeyExpressions(const AbstractPlanNode &scan, const std::vector<uint32_t> &key_columns)
+    -> std::vector<AbstractExpressionRef> {
+  std::vector<AbstractExpressionRef> key_expressions;
+  for (auto col_idx : key_columns) {
+    key_expressions.emplace_back(
+        std::make_shared<ColumnValueExpression>(0, col_idx, scan.OutputSchema().GetColumn(col_idx).GetType()));
+  }
+  return key_expressions;
+}
+
+/**
+ * Push a runtime filter down to the scan some output columns of a plan come from. Only operators that neither pull
+ * rows from that scan before the join above has built the filter, nor keep rows whose key cannot match, are crossed.
+ * @param plan the plan on the probe side of the join
+ * @param filter_id the identifier of the runtime filter
+ * @param key_columns the output columns of `plan` the join keys are made of
+ * @return the plan with its scan checking the filter, or nullptr if the filter cannot be pushed down
+ */
+static auto PushRuntimeFilter(const AbstractPlanNodeRef &plan, size_t filter_id,
+                              const std::vector<uint32_t> &key_columns) -> AbstractPlanNodeRef {
+  switch (plan->GetType()) {
+    case PlanType::SeqScan: {
+      auto scan = std::make_shared<SeqScanPlanNode>(dynamic_cast<const SeqScanPlanNode &>(*plan));
+      scan->runtime_filters_.push_back({filter_id, ScanKeyExpressions(*scan, key_columns)});
+      return scan;
+    }
+    case PlanType::MockScan: {
+      auto scan = std::make_shared<MockScanPlanNode>(dynamic_cast<const MockScanPlanNode &>(*plan));
+      scan->runtime_filters_.push_back({filter_id, ScanKeyExpressions(*scan, key_columns)});
+      return scan;
+    }
+    case PlanType::Filter: {
+      auto child = PushRuntimeFilter(plan->GetChildAt(0), filter_id, key_columns);
+      return child == nullptr ? nullptr : AbstractPlanNodeRef{plan->CloneWithChildren({child})};
+    }
+    case PlanType::Projection: {
+      const auto &projection = dynamic_cast<const ProjectionPlanNode &>(*plan);
+      std::vector<uint32_t> child_columns;
+      for (auto col_idx : key_columns) {
+        const auto *column_value_expr =
+            dynamic_cast<const ColumnValueExpression *>(projection.GetExpressions()[col_idx].get());
+        if (column_value_expr == nullptr) {
+          return nullptr;
+        }
+        child_columns.push_back(column_value_expr->GetColIdx());
+      }
+      auto child = PushRuntimeFilter(projection.GetChildPlan(), filter_id, child_columns);
+      return child == nullptr ? nullptr : AbstractPlanNodeRef{plan->CloneWithChildren({child})};
+    }
+    case PlanType::HashJoin: {
+      // A left tuple whose key cannot match the join above only produces output tuples that cannot match it either,
+      // in inner and left joins alike. The left child is never pulled before the build side is drained.
+      const auto &join = dynamic_cast<const HashJoinPlanNode &>(*plan);
+      auto left_columns = join.GetLeftPlan()->OutputSchema().GetColumnCount();
+      for (auto col_idx : key_columns) {
+        if (col_idx >= left_columns) {
+          return nullptr;
+        }
+      }
+      auto left = PushRuntimeFilter(join.GetLeftPlan(), filter_id, key_columns);
+      return left == nullptr ? nullptr : AbstractPlanNodeRef{plan->CloneWithChildren({left, join.GetRightPlan()})};
+    }
+    default:
+      return nullptr;
+  }
+}
+
+/** Push down the runtime filters of the hash joins of a plan, numbering them from `*next_filter_id`. */
+static auto PushRuntimeFilters(const AbstractPlanNodeRef &plan, size_t *next_filter_id) -> AbstractPlanNodeRef {
+  if (plan->GetType() == PlanType::Gather) {
+    return plan;
+  }
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(PushRuntimeFilters(child, next_filter_id));
+  }
+  AbstractPlanNodeRef optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::HashJoin) {
+    return optimized_plan;
+  }
+  const auto &join = dynamic_cast<const HashJoinPlanNode &>(*optimized_plan);
+  // A left join keeps the left tuples that do not match
+  if (join.GetJoinType() != JoinType::INNER) {
+    return optimized_plan;
+  }
+  std::vector<uint32_t> key_columns;
+  for (size_t i = 0; i < join.LeftJoinKeyExpressions().size(); i++) {
+    const auto &left_key = join.LeftJoinKeyExpressions()[i];
+    const auto &right_key = join.RightJoinKeyExpressions()[i];
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(left_key.get());
+    // The filter hashes probe keys the way the join hashes build keys, which only agree on keys of the same type
+    if (column_value_expr == nullptr || left_key->GetReturnType() != right_key->GetReturnType()) {
+      return optimized_plan;
+    }
+    key_columns.push_back(column_value_expr->GetColIdx());
+  }
+
+  auto left = PushRuntimeFilter(join.GetLeftPlan(), *next_filter_id, key_columns);
+  if (left == nullptr) {
+    return optimized_plan;
+  }
+  auto filtered_join = std::make_shared<HashJoinPlanNode>(join);
+  filtered_join->children_ = {left, join.GetRightPlan()};
+  filtered_join->runtime_filter_id_ = (*next_filter_id)++;
+  return filtered_join;
+}
+
+auto Optimizer::OptimizePushRuntimeFilters(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  size_t next_filter_id = 0;
+  return PushRuntimeFilters(plan, &next_filter_id);
+}
+
+}  // namespace bustub
@@ -0,0 +1,405 @@
+#include <exception>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/expressions/string_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/block_nested_loop_join_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/values_plan.h"
+#include "optimizer/expression_util.h"
+#include "optimizer/optimizer.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** @return the value of a constant boolean expression, nullopt if it is not a constant or is NULL */
+static auto AsBool(const AbstractExpressionRef &expr) -> std::optional<bool> {
+  const auto *constant = dynamic_cast<const ConstantValueExpression *>(expr.get());
+  if (constant == nullptr || constant->val_.GetTypeId() != TypeId::BOOLEAN || constant->val_.IsNull()) {
+    return std::nullopt;
+  }
+  return constant->val_.GetAs<bool>();
+}
+
+static auto MakeBool(bool value) -> AbstractExpressionRef {
+  return std::make_shared<ConstantValueExpression>(ValueFactory::GetBooleanValue(value));
+}
+
+/** @return whether the plan is known to output no tuple */
+static auto IsEmpty(const AbstractPlanNodeRef &plan) -> bool {
+  return plan->GetType() == PlanType::Values && dynamic_cast<const ValuesPlanNode &>(*plan).GetValues().empty();
+}
+
+/** @return a plan outputting no tuple in place of the given one */
+static auto MakeEmpty(const AbstractPlanNode &plan) -> AbstractPlanNodeRef {
+  return std::make_shared<ValuesPlanNode>(plan.output_schema_, std::vector<std::vector<AbstractExpressionRef>>{});
+}
+
+/** @return the expression evaluated once, or as it is if it cannot be evaluated without a tuple */
+static auto Fold(const AbstractExpressionRef &expr) -> AbstractExpressionRef {
+  if (dynamic_cast<const ArithmeticExpression *>(expr.get()) == nullptr &&
+      dynamic_cast<const ComparisonExpression *>(expr.get()) == nullptr &&
+      dynamic_cast<const LogicExpression *>(expr.get()) == nullptr &&
+      dynamic_cast<const StringExpression *>(expr.get()) == nullptr) {
+    return expr;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    if (dynamic_cast<const ConstantValueExpression *>(child.get()) == nullptr) {
+      return expr;
+    }
+  }
+  // An expression that fails on its constants is left for the executor to report, if it ever evaluates it
+  try {
+    const Schema empty_schema{std::vector<Column>{}};
+    return std::make_shared<ConstantValueExpression>(expr->Evaluate(nullptr, empty_schema));
+  } catch (const std::exception &) {
+    return expr;
+  }
+}
+
+/** A comparison of a column and a constant that is not NULL, with the column on the left */
+struct ColumnBound {
+  size_t conjunct_idx_;
+  ComparisonType comp_type_;
+  Value value_;
+};
+
+/** @return the comparison as a bound on a column, if it compares a column and a constant */
+static auto AsColumnBound(const AbstractExpressionRef &expr, size_t conjunct_idx)
+    -> std::optional<std::pair<std::string, ColumnBound>> {
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (comparison == nullptr) {
+    return std::nullopt;
+  }
+  auto comp_type = comparison->comp_type_;
+  const auto *column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0).get());
+  const auto *constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(1).get());
+  if (column == nullptr) {
+    column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1).get());
+    constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(0).get());
+    switch (comp_type) {
+      case ComparisonType::LessThan:
+        comp_type = ComparisonType::GreaterThan;
+        break;
+      case ComparisonType::LessThanOrEqual:
+        comp_type = ComparisonType::GreaterThanOrEqual;
+        break;
+      case ComparisonType::GreaterThan:
+        comp_type = ComparisonType::LessThan;
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        comp_type = ComparisonType::LessThanOrEqual;
+        break;
+      default:
+        break;
+    }
+  }
+  if (column == nullptr || constant == nullptr || constant->val_.IsNull()) {
+    return std::nullopt;
+  }
+  return std::make_pair(column->ToString(), ColumnBound{conjunct_idx, comp_type, constant->val_});
+}
+
+/** @return whether the value satisfies the bound */
+static auto Satisfies(const Value &value, const ColumnBound &bound) -> bool {
+  switch (bound.comp_type_) {
+    case ComparisonType::Equal:
+      return value.CompareEquals(bound.value_) == CmpBool::CmpTrue;
+    case ComparisonType::NotEqual:
+      return value.CompareNotEquals(bound.value_) == CmpBool::CmpTrue;
+    case ComparisonType::LessThan:
+      return value.CompareLessThan(bound.value_) == CmpBool::CmpTrue;
+    case ComparisonType::LessThanOrEqual:
+      return value.CompareLessThanEquals(bound.value_) == CmpBool::CmpTrue;
+    case ComparisonType::GreaterThan:
+      return value.CompareGreaterThan(bound.value_) == CmpBool::CmpTrue;
+    case ComparisonType::GreaterThanOrEqual:
+      return value.CompareGreaterThanEquals(bound.value_) == CmpBool::CmpTrue;
+  }
+  return false;
+}
+
+/** @return whether the lower bound `a` is at least as tight as the lower bound `b`, both strict or not */
+static auto IsTighterLower(const ColumnBound &a, const ColumnBound &b) -> bool {
+  if (a.value_.CompareEquals(b.value_) == CmpBool::CmpTrue) {
+    return a.comp_type_ == ComparisonType::GreaterThan || b.comp_type_ == ComparisonType::GreaterThanOrEqual;
+  }
+  return a.value_.CompareGreaterThan(b.value_) == CmpBool::CmpTrue;
+}
+
+/** @return whether the upper bound `a` is at least as tight as the upper bound `b` */
+static auto IsTighterUpper(const ColumnBound &a, const ColumnBound &b) -> bool {
+  if (a.value_.CompareEquals(b.value_) == CmpBool::CmpTrue) {
+    return a.comp_type_ == ComparisonType::LessThan || b.comp_type_ == ComparisonType::LessThanOrEqual;
+  }
+  return a.value_.CompareLessThan(b.value_) == CmpBool::CmpTrue;
+}
+
+/**
+ * Drop the comparisons of a column and a constant that others on the same column imply, such as `a > 3` next to
+ * `a > 5` or `a = 7`. Comparisons that cannot hold together, such as `a = 1 AND a = 2`, leave FALSE alone.
+ */
+static void SimplifyBounds(std::vector<AbstractExpressionRef> *conjuncts) {
+  std::map<std::string, std::vector<ColumnBound>> bounds;
+  for (size_t i = 0; i < conjuncts->size(); i++) {
+    if (auto bound = AsColumnBound((*conjuncts)[i], i); bound.has_value()) {
+      bounds[bound->first].push_back(std::move(bound->second));
+    }
+  }
+
+  std::set<size_t> dropped;
+  for (const auto &[column, column_bounds] : bounds) {
+    // Only constants of one type are compared with one another
+    bool same_type = true;
+    for (const auto &bound : column_bounds) {
+      same_type = same_type && bound.value_.GetTypeId() == column_bounds[0].value_.GetTypeId();
+    }
+    if (!same_type) {
+      continue;
+    }
+
+    const ColumnBound *equal = nullptr;
+    const ColumnBound *lower = nullptr;
+    const ColumnBound *upper = nullptr;
+    for (const auto &bound : column_bounds) {
+      switch (bound.comp_type_) {
+        case ComparisonType::Equal:
+          equal = equal == nullptr ? &bound : equal;
+          break;
+        case ComparisonType::GreaterThan:
+        case ComparisonType::GreaterThanOrEqual:
+          lower = lower == nullptr || !IsTighterLower(*lower, bound) ? &bound : lower;
+          break;
+        case ComparisonType::LessThan:
+        case ComparisonType::LessThanOrEqual:
+          upper = upper == nullptr || !IsTighterUpper(*upper, bound) ? &bound : upper;
+          break;
+        case ComparisonType::NotEqual:
+          break;
+      }
+    }
+
+    for (const auto &bound : column_bounds) {
+      if (equal != nullptr) {
+        // The column has a single value, which every other comparison is either true or false for
+        if (&bound != equal) {
+          if (!Satisfies(equal->value_, bound)) {
+            *conjuncts = {MakeBool(false)};
+            return;
+          }
+          dropped.insert(bound.conjunct_idx_);
+        }
+      } else if (bound.comp_type_ != ComparisonType::NotEqual && &bound != lower && &bound != upper) {
+        dropped.insert(bound.conjunct_idx_);
+      }
+    }
+    if (equal == nullptr && lower != nullptr && upper != nullptr && !Satisfies(lower->value_, *upper)) {
+      *conjuncts = {MakeBool(false)};
+      return;
+    }
+    if (equal == nullptr && lower != nullptr && upper != nullptr &&
+        (lower->comp_type_ == ComparisonType::GreaterThan || upper->comp_type_ == ComparisonType::LessThan) &&
+        lower->value_.CompareEquals(upper->value_) == CmpBool::CmpTrue) {
+      *conjuncts = {MakeBool(false)};
+      return;
+    }
+  }
+
+  std::vector<AbstractExpressionRef> kept;
+  for (size_t i = 0; i < conjuncts->size(); i++) {
+    if (dropped.count(i) == 0) {
+      kept.push_back((*conjuncts)[i]);
+    }
+  }
+  *conjuncts = std::move(kept);
+}
+
+/**
+ * @return the AND or OR of the simplified operands: without the operands that do not change it, without the repeated
+ * ones, or the one constant that decides it.
+ */
+static auto SimplifyLogic(const LogicExpression &logic, const AbstractExpressionRef &expr, bool is_predicate)
+    -> AbstractExpressionRef {
+  const bool is_and = logic.logic_type_ == LogicType::And;
+  std::vector<AbstractExpressionRef> terms;
+  SplitTerms(expr, logic.logic_type_, &terms);
+  std::vector<AbstractExpressionRef> kept;
+  std::set<std::string> seen;
+  for (const auto &term : terms) {
+    if (auto value = AsBool(term); value.has_value()) {
+      if (*value != is_and) {
+        return term;
+      }
+      continue;
+    }
+    if (seen.insert(term->ToString()).second) {
+      kept.push_back(term);
+    }
+  }
+  // A column is NULL or not whatever the constants it is compared with, so only a predicate can be found always false
+  if (is_and && is_predicate) {
+    // Constants of a type without an order are left as they are
+    try {
+      SimplifyBounds(&kept);
+    } catch (const std::exception &) {
+    }
+    if (auto value = AsBool(kept.empty() ? nullptr : kept[0]); value.has_value() && !*value) {
+      return kept[0];
+    }
+  }
+  if (kept.empty()) {
+    return MakeBool(is_and);
+  }
+  auto simplified = kept[0];
+  for (size_t i = 1; i < kept.size(); i++) {
+    simplified = std::make_shared<LogicExpression>(std::move(simplified), kept[i], logic.logic_type_);
+  }
+  return simplified;
+}
+
+/**
+ * @return the expression with its constant subtrees evaluated and its boolean algebra simplified. A predicate drops a
+ * row that it is NULL for as it does one it is false for, and so do the ANDs and ORs under it, so a NULL among them
+ * is simplified to false.
+ */
+static auto Simplify(const AbstractExpressionRef &expr, bool is_predicate) -> AbstractExpressionRef {
+  if (expr == nullptr) {
+    return expr;
+  }
+  const auto *logic = dynamic_cast<const LogicExpression *>(expr.get());
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(Simplify(child, is_predicate && logic != nullptr));
+  }
+  AbstractExpressionRef simplified = expr;
+  if (!children.empty()) {
+    simplified = Fold(expr->CloneWithChildren(std::move(children)));
+  }
+
+  if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(simplified.get());
+      constant != nullptr && is_predicate && constant->val_.IsNull()) {
+    return MakeBool(false);
+  }
+  if (const auto *simplified_logic = dynamic_cast<const LogicExpression *>(simplified.get());
+      simplified_logic != nullptr) {
+    return SimplifyLogic(*simplified_logic, simplified, is_predicate);
+  }
+  // A column is never less than, greater than or different from itself, even NULL, which the predicate drops anyway
+  if (const auto *comparison = dynamic_cast<const ComparisonExpression *>(simplified.get());
+      comparison != nullptr && is_predicate &&
+      dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0).get()) != nullptr &&
+      comparison->GetChildAt(0)->ToString() == comparison->GetChildAt(1)->ToString()) {
+    if (comparison->comp_type_ == ComparisonType::NotEqual || comparison->comp_type_ == ComparisonType::LessThan ||
+        comparison->comp_type_ == ComparisonType::GreaterThan) {
+      return MakeBool(false);
+    }
+  }
+  return simplified;
+}
+
+auto Optimizer::OptimizeSimplifyExpressions(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeSimplifyExpressions(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  switch (optimized_plan->GetType()) {
+    case PlanType::Filter: {
+      const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*optimized_plan);
+      auto predicate = Simplify(filter_plan.GetPredicate(), true);
+      const auto value = AsBool(predicate);
+      if (IsEmpty(filter_plan.GetChildPlan()) || value == false) {
+        return MakeEmpty(*optimized_plan);
+      }
+      if (value == true) {
+        return filter_plan.GetChildPlan();
+      }
+      return std::make_shared<FilterPlanNode>(filter_plan.output_schema_, std::move(predicate),
+                                              filter_plan.GetChildPlan());
+    }
+    case PlanType::NestedLoopJoin:
+    case PlanType::BlockNestedLoopJoin: {
+      const bool is_nlj = optimized_plan->GetType() == PlanType::NestedLoopJoin;
+      const auto &predicate = is_nlj ? dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan).Predicate()
+                                     : dynamic_cast<const BlockNestedLoopJoinPlanNode &>(*optimized_plan).Predicate();
+      const auto join_type = is_nlj ? dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan).GetJoinType()
+                                    : dynamic_cast<const BlockNestedLoopJoinPlanNode &>(*optimized_plan).GetJoinType();
+      auto simplified = Simplify(predicate, true);
+      // An inner join outputs nothing without a match, and a left join nothing without a left tuple
+      if (IsEmpty(optimized_plan->GetChildAt(0)) ||
+          (join_type == JoinType::INNER && (IsEmpty(optimized_plan->GetChildAt(1)) || AsBool(simplified) == false))) {
+        return MakeEmpty(*optimized_plan);
+      }
+      if (is_nlj) {
+        return std::make_shared<NestedLoopJoinPlanNode>(optimized_plan->output_schema_, optimized_plan->GetChildAt(0),
+                                                        optimized_plan->GetChildAt(1), std::move(simplified),
+                                                        join_type);
+      }
+      return std::make_shared<BlockNestedLoopJoinPlanNode>(optimized_plan->output_schema_,
+                                                           optimized_plan->GetChildAt(0),
+                                                           optimized_plan->GetChildAt(1), std::move(simplified),
+                                                           join_type);
+    }
+    case PlanType::SeqScan: {
+      const auto &scan_plan = dynamic_cast<const SeqScanPlanNode &>(*optimized_plan);
+      if (scan_plan.filter_predicate_ == nullptr) {
+        return optimized_plan;
+      }
+      auto scan = std::make_shared<SeqScanPlanNode>(scan_plan);
+      scan->filter_predicate_ = Simplify(scan_plan.filter_predicate_, true);
+      if (auto value = AsBool(scan->filter_predicate_); value.has_value()) {
+        if (!*value) {
+          return MakeEmpty(*optimized_plan);
+        }
+        scan->filter_predicate_ = nullptr;
+      }
+      return scan;
+    }
+    case PlanType::Projection: {
+      const auto &projection_plan = dynamic_cast<const ProjectionPlanNode &>(*optimized_plan);
+      if (IsEmpty(projection_plan.GetChildPlan())) {
+        return MakeEmpty(*optimized_plan);
+      }
+      std::vector<AbstractExpressionRef> exprs;
+      for (const auto &expr : projection_plan.GetExpressions()) {
+        exprs.emplace_back(Simplify(expr, false));
+      }
+      return std::make_shared<ProjectionPlanNode>(projection_plan.output_schema_, std::move(exprs),
+                                                  projection_plan.GetChildPlan());
+    }
+    // Without group-bys, an aggregation outputs a row even for no input
+    case PlanType::Aggregation:
+      if (IsEmpty(optimized_plan->GetChildAt(0)) &&
+          !dynamic_cast<const AggregationPlanNode &>(*optimized_plan).GetGroupBys().empty()) {
+        return MakeEmpty(*optimized_plan);
+      }
+      return optimized_plan;
+    case PlanType::Sort:
+    case PlanType::Limit:
+    case PlanType::TopN:
+      if (IsEmpty(optimized_plan->GetChildAt(0))) {
+        return MakeEmpty(*optimized_plan);
+      }
+      return optimized_plan;
+    default:
+      return optimized_plan;
+  }
+}
+
+}  // namespace bustub
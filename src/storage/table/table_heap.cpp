@@ -13,7 +13,9 @@
 #include <cassert>
 #include <mutex>  // NOLINT
 #include <utility>
+#include <vector>
 
+#include "catalog/table_stats.h"
 #include "common/config.h"
 #include "common/exception.h"
 #include "common/logger.h"
@@ -82,12 +84,26 @@ auto TableHeap::InsertTuple(const TupleMeta &meta, const Tuple &tuple, LockManag
 
   page_guard.Drop();
 
+  if (auto stats = GetStats(); stats != nullptr && !meta.is_deleted_) {
+    stats->Insert(tuple);
+  }
+
   return RID(last_page_id, slot_id);
 }
 
 void TableHeap::UpdateTupleMeta(const TupleMeta &meta, RID rid) {
   auto page_guard = bpm_->FetchPageWrite(rid.GetPageId());
   auto page = page_guard.AsMut<TablePage>();
+  auto stats = GetStats();
+  if (stats != nullptr) {
+    // Deleting a tuple, or undoing its deletion, is done by flipping the deleted flag
+    auto [old_meta, tuple] = page->GetTuple(rid);
+    if (!old_meta.is_deleted_ && meta.is_deleted_) {
+      stats->Delete(tuple);
+    } else if (old_meta.is_deleted_ && !meta.is_deleted_) {
+      stats->Insert(tuple);
+    }
+  }
   page->UpdateTupleMeta(meta, rid);
 }
 
@@ -99,6 +115,23 @@ auto TableHeap::GetTuple(RID rid) -> std::pair<TupleMeta, Tuple> {
   return std::make_pair(meta, std::move(tuple));
 }
 
+auto TableHeap::GetTuples(const std::vector<RID> &rids) -> std::vector<std::pair<TupleMeta, Tuple>> {
+  std::vector<std::pair<TupleMeta, Tuple>> result;
+  result.reserve(rids.size());
+  ReadPageGuard page_guard;
+  page_id_t page_id = INVALID_PAGE_ID;
+  for (const auto &rid : rids) {
+    if (rid.GetPageId() != page_id) {
+      page_id = rid.GetPageId();
+      page_guard = bpm_->FetchPageRead(page_id);
+    }
+    auto [meta, tuple] = page_guard.As<TablePage>()->GetTuple(rid);
+    tuple.rid_ = rid;
+    result.emplace_back(meta, std::move(tuple));
+  }
+  return result;
+}
+
 auto TableHeap::GetTupleMeta(RID rid) -> TupleMeta {
   auto page_guard = bpm_->FetchPageRead(rid.GetPageId());
   auto page = page_guard.As<TablePage>();
@@ -120,7 +153,26 @@ auto TableHeap::MakeEagerIterator() -> TableIterator { return {this, {first_page
 void TableHeap::UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tuple, RID rid) {
   auto page_guard = bpm_->FetchPageWrite(rid.GetPageId());
   auto page = page_guard.AsMut<TablePage>();
+  if (auto stats = GetStats(); stats != nullptr) {
+    auto [old_meta, old_tuple] = page->GetTuple(rid);
+    if (!old_meta.is_deleted_) {
+      stats->Delete(old_tuple);
+    }
+    if (!meta.is_deleted_) {
+      stats->Insert(tuple);
+    }
+  }
   page->UpdateTupleInPlaceUnsafe(meta, tuple, rid);
 }
 
+void TableHeap::SetStats(std::shared_ptr<TableStats> stats) {
+  std::scoped_lock guard(latch_);
+  stats_ = std::move(stats);
+}
+
+auto TableHeap::GetStats() -> std::shared_ptr<TableStats> {
+  std::scoped_lock guard(latch_);
+  return stats_;
+}
+
 }  // namespace bustub
@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.cpp
+//
+// Identification: src/storage/table/tmp_tuple_file.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/tmp_tuple_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+TmpTupleFile::TmpTupleFile(BufferPoolManager *bpm) : bpm_(bpm) { buffer_.Init(INVALID_PAGE_ID, BUSTUB_PAGE_SIZE); }
+
+TmpTupleFile::~TmpTupleFile() {
+  for (auto page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+void TmpTupleFile::Append(const Tuple &tuple) {
+  TmpTuple location(INVALID_PAGE_ID, 0);
+  if (!buffer_.Insert(tuple, &location)) {
+    FlushBuffer();
+    if (!buffer_.Insert(tuple, &location)) {
+      throw ExecutionException("tuple too large to be spilled to a temporary page");
+    }
+  }
+  buffer_tuples_++;
+  num_tuples_++;
+  num_bytes_ += tuple.GetLength();
+}
+
+void TmpTupleFile::FlushBuffer() {
+  if (buffer_tuples_ == 0) {
+    return;
+  }
+  page_id_t page_id;
+  auto *page = bpm_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw ExecutionException("no free frame in the buffer pool to spill tuples to");
+  }
+  memcpy(page->GetData(), buffer_.GetData(), BUSTUB_PAGE_SIZE);
+  memcpy(page->GetData(), &page_id, sizeof(page_id_t));
+  bpm_->UnpinPage(page_id, true);
+  page_ids_.push_back(page_id);
+  buffer_.Init(INVALID_PAGE_ID, BUSTUB_PAGE_SIZE);
+  buffer_tuples_ = 0;
+}
+
+void TmpTupleFile::Rewind() {
+  FlushBuffer();
+  read_page_ = 0;
+  read_buffer_.clear();
+  read_cursor_ = 0;
+}
+
+void TmpTupleFile::LoadPage(page_id_t page_id) {
+  auto *page = bpm_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw ExecutionException("no free frame in the buffer pool to read spilled tuples from");
+  }
+  auto *tmp_page = reinterpret_cast<TmpTuplePage *>(page);
+  // Tuples are stacked from the end of the page, so walking up from the free space pointer yields the last appended
+  // tuple first.
+  read_buffer_.clear();
+  for (uint32_t offset = tmp_page->GetFreeSpacePointer(); offset < BUSTUB_PAGE_SIZE;) {
+    offset = tmp_page->Get(offset, &read_buffer_.emplace_back());
+  }
+  std::reverse(read_buffer_.begin(), read_buffer_.end());
+  read_cursor_ = 0;
+  bpm_->UnpinPage(page_id, false);
+}
+
+auto TmpTupleFile::ReadBatch(std::vector<Tuple> *tuples, size_t batch_size) -> bool {
+  tuples->clear();
+  while (tuples->size() < batch_size) {
+    if (read_cursor_ == read_buffer_.size()) {
+      if (read_page_ == page_ids_.size()) {
+        break;
+      }
+      LoadPage(page_ids_[read_page_++]);
+    }
+    auto count = std::min(batch_size - tuples->size(), read_buffer_.size() - read_cursor_);
+    std::move(read_buffer_.begin() + read_cursor_, read_buffer_.begin() + read_cursor_ + count,
+              std::back_inserter(*tuples));
+    read_cursor_ += count;
+  }
+  return !tuples->empty();
+}
+
+}  // namespace bustub
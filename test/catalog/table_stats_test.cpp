@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_stats_test.cpp
+//
+// Identification: test/catalog/table_stats_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/table_stats.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "gtest/gtest.h"
+#include "optimizer/optimizer.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+auto MakeSchema() -> Schema { return Schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 16}}); }
+
+/** @return row `i` of the test table: `a` is `i % 1000`, NULL for one row in ten, and `b` one of 7 strings */
+auto MakeTuple(const Schema &schema, int32_t i) -> Tuple {
+  auto a = i % 10 == 9 ? ValueFactory::GetNullValueByType(TypeId::INTEGER) : ValueFactory::GetIntegerValue(i % 1000);
+  auto b = ValueFactory::GetVarcharValue("s" + std::to_string(i % 7));
+  return {std::vector<Value>{a, b}, &schema};
+}
+
+/** @return the statistics of the test table with rows 0 to 9999 */
+auto MakeStats(const Schema &schema) -> std::shared_ptr<TableStats> {
+  auto stats = std::make_shared<TableStats>(schema);
+  for (int32_t i = 0; i < 10000; i++) {
+    stats->Insert(MakeTuple(schema, i));
+  }
+  stats->Finish();
+  return stats;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(TableStatsTest, HyperLogLogTest) {
+  for (size_t distinct : {10, 1000, 100000}) {
+    HyperLogLog sketch;
+    for (size_t repeat = 0; repeat < 3; repeat++) {
+      for (size_t i = 0; i < distinct; i++) {
+        sketch.Add(HashUtil::MixHash(i));
+      }
+    }
+    ASSERT_NEAR(sketch.Estimate(), distinct, distinct * 0.05);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TableStatsTest, CollectTest) {
+  auto schema = MakeSchema();
+  auto stats = MakeStats(schema);
+
+  ASSERT_EQ(stats->RowCount(), 10000);
+  ASSERT_DOUBLE_EQ(stats->NullFraction(0), 0.1);
+  ASSERT_DOUBLE_EQ(stats->NullFraction(1), 0);
+  // The values of `a` ending with 9 are all NULL
+  ASSERT_NEAR(stats->DistinctCount(0), 900, 45);
+  ASSERT_NEAR(stats->DistinctCount(1), 7, 1);
+  ASSERT_EQ(stats->MinValue(0)->GetAs<int32_t>(), 0);
+  ASSERT_EQ(stats->MaxValue(0)->GetAs<int32_t>(), 998);
+
+  ASSERT_NEAR(stats->EqualSelectivity(0, ValueFactory::GetIntegerValue(5)), 0.001, 0.0002);
+  ASSERT_EQ(stats->EqualSelectivity(0, ValueFactory::GetIntegerValue(5000)), 0);
+  ASSERT_EQ(stats->EqualSelectivity(0, ValueFactory::GetNullValueByType(TypeId::INTEGER)), 0);
+  ASSERT_NEAR(stats->EqualSelectivity(1, ValueFactory::GetVarcharValue("s3")), 1.0 / 7, 0.03);
+
+  ASSERT_NEAR(stats->LessSelectivity(0, ValueFactory::GetIntegerValue(250), false), 0.225, 0.02);
+  ASSERT_NEAR(stats->LessSelectivity(0, ValueFactory::GetIntegerValue(998), true), 0.9, 0.01);
+  ASSERT_EQ(stats->LessSelectivity(0, ValueFactory::GetIntegerValue(0), false), 0);
+}
+
+// NOLINTNEXTLINE
+TEST(TableStatsTest, MaintainTest) {
+  auto schema = MakeSchema();
+  auto stats = MakeStats(schema);
+
+  // Insert as many rows with `a` from 1000 to 1999, and delete the rows whose `a` is NULL
+  for (int32_t i = 0; i < 10000; i++) {
+    auto a = ValueFactory::GetIntegerValue(1000 + i % 1000);
+    stats->Insert(Tuple{{a, ValueFactory::GetVarcharValue("s")}, &schema});
+  }
+  for (int32_t i = 0; i < 10000; i++) {
+    if (i % 10 == 9) {
+      stats->Delete(MakeTuple(schema, i));
+    }
+  }
+
+  ASSERT_EQ(stats->RowCount(), 19000);
+  ASSERT_DOUBLE_EQ(stats->NullFraction(0), 0);
+  ASSERT_EQ(stats->MaxValue(0)->GetAs<int32_t>(), 1999);
+  ASSERT_NEAR(stats->DistinctCount(0), 1900, 95);
+  // The 9000 values below 1000 are the first rows
+  ASSERT_NEAR(stats->LessSelectivity(0, ValueFactory::GetIntegerValue(1000), false), 9000.0 / 19000, 0.03);
+}
+
+// NOLINTNEXTLINE
+TEST(TableStatsTest, EstimateCardinalityTest) {
+  auto schema = MakeSchema();
+  Catalog catalog(nullptr, nullptr, nullptr);
+  auto *table_info = catalog.CreateTable(nullptr, "t", schema, false);
+  Optimizer optimizer(catalog, false);
+
+  auto output = std::make_shared<Schema>(schema);
+  auto scan = std::make_shared<SeqScanPlanNode>(output, table_info->oid_, "t");
+  // Without statistics, the table size is a guess
+  ASSERT_EQ(optimizer.EstimateCardinality(scan), 1000);
+
+  catalog.SetTableStats(table_info->oid_, MakeStats(schema));
+  ASSERT_EQ(optimizer.EstimateCardinality(scan), 10000);
+
+  auto a = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  auto predicate = std::make_shared<ComparisonExpression>(
+      a, std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(250)), ComparisonType::LessThan);
+  auto filtered_scan = std::make_shared<SeqScanPlanNode>(output, table_info->oid_, "t", predicate);
+  ASSERT_NEAR(optimizer.EstimateCardinality(filtered_scan), 2250, 200);
+
+  // Each of the 9000 non-NULL values of `a` matches about 10 rows
+  std::vector<Column> columns = schema.GetColumns();
+  for (const auto &column : schema.GetColumns()) {
+    columns.push_back(column);
+  }
+  auto join = std::make_shared<HashJoinPlanNode>(std::make_shared<Schema>(columns), scan, scan,
+                                                 std::vector<AbstractExpressionRef>{a},
+                                                 std::vector<AbstractExpressionRef>{a}, JoinType::INNER);
+  ASSERT_NEAR(optimizer.EstimateCardinality(join), 90000, 9000);
+}
+
+}  // namespace bustub
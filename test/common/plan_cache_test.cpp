@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// plan_cache_test.cpp
+//
+// Identification: test/common/plan_cache_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+
+#include "common/plan_cache.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+static auto MakePlan(uint64_t catalog_version) -> std::shared_ptr<const CachedPlan> {
+  return std::make_shared<const CachedPlan>(CachedPlan{nullptr, nullptr, false, catalog_version});
+}
+
+// NOLINTNEXTLINE
+TEST(PlanCacheTest, NormalizeSqlTest) {
+  ASSERT_EQ(PlanCache::NormalizeSql("  select *\n\tfrom t1  where v1 = 1 ;; "), "select * from t1 where v1 = 1");
+  // Whitespace in literals and quoted identifiers is kept
+  ASSERT_EQ(PlanCache::NormalizeSql("select 'a  b;' from \"t  1\";"), "select 'a  b;' from \"t  1\"");
+  ASSERT_EQ(PlanCache::NormalizeSql("select 'it''s  ' ,  v1"), "select 'it''s  ' , v1");
+  ASSERT_NE(PlanCache::NormalizeSql("select 'a b'"), PlanCache::NormalizeSql("select 'a  b'"));
+  // A line comment ends at the newline, so what follows it is part of the statement
+  ASSERT_EQ(PlanCache::NormalizeSql("select v1 -- note\n, v2 from t1"), "select v1 , v2 from t1");
+  ASSERT_EQ(PlanCache::NormalizeSql("select v1 -- note , v2 from t1"), "select v1");
+  ASSERT_NE(PlanCache::NormalizeSql("select v1 -- note\n, v2 from t1"),
+            PlanCache::NormalizeSql("select v1 -- note , v2 from t1"));
+  ASSERT_EQ(PlanCache::NormalizeSql("select /* a\n b */ v1 from t1 /* end"), "select v1 from t1");
+  ASSERT_EQ(PlanCache::NormalizeSql("select '-- /*' from t1"), "select '-- /*' from t1");
+}
+
+// NOLINTNEXTLINE
+TEST(PlanCacheTest, EvictLeastRecentlyUsedTest) {
+  PlanCache cache(2);
+  auto plan_a = MakePlan(0);
+  auto plan_b = MakePlan(0);
+  cache.Put("a", plan_a);
+  cache.Put("b", plan_b);
+  ASSERT_EQ(cache.Get("a", 0), plan_a);
+
+  // "b" is now the least recently used
+  cache.Put("c", MakePlan(0));
+  ASSERT_EQ(cache.Size(), 2);
+  ASSERT_EQ(cache.Get("b", 0), nullptr);
+  ASSERT_EQ(cache.Get("a", 0), plan_a);
+  ASSERT_NE(cache.Get("c", 0), nullptr);
+
+  // Putting a plan again replaces it without evicting another one
+  auto plan_c = MakePlan(0);
+  cache.Put("c", plan_c);
+  ASSERT_EQ(cache.Size(), 2);
+  ASSERT_EQ(cache.Get("c", 0), plan_c);
+  ASSERT_EQ(cache.Get("a", 0), plan_a);
+
+  cache.Clear();
+  ASSERT_EQ(cache.Size(), 0);
+  ASSERT_EQ(cache.Get("a", 0), nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST(PlanCacheTest, DropPlansOfOlderCatalogTest) {
+  PlanCache cache;
+  cache.Put("a", MakePlan(1));
+  ASSERT_NE(cache.Get("a", 1), nullptr);
+  ASSERT_EQ(cache.Get("a", 2), nullptr);
+  ASSERT_EQ(cache.Size(), 0);
+}
+
+}  // namespace bustub
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_spill_test.cpp
+//
+// Identification: test/execution/aggregation_spill_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "execution/executor_context.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution_test_util.h"  // NOLINT
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Group a mock table on one column, with COUNT(*), SUM and MAX of another column, and return the sorted output */
+auto RunAggregation(ExecutorContext *exec_ctx, const std::string &table, uint32_t group_col, TypeId group_type,
+                    uint32_t agg_col) -> std::vector<std::string> {
+  auto scan = MakeMockScan(table);
+  auto agg_expr = std::make_shared<ColumnValueExpression>(0, agg_col, TypeId::INTEGER);
+  std::vector<AbstractExpressionRef> group_bys{std::make_shared<ColumnValueExpression>(0, group_col, group_type)};
+  std::vector<AbstractExpressionRef> aggregates{agg_expr, agg_expr, agg_expr};
+  std::vector<AggregationType> agg_types{AggregationType::CountStarAggregate, AggregationType::SumAggregate,
+                                         AggregationType::MaxAggregate};
+  auto schema = std::make_shared<Schema>(AggregationPlanNode::InferAggSchema(group_bys, aggregates, agg_types));
+  auto plan = std::make_shared<AggregationPlanNode>(schema, scan, group_bys, aggregates, agg_types);
+
+  std::vector<std::string> result;
+  for (const auto &tuple : ExecutePlan(exec_ctx, plan)) {
+    result.push_back(tuple.ToString(schema.get()));
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(AggregationSpillTest, DISABLED_SpilledGroupsMatchInMemoryGroupsTest) {
+  // Without a buffer pool, every group stays in memory
+  ExecutorContext in_memory_ctx(nullptr, nullptr, nullptr, nullptr, nullptr, false);
+  auto expected = RunAggregation(&in_memory_ctx, "__mock_t4_1m", 0, TypeId::INTEGER, 1);
+  ASSERT_EQ(expected.size(), 500000);
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  ExecutorContext exec_ctx(nullptr, nullptr, bpm.get(), nullptr, nullptr, false);
+  exec_ctx.SetMemoryBudget(1 << 20);
+  ASSERT_EQ(RunAggregation(&exec_ctx, "__mock_t4_1m", 0, TypeId::INTEGER, 1), expected);
+}
+
+// NOLINTNEXTLINE
+TEST(AggregationSpillTest, DISABLED_RepeatedSpillsTest) {
+  ExecutorContext in_memory_ctx(nullptr, nullptr, nullptr, nullptr, nullptr, false);
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  ExecutorContext exec_ctx(nullptr, nullptr, bpm.get(), nullptr, nullptr, false);
+  // Every pass spills all the batches after its first one, so partitions are spilled again until they fit in a batch
+  exec_ctx.SetMemoryBudget(1);
+
+  ASSERT_EQ(RunAggregation(&exec_ctx, "__mock_t4_1m", 1, TypeId::INTEGER, 0),
+            RunAggregation(&in_memory_ctx, "__mock_t4_1m", 1, TypeId::INTEGER, 0));
+  ASSERT_EQ(RunAggregation(&exec_ctx, "__mock_agg_input_big", 5, TypeId::VARCHAR, 1),
+            RunAggregation(&in_memory_ctx, "__mock_agg_input_big", 5, TypeId::VARCHAR, 1));
+}
+
+}  // namespace bustub
@@ -0,0 +1,201 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression_test.cpp
+//
+// Identification: test/execution/compiled_expression_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/config.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/compiled_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+auto MakeSchema() -> Schema {
+  return Schema{std::vector{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::BIGINT}, Column{"c", TypeId::BOOLEAN},
+                            Column{"d", TypeId::SMALLINT}, Column{"e", TypeId::VARCHAR, 16}}};
+}
+
+auto MakeTuples(const Schema &schema, size_t count, uint32_t seed) -> std::vector<Tuple> {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-20, 20);
+  std::vector<Tuple> tuples;
+  tuples.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    // Roughly one value in ten is NULL
+    auto maybe_null = [&](const Value &val) {
+      return dist(gen) < -16 ? ValueFactory::GetNullValueByType(val.GetTypeId()) : val;
+    };
+    std::vector<Value> values{maybe_null(ValueFactory::GetIntegerValue(dist(gen))),
+                              maybe_null(ValueFactory::GetBigIntValue(dist(gen))),
+                              maybe_null(ValueFactory::GetBooleanValue(dist(gen) > 0)),
+                              maybe_null(ValueFactory::GetSmallIntValue(dist(gen))),
+                              ValueFactory::GetVarcharValue("x")};
+    tuples.emplace_back(values, &schema);
+  }
+  return tuples;
+}
+
+auto Col(uint32_t tuple_idx, uint32_t col_idx, TypeId type) -> AbstractExpressionRef {
+  return std::make_shared<ColumnValueExpression>(tuple_idx, col_idx, type);
+}
+
+auto Const(const Value &val) -> AbstractExpressionRef { return std::make_shared<ConstantValueExpression>(val); }
+
+auto Cmp(AbstractExpressionRef lhs, AbstractExpressionRef rhs, ComparisonType type) -> AbstractExpressionRef {
+  return std::make_shared<ComparisonExpression>(std::move(lhs), std::move(rhs), type);
+}
+
+auto Logic(AbstractExpressionRef lhs, AbstractExpressionRef rhs, LogicType type) -> AbstractExpressionRef {
+  return std::make_shared<LogicExpression>(std::move(lhs), std::move(rhs), type);
+}
+
+auto Arith(AbstractExpressionRef lhs, AbstractExpressionRef rhs, ArithmeticType type) -> AbstractExpressionRef {
+  return std::make_shared<ArithmeticExpression>(std::move(lhs), std::move(rhs), type);
+}
+
+/** (a + 1 > b AND (c OR d <= 5)) OR a - a = NULL, with b, d and the second a taken from `right_tuple_idx` */
+auto MakePredicate(uint32_t right_tuple_idx) -> AbstractExpressionRef {
+  auto a_plus_1 = Arith(Col(0, 0, TypeId::INTEGER), Const(ValueFactory::GetIntegerValue(1)), ArithmeticType::Plus);
+  auto lhs = Logic(Cmp(a_plus_1, Col(right_tuple_idx, 1, TypeId::BIGINT), ComparisonType::GreaterThan),
+                   Logic(Col(0, 2, TypeId::BOOLEAN),
+                         Cmp(Col(right_tuple_idx, 3, TypeId::SMALLINT), Const(ValueFactory::GetIntegerValue(5)),
+                             ComparisonType::LessThanOrEqual),
+                         LogicType::Or),
+                   LogicType::And);
+  auto a_minus_a = Arith(Col(0, 0, TypeId::INTEGER), Col(right_tuple_idx, 0, TypeId::INTEGER), ArithmeticType::Minus);
+  auto rhs = Cmp(a_minus_a, Const(ValueFactory::GetNullValueByType(TypeId::INTEGER)), ComparisonType::Equal);
+  return Logic(lhs, rhs, LogicType::Or);
+}
+
+auto IsTrue(const Value &val) -> bool { return !val.IsNull() && val.GetAs<bool>(); }
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(CompiledExpressionTest, MatchesInterpreter) {
+  auto schema = MakeSchema();
+  auto tuples = MakeTuples(schema, 2000, 15445);
+
+  std::vector<AbstractExpressionRef> exprs{
+      MakePredicate(0),
+      Arith(Col(0, 0, TypeId::INTEGER), Const(ValueFactory::GetIntegerValue(7)), ArithmeticType::Minus),
+      Cmp(Col(0, 1, TypeId::BIGINT), Col(0, 3, TypeId::SMALLINT), ComparisonType::NotEqual),
+      Logic(Col(0, 2, TypeId::BOOLEAN), Const(ValueFactory::GetNullValueByType(TypeId::BOOLEAN)), LogicType::And),
+      Col(0, 3, TypeId::SMALLINT),
+  };
+
+  for (const auto &expr : exprs) {
+    auto compiled = CompiledExpression::Compile(expr, schema);
+    ASSERT_NE(compiled, nullptr) << expr->ToString();
+
+    std::vector<Value> batch_values;
+    compiled->EvaluateBatch(tuples, &batch_values);
+    ASSERT_EQ(batch_values.size(), tuples.size());
+    for (size_t i = 0; i < tuples.size(); i++) {
+      auto expected = expr->Evaluate(&tuples[i], schema);
+      auto actual = compiled->Evaluate(&tuples[i]);
+      ASSERT_EQ(expected.IsNull(), actual.IsNull()) << expr->ToString() << " on " << tuples[i].ToString(&schema);
+      ASSERT_EQ(expected.IsNull(), batch_values[i].IsNull());
+      if (!expected.IsNull()) {
+        ASSERT_EQ(expected.CompareEquals(actual), CmpBool::CmpTrue) << expr->ToString();
+        ASSERT_EQ(expected.CompareEquals(batch_values[i]), CmpBool::CmpTrue) << expr->ToString();
+      }
+    }
+  }
+
+  auto predicate = MakePredicate(0);
+  auto compiled = CompiledExpression::Compile(predicate, schema);
+  std::vector<uint8_t> selection;
+  size_t expected_selected = 0;
+  auto selected = compiled->SelectBatch(tuples, &selection);
+  for (size_t i = 0; i < tuples.size(); i++) {
+    auto expected = IsTrue(predicate->Evaluate(&tuples[i], schema));
+    ASSERT_EQ(expected, selection[i] != 0);
+    expected_selected += static_cast<size_t>(expected);
+  }
+  ASSERT_EQ(selected, expected_selected);
+}
+
+// NOLINTNEXTLINE
+TEST(CompiledExpressionTest, JoinMatchesInterpreter) {
+  auto schema = MakeSchema();
+  auto left_tuples = MakeTuples(schema, 50, 1);
+  auto right_tuples = MakeTuples(schema, 200, 2);
+  auto predicate = MakePredicate(1);
+  auto compiled = CompiledExpression::CompileJoin(predicate, schema, schema);
+  ASSERT_NE(compiled, nullptr);
+
+  std::vector<uint8_t> selection;
+  for (const auto &left : left_tuples) {
+    compiled->SelectJoinBatch(&left, right_tuples, &selection);
+    for (size_t i = 0; i < right_tuples.size(); i++) {
+      auto expected = predicate->EvaluateJoin(&left, schema, &right_tuples[i], schema);
+      ASSERT_EQ(IsTrue(expected), selection[i] != 0);
+      ASSERT_EQ(IsTrue(expected), IsTrue(compiled->EvaluateJoin(&left, &right_tuples[i])));
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(CompiledExpressionTest, FallsBackOnUnsupportedExpressions) {
+  auto schema = MakeSchema();
+  auto varchar_cmp = Cmp(Col(0, 4, TypeId::VARCHAR), Const(ValueFactory::GetVarcharValue("x")), ComparisonType::Equal);
+  ASSERT_EQ(CompiledExpression::Compile(varchar_cmp, schema), nullptr);
+  auto decimal_cmp =
+      Cmp(Col(0, 0, TypeId::INTEGER), Const(ValueFactory::GetDecimalValue(1.5)), ComparisonType::LessThan);
+  ASSERT_EQ(CompiledExpression::Compile(Logic(MakePredicate(0), decimal_cmp, LogicType::And), schema), nullptr);
+}
+
+// A benchmark, run with --gtest_also_run_disabled_tests. MatchesInterpreter checks the same selection on fewer tuples.
+// NOLINTNEXTLINE
+TEST(CompiledExpressionTest, DISABLED_PredicateThroughput) {
+  auto schema = MakeSchema();
+  auto tuples = MakeTuples(schema, BUSTUB_BATCH_SIZE, 15445);
+  auto predicate = MakePredicate(0);
+  auto compiled = CompiledExpression::Compile(predicate, schema);
+  const size_t rounds = 200;
+
+  size_t interpreted_selected = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t round = 0; round < rounds; round++) {
+    for (const auto &tuple : tuples) {
+      interpreted_selected += static_cast<size_t>(IsTrue(predicate->Evaluate(&tuple, schema)));
+    }
+  }
+  auto interpreted = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  size_t compiled_selected = 0;
+  std::vector<uint8_t> selection;
+  start = std::chrono::steady_clock::now();
+  for (size_t round = 0; round < rounds; round++) {
+    compiled_selected += compiled->SelectBatch(tuples, &selection);
+  }
+  auto batched = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  ASSERT_EQ(interpreted_selected, compiled_selected);
+  auto evaluations = static_cast<double>(rounds * tuples.size());
+  std::cout << "interpreted: " << evaluations / interpreted << " predicates/s, compiled: " << evaluations / batched
+            << " predicates/s" << std::endl;
+}
+
+}  // namespace bustub
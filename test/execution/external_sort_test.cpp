@@ -0,0 +1,282 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// external_sort_test.cpp
+//
+// Identification: test/execution/external_sort_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "execution/executor_context.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/sort_key.h"
+#include "execution_test_util.h"  // NOLINT
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return a random value of a type, NULL about one time in ten */
+auto RandomValue(TypeId type, std::mt19937 *gen) -> Value {
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  if (dist(*gen) < -800) {
+    return ValueFactory::GetNullValueByType(type);
+  }
+  switch (type) {
+    case TypeId::BOOLEAN:
+      return ValueFactory::GetBooleanValue(dist(*gen) > 0);
+    case TypeId::TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(dist(*gen) % 100));
+    case TypeId::SMALLINT:
+      return ValueFactory::GetSmallIntValue(static_cast<int16_t>(dist(*gen) * 30));
+    case TypeId::INTEGER:
+      return ValueFactory::GetIntegerValue(dist(*gen) * 1000000);
+    case TypeId::BIGINT:
+      return ValueFactory::GetBigIntValue(static_cast<int64_t>(dist(*gen)) << 40);
+    case TypeId::DECIMAL:
+      return ValueFactory::GetDecimalValue(dist(*gen) / 7.0);
+    case TypeId::VARCHAR: {
+      // Short strings over a small alphabet, so that many are prefixes of others
+      std::string str(std::abs(dist(*gen)) % 4, 'a');
+      for (auto &c : str) {
+        c = static_cast<char>("\000a\001\377"[std::abs(dist(*gen)) % 4]);
+      }
+      return ValueFactory::GetVarcharValue(str);
+    }
+    default:
+      UNREACHABLE("unexpected type");
+  }
+}
+
+/** @return -1, 0 or 1 as `a` sorts before, with or after `b` in ascending order, NULLs first */
+auto CompareValues(const Value &a, const Value &b) -> int {
+  if (a.IsNull() || b.IsNull()) {
+    return static_cast<int>(!a.IsNull()) - static_cast<int>(!b.IsNull());
+  }
+  if (a.CompareEquals(b) == CmpBool::CmpTrue) {
+    return 0;
+  }
+  return a.CompareLessThan(b) == CmpBool::CmpTrue ? -1 : 1;
+}
+
+auto Sign(int cmp) -> int { return (cmp > 0) - (cmp < 0); }
+
+/** Sort a mock table, and return the output tuples */
+auto RunSort(ExecutorContext *exec_ctx, const std::string &table,
+             const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys) -> std::vector<Tuple> {
+  auto scan = MakeMockScan(table);
+  return ExecutePlan(exec_ctx, std::make_shared<SortPlanNode>(scan->output_schema_, scan, order_bys));
+}
+
+/** Sort tuples the way SortExecutor used to, evaluating and comparing the ORDER BY values in every comparison */
+void SortByValues(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys, const Schema &schema,
+                  const std::vector<Tuple> &tuples, std::vector<uint32_t> *order) {
+  order->resize(tuples.size());
+  std::iota(order->begin(), order->end(), 0);
+  std::stable_sort(order->begin(), order->end(), [&](uint32_t a, uint32_t b) {
+    for (const auto &[order_by_type, expr] : order_bys) {
+      auto cmp = CompareValues(expr->Evaluate(&tuples[a], schema), expr->Evaluate(&tuples[b], schema));
+      if (cmp != 0) {
+        return order_by_type == OrderByType::DESC ? cmp > 0 : cmp < 0;
+      }
+    }
+    return false;
+  });
+}
+
+/** @return random tuples of an (INTEGER, BIGINT, VARCHAR) schema */
+auto MakeTuples(const Schema &schema, size_t count, std::mt19937 *gen) -> std::vector<Tuple> {
+  std::vector<Tuple> tuples;
+  for (size_t i = 0; i < count; i++) {
+    tuples.emplace_back(std::vector<Value>{RandomValue(TypeId::INTEGER, gen), RandomValue(TypeId::BIGINT, gen),
+                                           RandomValue(TypeId::VARCHAR, gen)},
+                        &schema);
+  }
+  return tuples;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(ExternalSortTest, SortKeyOrderTest) {
+  std::mt19937 gen(15445);
+  for (auto type : {TypeId::BOOLEAN, TypeId::TINYINT, TypeId::SMALLINT, TypeId::INTEGER, TypeId::BIGINT,
+                    TypeId::DECIMAL, TypeId::VARCHAR}) {
+    std::vector<Value> values;
+    for (int i = 0; i < 200; i++) {
+      values.push_back(RandomValue(type, &gen));
+    }
+    for (bool descending : {false, true}) {
+      std::vector<SortKey> keys(values.size());
+      for (size_t i = 0; i < values.size(); i++) {
+        SortKeyEncoder::AppendValue(values[i], descending, &keys[i]);
+      }
+      for (size_t i = 0; i < values.size(); i++) {
+        for (size_t j = 0; j < values.size(); j++) {
+          auto expected = CompareValues(values[i], values[j]) * (descending ? -1 : 1);
+          ASSERT_EQ(Sign(keys[i].compare(keys[j])), expected)
+              << Type::TypeIdToString(type) << " " << values[i].ToString() << " vs " << values[j].ToString();
+        }
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(ExternalSortTest, MultiColumnKeyTest) {
+  // A longer varchar in the first column must not compare the following column against its characters
+  Schema schema({Column{"a", TypeId::VARCHAR, 8}, Column{"b", TypeId::INTEGER}});
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys{
+      {OrderByType::ASC, std::make_shared<ColumnValueExpression>(0, 0, TypeId::VARCHAR)},
+      {OrderByType::DESC, std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER)}};
+  SortKeyEncoder encoder(order_bys, schema);
+  auto key = [&](const std::string &a, int32_t b) {
+    return encoder.Encode(Tuple({ValueFactory::GetVarcharValue(a), ValueFactory::GetIntegerValue(b)}, &schema));
+  };
+  ASSERT_LT(key("a", 1), key("a", 0));
+  ASSERT_LT(key("a", 0), key("ab", 5));
+  ASSERT_LT(key("a", -5), key("a\x01", 5));
+  ASSERT_LT(key("ab", 5), key("b", 5));
+
+  std::vector<Tuple> tuples{Tuple({ValueFactory::GetVarcharValue("b"), ValueFactory::GetIntegerValue(1)}, &schema),
+                            Tuple({ValueFactory::GetVarcharValue("a"), ValueFactory::GetIntegerValue(2)}, &schema)};
+  std::vector<SortKey> keys;
+  encoder.EncodeBatch(tuples, &keys);
+  ASSERT_EQ(keys[0], key("b", 1));
+  ASSERT_EQ(keys[1], key("a", 2));
+}
+
+// NOLINTNEXTLINE
+TEST(ExternalSortTest, SortMatchesValueSortTest) {
+  std::mt19937 gen(15445);
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::BIGINT}, Column{"c", TypeId::VARCHAR, 8}});
+  auto tuples = MakeTuples(schema, 5000, &gen);
+  auto a = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  auto b = std::make_shared<ColumnValueExpression>(0, 1, TypeId::BIGINT);
+  auto c = std::make_shared<ColumnValueExpression>(0, 2, TypeId::VARCHAR);
+
+  // The first two are radix sorted, the others go through the prefix sort
+  for (const auto &order_bys : std::vector<std::vector<std::pair<OrderByType, AbstractExpressionRef>>>{
+           {{OrderByType::ASC, a}, {OrderByType::DESC, b}},
+           {{OrderByType::DESC, a}},
+           {{OrderByType::DESC, c}, {OrderByType::ASC, a}},
+           {{OrderByType::ASC, b}, {OrderByType::ASC, c}}}) {
+    SortKeyEncoder encoder(order_bys, schema);
+    std::vector<SortKey> keys;
+    encoder.EncodeBatch(tuples, &keys);
+    std::vector<uint32_t> order;
+    encoder.Sort(keys, &order);
+    std::vector<uint32_t> expected;
+    SortByValues(order_bys, schema, tuples, &expected);
+    ASSERT_EQ(order, expected);
+    // Chunks sorted on several threads and merged back together give the same order, down to the ties
+    for (size_t num_threads : {2, 3, 7}) {
+      encoder.Sort(keys, &order, num_threads);
+      ASSERT_EQ(order, expected);
+    }
+  }
+  ASSERT_EQ(SortKeyEncoder({{OrderByType::ASC, a}, {OrderByType::DESC, b}}, schema).FixedKeySize(), 14);
+  ASSERT_EQ(SortKeyEncoder({{OrderByType::ASC, a}, {OrderByType::DESC, c}}, schema).FixedKeySize(), 0);
+}
+
+// A benchmark, run with --gtest_also_run_disabled_tests. SortMatchesValueSortTest checks the order on fewer tuples.
+// NOLINTNEXTLINE
+TEST(ExternalSortTest, DISABLED_SortThroughput) {
+  std::mt19937 gen(15445);
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::BIGINT}, Column{"c", TypeId::VARCHAR, 8}});
+  auto tuples = MakeTuples(schema, 100000, &gen);
+  auto a = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  auto b = std::make_shared<ColumnValueExpression>(0, 1, TypeId::BIGINT);
+  auto c = std::make_shared<ColumnValueExpression>(0, 2, TypeId::VARCHAR);
+
+  for (const auto &[name, order_bys] :
+       std::vector<std::pair<std::string, std::vector<std::pair<OrderByType, AbstractExpressionRef>>>>{
+           {"integers", {{OrderByType::ASC, a}, {OrderByType::DESC, b}}},
+           {"varchar", {{OrderByType::DESC, c}, {OrderByType::ASC, a}}}}) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> expected;
+    SortByValues(order_bys, schema, tuples, &expected);
+    auto by_values = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    SortKeyEncoder encoder(order_bys, schema);
+    std::vector<SortKey> keys;
+    encoder.EncodeBatch(tuples, &keys);
+    std::vector<uint32_t> order;
+    encoder.Sort(keys, &order);
+    auto by_keys = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_EQ(order, expected);
+    auto rows = static_cast<double>(tuples.size());
+    std::cout << name << ": values " << rows / by_values << " rows/s, sort keys " << rows / by_keys << " rows/s"
+              << std::endl;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(ExternalSortTest, DISABLED_SpilledSortMatchesInMemorySortTest) {
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys{
+      {OrderByType::DESC, std::make_shared<ColumnValueExpression>(0, 5, TypeId::VARCHAR)},
+      {OrderByType::ASC, std::make_shared<ColumnValueExpression>(0, 2, TypeId::INTEGER)},
+      {OrderByType::DESC, std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER)}};
+
+  // Without a buffer pool, the input is sorted in memory
+  ExecutorContext in_memory_ctx(nullptr, nullptr, nullptr, nullptr, nullptr, false);
+  auto expected = RunSort(&in_memory_ctx, "__mock_agg_input_big", order_bys);
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  ExecutorContext exec_ctx(nullptr, nullptr, bpm.get(), nullptr, nullptr, false);
+  // Every batch of input becomes a run
+  exec_ctx.SetMemoryBudget(1);
+  auto result = RunSort(&exec_ctx, "__mock_agg_input_big", order_bys);
+
+  ASSERT_EQ(result.size(), 10000);
+  ASSERT_EQ(result.size(), expected.size());
+  for (size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(result[i].GetLength(), expected[i].GetLength());
+    ASSERT_EQ(memcmp(result[i].GetData(), expected[i].GetData(), result[i].GetLength()), 0);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(ExternalSortTest, DISABLED_MultiPassMergeTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager.get());
+  ExecutorContext exec_ctx(nullptr, nullptr, bpm.get(), nullptr, nullptr, false);
+  // About a thousand runs, more than can be merged at once
+  exec_ctx.SetMemoryBudget(1);
+
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys{
+      {OrderByType::DESC, std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER)},
+      {OrderByType::ASC, std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER)}};
+  auto result = RunSort(&exec_ctx, "__mock_t4_1m", order_bys);
+
+  ASSERT_EQ(result.size(), 1000000);
+  auto schema = GetMockTableSchemaOf("__mock_t4_1m");
+  for (size_t i = 0; i < result.size(); i++) {
+    // Every x appears twice, with y = x * 10
+    ASSERT_EQ(result[i].GetValue(&schema, 0).GetAs<int32_t>(), static_cast<int32_t>(499999 - i / 2));
+  }
+}
+
+}  // namespace bustub
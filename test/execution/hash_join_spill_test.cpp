@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_join_spill_test.cpp
+//
+// Identification: test/execution/hash_join_spill_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "execution/executor_context.h"
+#include "execution_test_util.h"  // NOLINT
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/table/tmp_tuple_file.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(HashJoinSpillTest, DISABLED_TmpTupleFileTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(4, disk_manager.get());
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 32}});
+
+  TmpTupleFile file(bpm.get());
+  const int32_t count = 10000;
+  for (int32_t i = 0; i < count; i++) {
+    file.Append(Tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::to_string(i))}, &schema));
+  }
+  ASSERT_EQ(file.Size(), count);
+
+  // The file can be read several times, in the order the tuples were appended
+  for (int round = 0; round < 2; round++) {
+    file.Rewind();
+    std::vector<Tuple> tuples;
+    int32_t next = 0;
+    while (file.ReadBatch(&tuples, 300)) {
+      for (const auto &tuple : tuples) {
+        ASSERT_EQ(tuple.GetValue(&schema, 0).GetAs<int32_t>(), next);
+        ASSERT_EQ(tuple.GetValue(&schema, 1).ToString(), std::to_string(next));
+        next++;
+      }
+    }
+    ASSERT_EQ(next, count);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(HashJoinSpillTest, DISABLED_InnerJoinUnderBudgetTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager.get());
+  ExecutorContext exec_ctx(nullptr, nullptr, bpm.get(), nullptr, nullptr, false);
+  // Far less than the 1M build tuples need, so that partitions are spilled and some of them spilled again
+  exec_ctx.SetMemoryBudget(1 << 20);
+
+  // Every key of __mock_t4_1m and __mock_t5_1m appears twice on each side
+  auto plan = MakeHashJoin(MakeMockScan("__mock_t4_1m"), 0, MakeMockScan("__mock_t5_1m"), 0, JoinType::INNER);
+  auto result = ExecutePlan(&exec_ctx, plan);
+  ASSERT_EQ(result.size(), 2000000);
+  Schema schema({Column{"x", TypeId::INTEGER}, Column{"y", TypeId::INTEGER}, Column{"x", TypeId::INTEGER},
+                 Column{"y", TypeId::INTEGER}});
+  for (const auto &tuple : result) {
+    ASSERT_EQ(tuple.GetValue(&schema, 0).GetAs<int32_t>(), tuple.GetValue(&schema, 2).GetAs<int32_t>());
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(HashJoinSpillTest, DISABLED_LeftJoinUnderBudgetTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager.get());
+  ExecutorContext exec_ctx(nullptr, nullptr, bpm.get(), nullptr, nullptr, false);
+  exec_ctx.SetMemoryBudget(64 << 10);
+
+  // v2 of __mock_agg_input_big runs from 0 to 9999, which matches 20000 of the 1M left tuples
+  auto plan = MakeHashJoin(MakeMockScan("__mock_t4_1m"), 0, MakeMockScan("__mock_agg_input_big"), 1, JoinType::LEFT);
+  auto result = ExecutePlan(&exec_ctx, plan);
+  ASSERT_EQ(result.size(), 1000000);
+  auto left_schema = GetMockTableSchemaOf("__mock_t4_1m");
+  auto right_schema = GetMockTableSchemaOf("__mock_agg_input_big");
+  std::vector<Column> columns = left_schema.GetColumns();
+  columns.insert(columns.end(), right_schema.GetColumns().begin(), right_schema.GetColumns().end());
+  Schema schema(columns);
+  size_t matched = 0;
+  for (const auto &tuple : result) {
+    auto right_key = tuple.GetValue(&schema, 3);
+    if (!right_key.IsNull()) {
+      ASSERT_EQ(tuple.GetValue(&schema, 0).GetAs<int32_t>(), right_key.GetAs<int32_t>());
+      matched++;
+    }
+  }
+  ASSERT_EQ(matched, 20000);
+}
+
+}  // namespace bustub
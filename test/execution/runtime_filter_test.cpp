@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter_test.cpp
+//
+// Identification: test/execution/runtime_filter_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/runtime_filter.h"
+#include "execution_test_util.h"  // NOLINT
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Inner join two mock tables on one column of each, optionally with a runtime filter, and count the output tuples */
+auto CountJoin(ExecutorContext *exec_ctx, const std::string &left_table, uint32_t left_col,
+               const std::string &right_table, uint32_t right_col, bool runtime_filter) -> size_t {
+  auto left = MakeMockScan(left_table);
+  auto plan = MakeHashJoin(left, left_col, MakeMockScan(right_table), right_col, JoinType::INNER);
+  if (runtime_filter) {
+    left->runtime_filters_.push_back({0, plan->LeftJoinKeyExpressions()});
+    plan->runtime_filter_id_ = 0;
+  }
+  return ExecutePlan(exec_ctx, plan).size();
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(RuntimeFilterTest, NoFalseNegativesTest) {
+  RuntimeFilter filter;
+  std::vector<Value> keys(1);
+  for (int32_t i = 0; i < 10000; i++) {
+    keys[0] = ValueFactory::GetIntegerValue(i * 7);
+    filter.Insert(keys);
+  }
+  filter.Finish();
+
+  // Keys within the bounds only get through the Bloom filter by a false positive. They come first, since a filter
+  // that keeps getting matching keys stops checking them.
+  size_t false_positives = 0;
+  for (int32_t i = 0; i < 10000; i++) {
+    keys[0] = ValueFactory::GetIntegerValue(i * 7 + 3);
+    false_positives += filter.MayContain(keys) ? 1 : 0;
+  }
+  ASSERT_LT(false_positives, 300);
+  for (int32_t i = 0; i < 10000; i++) {
+    keys[0] = ValueFactory::GetIntegerValue(i * 7);
+    ASSERT_TRUE(filter.MayContain(keys));
+  }
+  keys[0] = ValueFactory::GetIntegerValue(-1);
+  ASSERT_FALSE(filter.MayContain(keys));
+  keys[0] = ValueFactory::GetNullValueByType(TypeId::INTEGER);
+  ASSERT_FALSE(filter.MayContain(keys));
+}
+
+// NOLINTNEXTLINE
+TEST(RuntimeFilterTest, EmptyBuildSideTest) {
+  RuntimeFilter filter;
+  filter.Finish();
+  ASSERT_FALSE(filter.MayContain({ValueFactory::GetIntegerValue(0)}));
+}
+
+// NOLINTNEXTLINE
+TEST(RuntimeFilterTest, UnselectiveFilterIsDisabledTest) {
+  RuntimeFilter filter;
+  std::vector<Value> keys(1);
+  for (int32_t i = 0; i < 100; i++) {
+    keys[0] = ValueFactory::GetIntegerValue(i);
+    filter.Insert(keys);
+  }
+  filter.Finish();
+
+  // Every probe key matches, so the filter stops checking after its sample
+  for (int32_t i = 0; i < 100000; i++) {
+    keys[0] = ValueFactory::GetIntegerValue(i % 100);
+    ASSERT_TRUE(filter.MayContain(keys));
+  }
+  ASSERT_LT(filter.RowsChecked(), 100000);
+  ASSERT_EQ(filter.RowsDropped(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST(RuntimeFilterTest, HashJoinFiltersProbeScanTest) {
+  ExecutorContext plain_ctx(nullptr, nullptr, nullptr, nullptr, nullptr, false);
+  auto expected = CountJoin(&plain_ctx, "__mock_t4_1m", 0, "__mock_table_3", 0, false);
+  ASSERT_EQ(expected, 100);
+
+  ExecutorContext exec_ctx(nullptr, nullptr, nullptr, nullptr, nullptr, false);
+  ASSERT_EQ(CountJoin(&exec_ctx, "__mock_t4_1m", 0, "__mock_table_3", 0, true), expected);
+  auto *filter = exec_ctx.GetRuntimeFilter(0);
+  ASSERT_NE(filter, nullptr);
+  // Only the rows within the bounds of the build keys may get through, which leaves 198 of the million left rows
+  ASSERT_EQ(filter->RowsChecked(), 1000000);
+  ASSERT_GE(filter->RowsDropped(), 1000000 - 198);
+}
+
+}  // namespace bustub
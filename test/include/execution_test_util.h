@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// execution_test_util.h
+//
+// Identification: test/include/execution_test_util.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "execution/executor_context.h"
+#include "execution/executor_factory.h"
+#include "execution/executors/mock_scan_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+
+namespace bustub {
+
+/** @return a plan scanning every column of a mock table */
+inline auto MakeMockScan(const std::string &table) -> std::shared_ptr<MockScanPlanNode> {
+  return std::make_shared<MockScanPlanNode>(std::make_shared<Schema>(GetMockTableSchemaOf(table)), table);
+}
+
+/** @return a plan hash joining two plans on one INTEGER column of each, and outputting the columns of both */
+inline auto MakeHashJoin(const AbstractPlanNodeRef &left, uint32_t left_col, const AbstractPlanNodeRef &right,
+                         uint32_t right_col, JoinType join_type) -> std::shared_ptr<HashJoinPlanNode> {
+  std::vector<Column> columns = left->OutputSchema().GetColumns();
+  for (const auto &column : right->OutputSchema().GetColumns()) {
+    columns.push_back(column);
+  }
+  return std::make_shared<HashJoinPlanNode>(
+      std::make_shared<Schema>(columns), left, right,
+      std::vector<AbstractExpressionRef>{std::make_shared<ColumnValueExpression>(0, left_col, TypeId::INTEGER)},
+      std::vector<AbstractExpressionRef>{std::make_shared<ColumnValueExpression>(0, right_col, TypeId::INTEGER)},
+      join_type);
+}
+
+/** Execute a plan a batch at a time, and return all its output tuples */
+inline auto ExecutePlan(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan) -> std::vector<Tuple> {
+  auto executor = ExecutorFactory::CreateExecutor(exec_ctx, plan);
+  executor->Init();
+  std::vector<Tuple> result;
+  std::vector<Tuple> tuples;
+  std::vector<RID> rids;
+  while (executor->NextBatch(&tuples, &rids, BUSTUB_BATCH_SIZE)) {
+    std::move(tuples.begin(), tuples.end(), std::back_inserter(result));
+  }
+  return result;
+}
+
+}  // namespace bustub
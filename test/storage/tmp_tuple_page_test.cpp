@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -19,7 +20,7 @@
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
+TEST(TmpTuplePageTest, BasicTest) {
   // There are many ways to do this assignment, and this is only one of them.
   // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
   // You will get full credit as long as you are correctly using a linear probe hash table.
@@ -48,4 +49,46 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 4), 123);
 }
 
+// NOLINTNEXTLINE
+TEST(TmpTuplePageTest, FillAndReadBackTest) {
+  TmpTuplePage page{};
+  page_id_t page_id = 15445;
+  page.Init(page_id, BUSTUB_PAGE_SIZE);
+
+  std::vector<Column> columns;
+  columns.emplace_back("A", TypeId::INTEGER);
+  columns.emplace_back("B", TypeId::VARCHAR, 64);
+  Schema schema(columns);
+
+  // Insert tuples until the page is full
+  std::vector<TmpTuple> locations;
+  while (true) {
+    auto i = static_cast<int32_t>(locations.size());
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(i % 10, 'x'))}, &schema);
+    TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
+    if (!page.Insert(tuple, &tmp_tuple)) {
+      break;
+    }
+    ASSERT_EQ(tmp_tuple.GetPageId(), page_id);
+    ASSERT_EQ(tmp_tuple.GetOffset(), page.GetFreeSpacePointer());
+    locations.push_back(tmp_tuple);
+  }
+  ASSERT_GT(locations.size(), 100);
+
+  // Read them back from their locations, then by walking up from the last inserted one
+  for (size_t i = 0; i < locations.size(); i++) {
+    Tuple tuple;
+    page.Get(locations[i].GetOffset(), &tuple);
+    ASSERT_EQ(tuple.GetValue(&schema, 0).GetAs<int32_t>(), static_cast<int32_t>(i));
+    ASSERT_EQ(tuple.GetValue(&schema, 1).ToString(), std::string(i % 10, 'x'));
+  }
+  size_t count = 0;
+  for (uint32_t offset = page.GetFreeSpacePointer(); offset < BUSTUB_PAGE_SIZE; count++) {
+    Tuple tuple;
+    offset = page.Get(offset, &tuple);
+    ASSERT_EQ(tuple.GetValue(&schema, 0).GetAs<int32_t>(), static_cast<int32_t>(locations.size() - 1 - count));
+  }
+  ASSERT_EQ(count, locations.size());
+}
+
 }  // namespace bustub
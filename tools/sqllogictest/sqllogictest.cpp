@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <ios>
 #include <iostream>
@@ -105,11 +106,51 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
           return false;
         }
         check_options->check_options_set_.emplace(bustub::CheckOption::ENABLE_TOPN_CHECK);
+      } else if (opt == "ensure:index_merge") {
+        if (!bustub::StringUtil::Contains(result.str(), "IndexMergeScan")) {
+          fmt::print("IndexMergeScan not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:block_nlj") {
+        if (!bustub::StringUtil::Contains(result.str(), "BlockNestedLoopJoin")) {
+          fmt::print("BlockNestedLoopJoin not found\n");
+          return false;
+        }
       } else if (opt == "ensure:index_join") {
         if (!bustub::StringUtil::Contains(result.str(), "NestedIndexJoin")) {
           fmt::print("NestedIndexJoin not found\n");
           return false;
         }
+      } else if (opt == "ensure:gather") {
+        if (!bustub::StringUtil::Contains(result.str(), "Gather")) {
+          fmt::print("Gather not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:merge_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "MergeJoin")) {
+          fmt::print("MergeJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:runtime_filter") {
+        if (!bustub::StringUtil::Contains(result.str(), "runtime_filters=")) {
+          fmt::print("runtime filter not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:stream_agg") {
+        if (!bustub::StringUtil::Contains(result.str(), "StreamAgg")) {
+          fmt::print("StreamAgg not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:limit_pushdown") {
+        // The last limit in the optimized plan, which is printed last, should end up right above the scan
+        auto lines = bustub::StringUtil::Split(result.str(), "\n");
+        auto limit = std::find_if(lines.rbegin(), lines.rend(), [](const std::string &line) {
+          return bustub::StringUtil::Contains(line, "Limit {");
+        });
+        if (limit == lines.rend() || limit == lines.rbegin() || !bustub::StringUtil::Contains(*(limit - 1), "Scan")) {
+          fmt::print("Limit is not pushed down to the scan\n");
+          return false;
+        }
       } else if (opt == "ensure:nlj_init_check") {
         if (!bustub::StringUtil::Contains(result.str(), "NestedLoopJoin")) {
           fmt::print("NestedLoopJoin not found\n");